@@ -53,7 +53,7 @@ AcceleratedNewton::AcceleratedNewton(int theTangentToUse)
   :EquiSolnAlgo(EquiALGORITHM_TAGS_AcceleratedNewton),
    theTest(0), tangent(theTangentToUse),
    theAccelerator(0), vAccel(0), 
-   numFactorizations(0), numIterations(0)
+   numFactorizations(0), numFactorizationsAvoided(0), numIterations(0)
 //   totalTimer(), totalTimeReal(0.0), totalTimeCPU(0.0),
 //   solveTimer(), solveTimeReal(0.0), solveTimeCPU(0.0),
 //   accelTimer(), accelTimeReal(0.0), accelTimeCPU(0.0)
@@ -67,7 +67,7 @@ AcceleratedNewton::AcceleratedNewton(ConvergenceTest &theT,
   :EquiSolnAlgo(EquiALGORITHM_TAGS_AcceleratedNewton),
    theTest(&theT), tangent(theTangentToUse),
    theAccelerator(theAccel), vAccel(0), 
-   numFactorizations(0), numIterations(0)
+   numFactorizations(0), numFactorizationsAvoided(0), numIterations(0)
 //   totalTimer(), totalTimeReal(0.0), totalTimeCPU(0.0),
 //   solveTimer(), solveTimeReal(0.0), solveTimeCPU(0.0),
 //   accelTimer(), accelTimeReal(0.0), accelTimeCPU(0.0)
@@ -138,15 +138,21 @@ AcceleratedNewton::solveCurrentStep(void)
     return -2;
   }
 
-  // Evaluate system Jacobian J = R'(y)|y_0
-  if (theIntegrator->formTangent(tangent) < 0){
-    opserr << "WARNING AcceleratedNewton::solveCurrentStep() -";
-    opserr << "the Integrator failed in formTangent()\n";
-    return -1;
-  }
+  // Evaluate system Jacobian J = R'(y)|y_0, unless the accelerator
+  // carries a subspace formed with the tangent factored last step
+  if (theAccelerator != 0 && theAccelerator->reuseTangent() == true)
+    numFactorizationsAvoided++;
+
+  else {
+    if (theIntegrator->formTangent(tangent) < 0){
+      opserr << "WARNING AcceleratedNewton::solveCurrentStep() -";
+      opserr << "the Integrator failed in formTangent()\n";
+      return -1;
+    }
   
-  // Count factorization of the first tangent
-  numFactorizations++;
+    // Count factorization of the first tangent
+    numFactorizations++;
+  }
   
   // set itself as the ConvergenceTest objects EquiSolnAlgo
   theTest->setEquiSolnAlgo(*this);
@@ -243,6 +249,16 @@ AcceleratedNewton::solveCurrentStep(void)
   return result;
 }
 
+int
+AcceleratedNewton::domainChanged(void)
+{
+  // the subspace & factored tangent of the accelerator are no longer valid
+  if (theAccelerator != 0)
+    return theAccelerator->domainChanged();
+
+  return 0;
+}
+
 ConvergenceTest *
 AcceleratedNewton::getTest(void)
 {
@@ -324,4 +340,7 @@ AcceleratedNewton::Print(OPS_Stream &s, int flag)
     theAccelerator->Print(s,flag);
   else
     s << "\tNo accelerator --> Modified Newton" << endln;
+
+  s << "\tTangent factorizations: " << numFactorizations;
+  s << ", avoided: " << numFactorizationsAvoided << endln;
 }
@@ -51,10 +51,12 @@ class AcceleratedNewton: public EquiSolnAlgo
   ~AcceleratedNewton();
   
   int solveCurrentStep(void);    
+  int domainChanged(void);
   int setConvergenceTest(ConvergenceTest *theNewTest);
   ConvergenceTest *getTest(void);     
   
   int getNumFactorizations(void) {return numFactorizations;}
+  int getNumFactorizationsAvoided(void) {return numFactorizationsAvoided;}
   int getNumIterations(void) {return numIterations;}
   //double getTotalTimeCPU(void)   {return totalTimeCPU;}
   //double getTotalTimeReal(void)  {return totalTimeReal;}
@@ -80,6 +82,7 @@ class AcceleratedNewton: public EquiSolnAlgo
   Vector *vAccel;
   
   int numFactorizations;
+  int numFactorizationsAvoided;
   int numIterations;
 
   //Timer totalTimer;
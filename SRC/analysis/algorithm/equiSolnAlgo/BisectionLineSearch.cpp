@@ -114,10 +114,9 @@ BisectionLineSearch::search(double s0,
     etaU = etaJ * 4.0;
 
     //update the incremental difference in response and determine new unbalance
-    *x = dU;
     double factor = etaU - etaJ;
     compoundFactor += factor;
-    *x *= factor;
+    x->addVector(0.0, dU, factor);
 
     etaJ = etaU;
 
@@ -177,13 +176,12 @@ BisectionLineSearch::search(double s0,
     //    if (r   > r0    )  eta =  1.0;
     
     //update the incremental difference in response and determine new unbalance
-    *x = dU;
     double fact = eta-etaJ;
 
     if (fact == 0)
       break;
 
-    *x *= fact;
+    x->addVector(0.0, dU, fact);
 	    
     if (theIntegrator.update(*x) < 0) {
       opserr << "WARNING BisectionLineSearch::search() -";
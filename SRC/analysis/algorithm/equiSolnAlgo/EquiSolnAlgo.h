@@ -68,6 +68,7 @@ class EquiSolnAlgo: public SolutionAlgorithm
     virtual void Print(OPS_Stream &s, int flag =0) =0;    
 
     virtual int getNumFactorizations(void) {return 0;}
+    virtual int getNumFactorizationsAvoided(void) {return 0;}
     virtual int getNumIterations(void) {return 0;}
     virtual double getTotalTimeCPU(void)   {return 0.0;}
     virtual double getTotalTimeReal(void)  {return 0.0;}
@@ -124,8 +124,7 @@ InitialInterpolatedLineSearch::search(double s0,
       break; // no change in response break
 
     //dx = ( eta * dx0 ); 
-    *x = dU;
-    *x *= eta-etaPrev;
+    x->addVector(0.0, dU, eta-etaPrev);
 	    
     if (theIntegrator.update(*x) < 0) {
       opserr << "WARNInG InitialInterpolatedLineSearch::search() -";
@@ -55,8 +55,9 @@ void* OPS_ModifiedNewton()
   int factoronce = 0;
   double iFactor = 0;
   double cFactor = 1;
+  double localTol = 0.0;
 
-  if (OPS_GetNumRemainingInputArgs() > 0) {
+  while (OPS_GetNumRemainingInputArgs() > 0) {
     const char* type = OPS_GetString();
     if (strcmp(type,"-secant") == 0) {
       formTangent = CURRENT_SECANT;
@@ -78,24 +79,34 @@ void* OPS_ModifiedNewton()
         iFactor = data[0];
         cFactor = data[1];
       }
+    } else if (strcmp(type,"-localUpdate") == 0) {
+      localTol = 1.0e-4;
+      if (OPS_GetNumRemainingInputArgs() > 0) {
+        int numData = 1;
+        if (OPS_GetDoubleInput(&numData,&localTol) < 0) {
+          // not a tolerance; leave it for the next option
+          localTol = 1.0e-4;
+          OPS_ResetCurrentInputArg(-1);
+        }
+      }
     }
   }
   
-  return new ModifiedNewton(formTangent, iFactor, cFactor,factoronce);
+  return new ModifiedNewton(formTangent, iFactor, cFactor,factoronce,localTol);
 }
 
 // Constructor
-ModifiedNewton::ModifiedNewton(int theTangentToUse, double iFact, double cFact, int factOnce)
+ModifiedNewton::ModifiedNewton(int theTangentToUse, double iFact, double cFact, int factOnce, double lTol)
 :EquiSolnAlgo(EquiALGORITHM_TAGS_ModifiedNewton),
- tangent(theTangentToUse), iFactor(iFact), cFactor(cFact), factorOnce(factOnce)
+ tangent(theTangentToUse), iFactor(iFact), cFactor(cFact), factorOnce(factOnce), localTol(lTol)
 {
   
 }
 
 
-ModifiedNewton::ModifiedNewton(ConvergenceTest &theT, int theTangentToUse, double iFact, double cFact, int factOnce)
+ModifiedNewton::ModifiedNewton(ConvergenceTest &theT, int theTangentToUse, double iFact, double cFact, int factOnce, double lTol)
 :EquiSolnAlgo(EquiALGORITHM_TAGS_ModifiedNewton),
- tangent(theTangentToUse), iFactor(iFact), cFactor(cFact), factorOnce(factOnce)
+ tangent(theTangentToUse), iFactor(iFact), cFactor(cFact), factorOnce(factOnce), localTol(lTol)
 {
 
 }
@@ -122,6 +133,8 @@ ModifiedNewton::solveCurrentStep(void)
       return -5;
     }	
 
+    theIncIntegratorr->setLocalUpdate(localTol);
+
     // we form the tangent
     //    Timer timer1;
     // timer1.start();
@@ -166,6 +179,12 @@ ModifiedNewton::solveCurrentStep(void)
 	//timer2.pause();
 	//opserr << "TIMER::SOLVE()- " << timer2;
 	
+	if (localTol > 0.0 && theIncIntegratorr->selectActiveFEs(theSOE->getX()) < 0) {
+	    opserr << "WARNING ModifiedNewton::solveCurrentStep() -";
+	    opserr << "the Integrator failed in selectActiveFEs()\n";	
+	    return -4;
+	}	        
+
 	if (theIncIntegratorr->update(theSOE->getX()) < 0) {
 	    opserr << "WARNING ModifiedNewton::solveCurrentStep() -";
 	    opserr << "the Integrator failed in update()\n";	
@@ -201,11 +220,12 @@ ModifiedNewton::solveCurrentStep(void)
 int
 ModifiedNewton::sendSelf(int cTag, Channel &theChannel)
 {
-  static Vector data(4);
+  static Vector data(5);
   data(0) = tangent;
   data(1) = iFactor;
   data(2) = cFactor;
   data(3) = factorOnce;
+  data(4) = localTol;
   return theChannel.sendVector(this->getDbTag(), cTag, data);
 }
 
@@ -214,12 +234,13 @@ ModifiedNewton::recvSelf(int cTag,
 			Channel &theChannel, 
 			FEM_ObjectBroker &theBroker)
 {
-  static Vector data(4);
+  static Vector data(5);
   theChannel.recvVector(this->getDbTag(), cTag, data);
   tangent = data(0);
   iFactor = data(1);
   cFactor = data(2);
   factorOnce = data(3);
+  localTol = data(4);
   return 0;
 }
 
@@ -228,6 +249,8 @@ ModifiedNewton::Print(OPS_Stream &s, int flag)
 {
     if (flag == 0) {
 	s << "ModifiedNewton";
+	if (localTol > 0.0)
+	    s << " local update, tol: " << localTol;
     }
 }
 
@@ -48,8 +48,8 @@ class ConvergenceTest;
 class ModifiedNewton: public EquiSolnAlgo
 {
   public:
-  ModifiedNewton(int tangent, double iFactor = 0.0, double cFactor = 1.0, int factOnce=0);
-  ModifiedNewton(ConvergenceTest &theTest, int tangent = CURRENT_TANGENT, double iFactor = 0.0, double cFactor = 1.0, int factOnce=0);
+  ModifiedNewton(int tangent, double iFactor = 0.0, double cFactor = 1.0, int factOnce=0, double localTol = 0.0);
+  ModifiedNewton(ConvergenceTest &theTest, int tangent = CURRENT_TANGENT, double iFactor = 0.0, double cFactor = 1.0, int factOnce=0, double localTol = 0.0);
   ~ModifiedNewton();
 
     int solveCurrentStep(void);    
@@ -70,6 +70,7 @@ class ModifiedNewton: public EquiSolnAlgo
 
     double iFactor;
     double cFactor;
+    double localTol;  // > 0: only elements at dofs that moved are updated
 };
 
 #endif
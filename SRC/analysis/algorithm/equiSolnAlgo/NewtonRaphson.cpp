@@ -56,6 +56,7 @@ void* OPS_NewtonRaphsonAlgorithm()
     int formTangent = CURRENT_TANGENT;
     double iFactor = 0;
     double cFactor = 1;
+    double localTol = 0.0;
 
     while (OPS_GetNumRemainingInputArgs() > 0) {
       const char* type = OPS_GetString();
@@ -85,32 +86,42 @@ void* OPS_NewtonRaphsonAlgorithm()
 	  iFactor = data[0];
 	  cFactor = data[1];
 	}
+      } else if(strcmp(type,"-localUpdate")==0) {
+	localTol = 1.0e-4;
+	if (OPS_GetNumRemainingInputArgs() > 0) {
+	  int numData = 1;
+	  if(OPS_GetDoubleInput(&numData,&localTol) < 0) {
+	    // not a tolerance; leave it for the next option
+	    localTol = 1.0e-4;
+	    OPS_ResetCurrentInputArg(-1);
+	  }
+	}
       }
     }
 
-    return new NewtonRaphson(formTangent, iFactor, cFactor);
+    return new NewtonRaphson(formTangent, iFactor, cFactor, localTol);
 
 }
 
 // Constructor
-NewtonRaphson::NewtonRaphson(int theTangentToUse, double iFact, double cFact)
+NewtonRaphson::NewtonRaphson(int theTangentToUse, double iFact, double cFact, double lTol)
 :EquiSolnAlgo(EquiALGORITHM_TAGS_NewtonRaphson),
- tangent(theTangentToUse), iFactor(iFact), cFactor(cFact)
+ tangent(theTangentToUse), iFactor(iFact), cFactor(cFact), localTol(lTol)
 {
 
 }
 
 NewtonRaphson::NewtonRaphson()
 	:EquiSolnAlgo(EquiALGORITHM_TAGS_NewtonRaphson),
-	tangent(CURRENT_TANGENT), iFactor(0.), cFactor(1.)
+	tangent(CURRENT_TANGENT), iFactor(0.), cFactor(1.), localTol(0.)
 {
 
 }
 
 
-NewtonRaphson::NewtonRaphson(ConvergenceTest &theT, int theTangentToUse, double iFact, double cFact)
+NewtonRaphson::NewtonRaphson(ConvergenceTest &theT, int theTangentToUse, double iFact, double cFact, double lTol)
 :EquiSolnAlgo(EquiALGORITHM_TAGS_NewtonRaphson),
- tangent(theTangentToUse), iFactor(iFact), cFactor(cFact)
+ tangent(theTangentToUse), iFactor(iFact), cFactor(cFact), localTol(lTol)
 {
 
 }
@@ -140,6 +151,8 @@ NewtonRaphson::solveCurrentStep(void)
 	return -5;
     }	
 
+    theIntegrator->setLocalUpdate(localTol);
+
     if (theIntegrator->formUnbalance() < 0) {
       opserr << "WARNING NewtonRaphson::solveCurrentStep() -";
       opserr << "the Integrator failed in formUnbalance()\n";	
@@ -190,6 +203,11 @@ NewtonRaphson::solveCurrentStep(void)
 	return -3;
       }	    
 
+      if (localTol > 0.0 && theIntegrator->selectActiveFEs(theSOE->getX()) < 0) {
+	opserr << "WARNING NewtonRaphson::solveCurrentStep() -";
+	opserr << "the Integrator failed in selectActiveFEs()\n";	
+	return -4;
+      }	        
       if (theIntegrator->update(theSOE->getX()) < 0) {
 	opserr << "WARNING NewtonRaphson::solveCurrentStep() -";
 	opserr << "the Integrator failed in update()\n";	
@@ -222,10 +240,11 @@ NewtonRaphson::solveCurrentStep(void)
 int
 NewtonRaphson::sendSelf(int cTag, Channel &theChannel)
 {
-  static Vector data(3);
+  static Vector data(4);
   data(0) = tangent;
   data(1) = iFactor;
   data(2) = cFactor;
+  data(3) = localTol;
   return theChannel.sendVector(this->getDbTag(), cTag, data);
 }
 
@@ -234,11 +253,12 @@ NewtonRaphson::recvSelf(int cTag,
 			Channel &theChannel, 
 			FEM_ObjectBroker &theBroker)
 {
-  static Vector data(3);
+  static Vector data(4);
   theChannel.recvVector(this->getDbTag(), cTag, data);
   tangent = int(data(0));
   iFactor = data(1);
   cFactor = data(2);
+  localTol = data(3);
   return 0;
 }
 
@@ -248,6 +268,8 @@ NewtonRaphson::Print(OPS_Stream &s, int flag)
 {
   if (flag == 0) {
     s << "NewtonRaphson" << endln;
+    if (localTol > 0.0)
+      s << "  local update, tol: " << localTol << endln;
   }
 }
 
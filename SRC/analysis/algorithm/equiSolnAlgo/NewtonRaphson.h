@@ -49,8 +49,8 @@ class NewtonRaphson: public EquiSolnAlgo
 {
   public:
   NewtonRaphson();
-  NewtonRaphson(int tangent, double iFactor = 0.0, double cFactor = 1.0);    
-  NewtonRaphson(ConvergenceTest &theTest, int tangent = CURRENT_TANGENT, double iFactor = 0.0, double cFactor = 1.0);
+  NewtonRaphson(int tangent, double iFactor = 0.0, double cFactor = 1.0, double localTol = 0.0);    
+  NewtonRaphson(ConvergenceTest &theTest, int tangent = CURRENT_TANGENT, double iFactor = 0.0, double cFactor = 1.0, double localTol = 0.0);
   ~NewtonRaphson();
   
   int solveCurrentStep(void);    
@@ -71,6 +71,7 @@ class NewtonRaphson: public EquiSolnAlgo
   
   double iFactor;
   double cFactor;
+  double localTol;  // > 0: only elements at dofs that moved are updated
 };
 
 #endif
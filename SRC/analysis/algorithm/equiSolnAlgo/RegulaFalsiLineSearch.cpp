@@ -114,10 +114,9 @@ RegulaFalsiLineSearch::search(double s0,
     etaU = etaJ * 4.0;
 
     //update the incremental difference in response and determine new unbalance
-    *x = dU;
     double factor = etaU - etaJ;
     compoundFactor += factor;
-    *x *= factor;
+    x->addVector(0.0, dU, factor);
 
     etaJ = etaU;
 
@@ -183,8 +182,7 @@ RegulaFalsiLineSearch::search(double s0,
       break;
     
     //update the incremental difference in response and determine new unbalance
-    *x = dU;
-    *x *= eta-etaJ;
+    x->addVector(0.0, dU, eta-etaJ);
 	    
     if (theIntegrator.update(*x) < 0) {
       opserr << "WARNING RegulaFalsiLineSearch::search() -";
@@ -121,8 +121,7 @@ SecantLineSearch::search(double s0,
     if (eta == etaJ) 
       break; // no change in response
 
-    *x = dU;
-    *x *= eta-etaJ;
+    x->addVector(0.0, dU, eta-etaJ);
 	    
     if (theIntegrator.update(*x) < 0) {
       opserr << "WARNING SecantLineSearch::search() -";
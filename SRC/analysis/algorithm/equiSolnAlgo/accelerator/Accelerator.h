@@ -54,6 +54,8 @@ class Accelerator : public MovableObject
 			 IncrementalIntegrator &theIntegrator) = 0;
   virtual int updateTangent(IncrementalIntegrator &theIntegrator);
   virtual bool updateTangent(void) {return false;}
+  virtual bool reuseTangent(void) {return false;}   // keep the factored tangent at newStep()
+  virtual int domainChanged(void) {return 0;}
 
   virtual int getTangent(void) {return NO_TANGENT;}
 
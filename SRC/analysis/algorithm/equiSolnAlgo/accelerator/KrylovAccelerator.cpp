@@ -39,37 +39,120 @@
 #include <Channel.h>
 #include <math.h>
 
-KrylovAccelerator::KrylovAccelerator(int max, int tangent)
+// pairs whose subspace vector is this close to the span of the others
+// are dropped
+static const double deflationTol = 1.0e-8;
+
+KrylovAccelerator::KrylovAccelerator(int max, int tangent, int keep)
   :Accelerator(ACCELERATOR_TAGS_Krylov),
-   dimension(0), numEqns(0), maxDimension(max),
-   v(0), Av(0), AvData(0), rData(0), work(0), lwork(0), theTangent(tangent)
+   dimension(0), numEqns(0), maxDimension(max), maxKeep(keep),
+   v(0), Av(0), numPairs(0), Q(0), W(0), numBasis(0),
+   vLast(0), rLast(0), hasLast(false), theTangent(tangent)
 {
   if (maxDimension < 0)
     maxDimension = 0;
+  if (maxKeep < 0)
+    maxKeep = 0;
 }
 
 KrylovAccelerator::~KrylovAccelerator()
+{
+  this->deallocate();
+}
+
+void
+KrylovAccelerator::allocate(void)
+{
+  v = new Vector*[maxDimension+1];
+  Av = new Vector*[maxDimension+1];
+  Q = new Vector*[maxDimension+1];
+  W = new Vector*[maxDimension+1];
+  for (int i = 0; i < maxDimension+1; i++) {
+    v[i] = new Vector(numEqns);
+    Av[i] = new Vector(numEqns);
+    Q[i] = new Vector(numEqns);
+    W[i] = new Vector(numEqns);
+  }
+  vLast = new Vector(numEqns);
+  rLast = new Vector(numEqns);
+}
+
+void
+KrylovAccelerator::deallocate(void)
 {
   if (v != 0) {
-    for (int i = 0; i < maxDimension+1; i++)
+    for (int i = 0; i < maxDimension+1; i++) {
       delete v[i];
+      delete Av[i];
+      delete Q[i];
+      delete W[i];
+    }
     delete [] v;
+    delete [] Av;
+    delete [] Q;
+    delete [] W;
+    v = 0;
+    Av = 0;
+    Q = 0;
+    W = 0;
   }
 
-  if (Av != 0) {
-    for (int i = 0; i < maxDimension+1; i++)
-      delete Av[i];
-    delete [] Av;
+  if (vLast != 0)
+    delete vLast;
+  if (rLast != 0)
+    delete rLast;
+  vLast = 0;
+  rLast = 0;
+}
+
+void
+KrylovAccelerator::clear(void)
+{
+  dimension = 0;
+  numPairs = 0;
+  numBasis = 0;
+  hasLast = false;
+}
+
+int
+KrylovAccelerator::addToBasis(const Vector &vi, const Vector &Avi)
+{
+  // Gram-Schmidt update of Av = Q R, applying the same operations to V
+  // gives W = V R^-1; two passes keep Q orthogonal to working precision
+  Vector &q = *(Q[numBasis]);
+  Vector &w = *(W[numBasis]);
+  q = Avi;
+  w = vi;
+
+  double norm0 = q.Norm();
+  if (norm0 == 0.0)
+    return 0;
+
+  for (int pass = 0; pass < 2; pass++) {
+    for (int j = 0; j < numBasis; j++) {
+      double h = (*(Q[j])) ^ q;
+      q.addVector(1.0, *(Q[j]), -h);
+      w.addVector(1.0, *(W[j]), -h);
+    }
   }
 
-  if (AvData != 0)
-    delete [] AvData;
+  double rho = q.Norm();
+  if (rho <= deflationTol*norm0)
+    return 0;
+
+  q /= rho;
+  w /= rho;
+  numBasis++;
 
-  if (rData != 0)
-    delete [] rData;
+  return 1;
+}
 
-  if (work != 0)
-    delete [] work;
+void
+KrylovAccelerator::formBasis(void)
+{
+  numBasis = 0;
+  for (int i = 0; i < numPairs; i++)
+    this->addToBasis(*(v[i]), *(Av[i]));
 }
 
 int 
@@ -78,216 +161,73 @@ KrylovAccelerator::newStep(LinearSOE &theSOE)
   int newNumEqns = theSOE.getNumEqn();
 
   if (numEqns != newNumEqns) {
-    if (v != 0) {
-      for (int i = 0; i < maxDimension+1; i++)
-	delete v[i];
-      delete [] v;
-      v = 0;
-    }
-    
-    if (Av != 0) {
-      for (int i = 0; i < maxDimension+1; i++)
-	delete Av[i];
-      delete [] Av;
-      Av = 0;
-    }
-    
-    if (AvData != 0) {
-      delete [] AvData;
-      AvData = 0;
-    }
-    
-    if (rData != 0) {
-      delete [] rData;
-      rData = 0;
-    }
-    
-    if (work != 0) {
-      delete [] work;
-      work = 0;
-    }
+    this->deallocate();
+    this->clear();
   }
 
   numEqns = newNumEqns;
   if (maxDimension > numEqns)
     maxDimension = numEqns;
 
-  if (v == 0) {
-    v = new Vector*[maxDimension+1];
-    for (int i = 0; i < maxDimension+1; i++)
-      v[i] = new Vector(numEqns);
-  }
-
-  if (Av == 0) {
-    Av = new Vector*[maxDimension+1];
-    for (int i = 0; i < maxDimension+1; i++)
-      Av[i] = new Vector(numEqns);
+  if (v == 0)
+    this->allocate();
+
+  // Carry the most recent pairs into the new step, leaving room in the
+  // subspace for the new ones
+  int numKeep = (maxKeep < maxDimension) ? maxKeep : maxDimension-1;
+  if (numKeep < 0)
+    numKeep = 0;
+  if (numPairs > numKeep) {
+    int first = numPairs - numKeep;
+    for (int i = 0; i < numKeep; i++) {
+      Vector *tmp = v[i];
+      v[i] = v[first+i];
+      v[first+i] = tmp;
+      tmp = Av[i];
+      Av[i] = Av[first+i];
+      Av[first+i] = tmp;
+    }
+    numPairs = numKeep;
   }
-
-  if (AvData == 0)
-    AvData = new double [maxDimension*numEqns];
-
-  if (rData == 0)
-    // The LAPACK least squares subroutine overwrites the RHS vector
-    // with the solution vector ... these vectors are not the same
-    // size, so we need to use the max size
-    rData = new double [(numEqns > maxDimension) ? numEqns : maxDimension];
-
-  // Length of work vector should be >= 2*min(numEqns,maxDimension)
-  // See dgels subroutine documentation
-  lwork = 2 * ((numEqns < maxDimension) ? numEqns : maxDimension);
-  
-  if (work == 0)
-    work = new double [lwork];
+  this->formBasis();
 
   // Reset dimension of subspace
-  dimension = 0;
+  dimension = numPairs;
+  hasLast = false;
 
   return 0;
 }
 
-#ifdef _WIN32
-
-extern "C" int DGELS(char *T, int *M, int *N, int *NRHS,
-			      double *A, int *LDA, double *B, int *LDB,
-			      double *WORK, int *LWORK, int *INFO);
-
-#else
-
-extern "C" int dgels_(char *T, int *M, int *N, int *NRHS,
-		      double *A, int *LDA, double *B, int *LDB,
-		      double *WORK, int *LWORK, int *INFO);
-
-#endif
-
-//#include <fstream.h>
-//ofstream vFile("v.out");
-//ofstream AvFile("Av.out");
-//ofstream rFile("r.out");
-//ofstream cFile("c.out");
-//ofstream wFile("w.out");
-//ofstream qFile("q.out");
-
 int
 KrylovAccelerator::accelerate(Vector &vStar, LinearSOE &theSOE, 
 			      IncrementalIntegrator &theIntegrator)
 {
   Vector &r = vStar;
-  //rFile << "dim: " << dimension << endln;
-  //rFile << r << endln;
 
-  int k = dimension;
+  // Complete the pair of the last update,
+  // Av_k = f(y_{k-1}) - f(y_k) = r_{k-1} - r_k
+  if (hasLast == true && numPairs < maxDimension+1) {
+    rLast->addVector(1.0, r, -1.0);
+    *(v[numPairs]) = *vLast;
+    *(Av[numPairs]) = *rLast;
+    this->addToBasis(*(v[numPairs]), *(Av[numPairs]));
+    numPairs++;
+  }
 
   // Store residual for differencing at next iteration
-  *(Av[k]) = r;
-
-  // If subspace is not empty
-  if (dimension > 0) {
-
-    // Compute Av_k = f(y_{k-1}) - f(y_k) = r_{k-1} - r_k
-    Av[k-1]->addVector(1.0, r, -1.0);
-    
-    int i,j;
-    
-    // Put subspace vectors into AvData
-    Matrix A(AvData, numEqns, k);
-    for (i = 0; i < k; i++) {
-      Vector &Ai = *(Av[i]);
-      for (j = 0; j < numEqns; j++)
-	A(j,i) = Ai(j);
-    }
-
-    for (i = 0; i < k; i++) {
-      for (int j = i+1; j < k; j++) {
-	double sum = 0.0;
-	double sumi = 0.0;
-	double sumj = 0.0;
-	for (int ii = 0; ii < numEqns; ii++) {
-	  sum += A(ii,i)*A(ii,j);
-	  sumi += A(ii,i)*A(ii,i);
-	  sumj += A(ii,j)*A(ii,j);
-	}
-	sumi = sqrt(sumi);
-	sumj = sqrt(sumj);
-	sum = sum/(sumi*sumj);
-	//if (fabs(sum) > 0.99)
-	  //opserr << sum << ' ' << i << ' ' << j << "   ";
-      }
-    }
-
-    //AvFile << "dim: " << dimension << endln;
-    //AvFile << A << endln;
-    
-    // Put residual vector into rData (need to save r for later!)
-    Vector B(rData, numEqns);
-    B = r;
-    
-    // No transpose
-    char trans[] = "N";
-    
-    // The number of right hand side vectors
-    int nrhs = 1;
-    
-    // Leading dimension of the right hand side vector
-    int ldb = (numEqns > k) ? numEqns : k;
-    
-    // Subroutine error flag
-    int info = 0;
-    
-    // Call the LAPACK least squares subroutine
-#ifdef _WIN32
-    DGELS(trans, &numEqns, &k, &nrhs, AvData, &numEqns,
-	  rData, &ldb, work, &lwork, &info);
-#else
-    dgels_(trans, &numEqns, &k, &nrhs, AvData, &numEqns,
-	   rData, &ldb, work, &lwork, &info);
-#endif
-    
-    // Check for error returned by subroutine
-    if (info < 0) {
-      opserr << "WARNING KrylovAccelerator::accelerate() - \n";
-      opserr << "error code " << info << " returned by LAPACK dgels\n";
-      return info;
-    }
-    
-    //Vector w(numEqns);
-    //Vector q(numEqns);
-    //q = r;
-
-    //cFile << "dim: " << dimension << endln;
-    // Compute the correction vector
-    double cj;
-    for (j = 0; j < k; j++) {
-      
-      // Solution to least squares is written to rData
-      cj = rData[j];
-      
-      // Compute w_{k+1} = c_1 v_1 + ... + c_k v_k
-      r.addVector(1.0, *(v[j]), cj);
-      //w.addVector(1.0, *(v[j]), cj);
-
-      // Compute least squares residual
-      // q_{k+1} = r_k - (c_1 Av_1 + ... + c_k Av_k)
-      r.addVector(1.0, *(Av[j]), -cj);
-      //q.addVector(1.0, *(Av[j]), -cj);
-
-      //cFile << cj << ' ';
-    }
-
-    //cFile << endln;
-
-    //wFile << "dim: " << dimension << endln;
-    //wFile << w << endln;
-
-    //qFile << "dim: " << dimension << endln;
-    //qFile << q << endln;
+  *rLast = r;
+
+  // Least squares min |r_k - Av c| through Av = Q R, c = R^-1 Q^T r_k:
+  // w_{k+1} = V c = W Q^T r_k and q_{k+1} = r_k - Q Q^T r_k
+  for (int j = 0; j < numBasis; j++) {
+    double cj = (*(Q[j])) ^ (*rLast);
+    r.addVector(1.0, *(W[j]), cj);
+    r.addVector(1.0, *(Q[j]), -cj);
   }
 
   // Put accelerated vector into storage for next iteration
-  *(v[k]) = r;
-
-  //vFile << "dim: " << dimension << endln;
-  //vFile << r << endln;
+  *vLast = r;
+  hasLast = true;
 
   dimension++;
 
@@ -298,7 +238,8 @@ int
 KrylovAccelerator::updateTangent(IncrementalIntegrator &theIntegrator)
 {
   if (dimension > maxDimension) {
-    dimension = 0;
+    // the pairs belong to the old tangent
+    this->clear();
     if (theTangent != NO_TANGENT) {
       //opserr << "KrylovAccelerator::updateTangent() tangent formed" << endln;
       theIntegrator.formTangent(theTangent);
@@ -315,26 +256,43 @@ bool
 KrylovAccelerator::updateTangent(void)
 {
   if (dimension > maxDimension) {
-    dimension = 0;
+    this->clear();
     return true;
   }
   else
     return false;
 }
 
+bool
+KrylovAccelerator::reuseTangent(void)
+{
+  // the carried pairs were formed with the tangent now factored
+  return (numBasis > 0);
+}
+
+int
+KrylovAccelerator::domainChanged(void)
+{
+  this->clear();
+  return 0;
+}
+
 void
 KrylovAccelerator::Print(OPS_Stream &s, int flag)
 {
   s << "KrylovAccelerator" << endln;
   s << "\tMax subspace dimension: " << maxDimension << endln;
+  if (maxKeep > 0)
+    s << "\tSubspace vectors carried between steps: " << maxKeep << endln;
 }
 
 int
 KrylovAccelerator::sendSelf(int commitTag, Channel &theChannel)
 {
-  static ID data(2);
+  static ID data(3);
   data(0) = theTangent;
   data(1) = maxDimension;
+  data(2) = maxKeep;
   return theChannel.sendID(0, commitTag, data);
 }
 
@@ -342,9 +300,10 @@ int
 KrylovAccelerator::recvSelf(int commitTag, Channel &theChannel, 
 			    FEM_ObjectBroker &theBroker)
 {
-  static ID data(2);
+  static ID data(3);
   int res = theChannel.recvID(0, commitTag, data);
   theTangent = data(0);
   maxDimension = data(1);
+  maxKeep = data(2);
   return res;
 }
@@ -26,7 +26,12 @@
 // Created: April 2002
 
 // Description: This file contains the class definition for 
-// KrylovAccelerator. 
+// KrylovAccelerator. The subspace of update/residual difference pairs
+// is kept in orthonormal form, Av = Q R and W = V R^-1, so that a new
+// pair is added with a Gram-Schmidt update and the least squares
+// correction is W Q^T r - Q Q^T r. With maxKeep > 0 the most recent
+// pairs are carried into the next step together with the factored
+// tangent they were formed with.
 
 #ifndef KrylovAccelerator_h
 #define KrylovAccelerator_h
@@ -37,7 +42,7 @@
 class KrylovAccelerator : public Accelerator
 {
  public:
-  KrylovAccelerator(int maxDim = 3, int tangent = CURRENT_TANGENT);
+  KrylovAccelerator(int maxDim = 3, int tangent = CURRENT_TANGENT, int maxKeep = 0);
   virtual ~KrylovAccelerator();
   
   int newStep(LinearSOE &theSOE);
@@ -45,6 +50,8 @@ class KrylovAccelerator : public Accelerator
 		 IncrementalIntegrator &theIntegrator);
   int updateTangent(IncrementalIntegrator &theIntegrator);
   bool updateTangent(void);
+  bool reuseTangent(void);
+  int domainChanged(void);
 
   void Print(OPS_Stream &s, int flag=0);
   
@@ -55,26 +62,35 @@ class KrylovAccelerator : public Accelerator
  protected:
   
  private:
+  void allocate(void);
+  void deallocate(void);
+  int addToBasis(const Vector &vi, const Vector &Avi);
+  void formBasis(void);
+  void clear(void);
+
   // Current dimension of Krylov subspace
   int dimension;
   
   // Size information
   int numEqns;
   int maxDimension;
+  int maxKeep;
   
-  // Storage for update vectors
+  // Storage for update vectors and subspace vectors, numPairs of them
   Vector **v;
-  
-  // Storage for subspace vectors
   Vector **Av;
-  
-  // Array data sent to LAPACK subroutine
-  double *AvData;
-  double *rData;
-  double *work;
-  
-  // Length of work array
-  int lwork;
+  int numPairs;
+
+  // The pairs in orthonormal form, numBasis <= numPairs as nearly
+  // dependent pairs are dropped
+  Vector **Q;
+  Vector **W;
+  int numBasis;
+
+  // Last update and its residual, completed to a pair next iteration
+  Vector *vLast;
+  Vector *rLast;
+  bool hasLast;
 
   // Which tangent to form at restart
   int theTangent;
@@ -120,9 +120,7 @@ SecantAccelerator2::accelerate(Vector &vStar, LinearSOE &theSOE,
       // 	   << ", D/A = " << DA << endln;
     }
     else {
-      //vStar.addVector(A, *vOld, D);
-      vStar *= A;
-      vStar.addVector(1.0, *vOld, D);
+      vStar.addVector(A, *vOld, D);
     }
   }
 
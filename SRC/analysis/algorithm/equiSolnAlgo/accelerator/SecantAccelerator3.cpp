@@ -141,8 +141,7 @@ SecantAccelerator3::accelerate(Vector &vStar, LinearSOE &theSOE,
       //	   << ", D/A = " << DA << endln;
     }
     else {
-      vStar.addVector(A, *vOld, B);
-      vStar.addVector(1.0, *rOld, C);
+      vStar.addVector(A, *vOld, B, *rOld, C);
     }
   }
 
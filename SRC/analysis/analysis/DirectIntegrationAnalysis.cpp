@@ -55,6 +55,7 @@
 #include <Matrix.h>
 #include <ID.h>
 #include <Graph.h>
+#include <math.h>
 
 // Constructor
 //    sets theModel and theSysOFEqn to 0 and the Algorithm to the one supplied
@@ -80,7 +81,9 @@ DirectIntegrationAnalysis::DirectIntegrationAnalysis(Domain &the_Domain,
  theTest(theConvergenceTest),
  domainStamp(0),
  numSubLevels(num_SubLevels),
- numSubSteps(num_SubSteps)
+ numSubSteps(num_SubSteps),
+ adaptTol(0.0), adaptAtol(0.0), adaptDtMin(0.0), adaptDtMax(0.0),
+ adaptDt(0.0), adaptErrPrev(1.0), adaptDispPeak(0.0)
 {
   // first we set up the links needed by the elements in the 
   // aggregation
@@ -169,6 +172,14 @@ DirectIntegrationAnalysis::analyze(int numSteps, double dT, bool flush)
 {
   int result = 0;
 
+  if (adaptTol > 0.0) {
+    result = this->analyzeAdaptive(numSteps, dT);
+    Domain *the_Domain = this->getDomainPtr();
+    if (the_Domain != 0 && flush)
+      the_Domain->flushRecorders();
+    return result;
+  }
+
   for (int i=0; i<numSteps; i++) {
     result = this->analyzeStep(dT);
     if (result < 0) {
@@ -189,6 +200,16 @@ DirectIntegrationAnalysis::analyze(int numSteps, double dT, bool flush)
 
 int 
 DirectIntegrationAnalysis::analyzeStep(double dT)
+{
+  int result = this->solveStep(dT);
+  if (result < 0)
+    return result;
+
+  return this->commitStep();
+}
+
+int
+DirectIntegrationAnalysis::solveStep(double dT)
 {
   int result = 0;
   Domain *the_Domain = this->getDomainPtr();
@@ -226,6 +247,15 @@ DirectIntegrationAnalysis::analyzeStep(double dT)
     theIntegrator->revertToLastStep();
     return -3;
   }    
+
+  return 0;
+}
+
+int
+DirectIntegrationAnalysis::commitStep(void)
+{
+  int result = 0;
+  Domain *the_Domain = this->getDomainPtr();
   
   // AddingSensitivity:BEGIN ////////////////////////////////////
 #ifdef _RELIABILITY
@@ -258,6 +288,130 @@ DirectIntegrationAnalysis::analyzeStep(double dT)
   return result;
 }
 
+int
+DirectIntegrationAnalysis::setAdaptive(double tol, double dtMin, double dtMax, double atol)
+{
+  if (tol < 0.0 || dtMin < 0.0 || atol < 0.0 || (dtMax > 0.0 && dtMax < dtMin)) {
+    opserr << "WARNING DirectIntegrationAnalysis::setAdaptive() - invalid tol, dtMin or dtMax\n";
+    return -1;
+  }
+
+  adaptTol = tol;
+  adaptAtol = atol;
+  adaptDtMin = dtMin;
+  adaptDtMax = dtMax;
+  adaptDt = 0.0;
+  adaptErrPrev = 1.0;
+  adaptDispPeak = 0.0;
+
+  return 0;
+}
+
+int
+DirectIntegrationAnalysis::analyzeAdaptive(int numSteps, double dT)
+{
+  // The error of a step is e/(tol*max|u| + atol) with e the integrator
+  // estimate and max|u| the peak displacement seen so far; it is accepted
+  // if that ratio is below 1. The next step follows the PI controller
+  // h*0.9*err^(-0.7/3)*errPrev^(0.4/3), the local error being O(h^3).
+  if (dT <= 0.0 || numSteps <= 0)
+    return 0;
+
+  Domain *the_Domain = this->getDomainPtr();
+  double t0 = the_Domain->getCurrentTime();
+  double tEnd = t0 + numSteps*dT;
+  double tiny = 1.0e-10*dT;
+
+  double dtMax = adaptDtMax > 0.0 ? adaptDtMax : dT;
+  double dtMin = adaptDtMin > 0.0 ? adaptDtMin : dT*1.0e-6;
+  double h = adaptDt > 0.0 ? adaptDt : dT;
+  bool warnedNoEstimate = false;
+
+  while (tEnd - the_Domain->getCurrentTime() > tiny) {
+
+    if (h > dtMax) h = dtMax;
+    if (h < dtMin) h = dtMin;
+
+    // land on the next point of the dT grid, or step over whole intervals;
+    // a step shorter than the interval left splits it into equal steps,
+    // so only the last of them ends on the grid
+    double t = the_Domain->getCurrentTime();
+    double next = t0 + ceil((t - t0 + tiny)/dT)*dT;
+    double toGrid = next - t;
+    double step;
+    if (h >= toGrid - tiny)
+      step = toGrid + floor((h - toGrid + tiny)/dT)*dT;
+    else
+      step = toGrid/ceil(toGrid/h - 1.0e-9);
+    if (step > tEnd - t)
+      step = tEnd - t;
+
+    int result = this->solveStep(step);
+    if (result < 0) {
+      if (result == -1 || step <= dtMin*(1.0 + 1.0e-9))
+	return result;
+      h = step*0.5;
+      adaptErrPrev = 1.0;
+      continue;
+    }
+
+    double err = 0.0;
+    double errNorm = 0.0, dispNorm = 0.0;
+    if (theIntegrator->getLocalErrorEstimate(step, errNorm, dispNorm) < 0) {
+      if (!warnedNoEstimate) {
+	opserr << "WARNING DirectIntegrationAnalysis::analyze() - the integrator provides no";
+	opserr << " error estimate, adaptive steps only react to failed steps\n";
+	warnedNoEstimate = true;
+      }
+    } else {
+      double peak = dispNorm > adaptDispPeak ? dispNorm : adaptDispPeak;
+      double scale = adaptTol*peak + adaptAtol;
+      if (scale > 0.0)
+	err = errNorm/scale;
+      else if (errNorm > 0.0)
+	err = 1.0e10;
+
+      if (err > 1.0 && step > dtMin*(1.0 + 1.0e-9)) {
+	// reject and repeat with a smaller step
+	the_Domain->revertToLastCommit();
+	theIntegrator->revertToLastStep();
+	double fac = 0.9*pow(err, -1.0/3.0);
+	if (fac < 0.2) fac = 0.2;
+	if (fac > 0.9) fac = 0.9;
+	h = step*fac;
+	continue;
+      }
+      adaptDispPeak = peak;
+    }
+
+    // the recorders only see the points of the dT grid
+    double tNew = t + step;
+    bool onGrid = fabs(tNew - (t0 + floor((tNew - t0)/dT + 0.5)*dT)) <= tiny;
+    bool recordOnCommit = the_Domain->getRecordOnCommit();
+    the_Domain->setRecordOnCommit(recordOnCommit && onGrid);
+    result = this->commitStep();
+    the_Domain->setRecordOnCommit(recordOnCommit);
+    if (result < 0)
+      return result;
+
+    double fac = 5.0;
+    if (err > 1.0e-10)
+      fac = 0.9*pow(err, -0.7/3.0)*pow(adaptErrPrev, 0.4/3.0);
+    if (fac > 5.0) fac = 5.0;
+    if (fac < 0.2) fac = 0.2;
+    adaptErrPrev = err > 1.0e-4 ? err : 1.0e-4;
+
+    // a step shortened only to land on the grid says little about h
+    if (step < h && err < 1.0)
+      h = h > step*fac ? h : step*fac;
+    else
+      h = step*fac;
+  }
+
+  adaptDt = h;
+  return 0;
+}
+
 int
 DirectIntegrationAnalysis::analyzeSubLevel(int level, double dT) {
   int result = 0;
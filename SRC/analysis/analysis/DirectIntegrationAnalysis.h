@@ -70,6 +70,11 @@ class DirectIntegrationAnalysis: public TransientAnalysis
     int analyze(int numSteps, double dT, bool flush = true);
     int analyzeStep(double dT);
     int analyzeSubLevel(int level, double dT);
+
+    // error controlled stepping: the step size follows a PI controller on
+    // the integrator's local error estimate, failed or inaccurate steps are
+    // repeated with a smaller dt, and the steps land on the dT output grid
+    int setAdaptive(double tol, double dtMin, double dtMax, double atol = 0.0);
     int eigen(int numMode, bool generlzed = true, bool findSmallest = true);
     int initialize(void);
     int domainChanged(void);
@@ -104,6 +109,12 @@ class DirectIntegrationAnalysis: public TransientAnalysis
     int numSubLevels;
     int numSubSteps;
 
+    int solveStep(double dT);
+    int commitStep(void);
+    int analyzeAdaptive(int numSteps, double dT);
+    double adaptTol, adaptAtol, adaptDtMin, adaptDtMax;
+    double adaptDt, adaptErrPrev, adaptDispPeak;
+
 
 };
 
@@ -0,0 +1,716 @@
+/* ****************************************************************** **
+**    OpenSees - Open System for Earthquake Engineering Simulation    **
+**          Pacific Earthquake Engineering Research Center            **
+**                                                                    **
+**                                                                    **
+** (C) Copyright 1999, The Regents of the University of California    **
+** All Rights Reserved.                                               **
+**                                                                    **
+** Commercial use of this program without express permission of the   **
+** University of California, Berkeley, is strictly prohibited.  See   **
+** file 'COPYRIGHT'  in main directory for information on usage and   **
+** redistribution,  and for a DISCLAIMER OF ALL WARRANTIES.           **
+**                                                                    **
+** Developed by:                                                      **
+**   Frank McKenna (fmckenna@ce.berkeley.edu)                         **
+**   Gregory L. Fenves (fenves@ce.berkeley.edu)                       **
+**   Filip C. Filippou (filippou@ce.berkeley.edu)                     **
+**                                                                    **
+** ****************************************************************** */
+
+// Description: This file contains the implementation of the
+// ModalSuperpositionAnalysis class.
+
+#include <ModalSuperpositionAnalysis.h>
+#include <Domain.h>
+#include <Node.h>
+#include <NodeIter.h>
+#include <Element.h>
+#include <ElementIter.h>
+#include <LoadPattern.h>
+#include <LoadPatternIter.h>
+#include <NodalLoad.h>
+#include <NodalLoadIter.h>
+#include <ElementalLoad.h>
+#include <ElementalLoadIter.h>
+#include <UniformExcitation.h>
+#include <GroundMotion.h>
+#include <classTags.h>
+#include <OPS_Globals.h>
+#include <math.h>
+#include <string.h>
+
+// fixed point iteration on the link pseudo force
+static const int maxLinkIter = 50;
+static const double linkTol = 1.0e-10;
+
+ModalSuperpositionAnalysis::ModalSuperpositionAnalysis(Domain &the_Domain,
+						       ConstraintHandler &theHandler,
+						       DOF_Numberer &theNumberer,
+						       AnalysisModel &theModel,
+						       EquiSolnAlgo &theSolnAlgo,
+						       LinearSOE &theLinSOE,
+						       TransientIntegrator &theTransientIntegrator,
+						       ConvergenceTest *theTest,
+						       int num_Modes,
+						       double damp_Ratio,
+						       const ID *theLinkTags,
+						       const ID *theRecordNodes)
+:DirectIntegrationAnalysis(the_Domain, theHandler, theNumberer, theModel,
+			   theSolnAlgo, theLinSOE, theTransientIntegrator, theTest),
+ numModes(num_Modes), dampRatio(damp_Ratio),
+ numDOF(0), basisStamp(-1), effDt(0.0), stateTime(0.0), validState(false)
+{
+  if (theLinkTags != 0)
+    linkTags = *theLinkTags;
+  if (theRecordNodes != 0)
+    recordTags = *theRecordNodes;
+}
+
+ModalSuperpositionAnalysis::~ModalSuperpositionAnalysis()
+{
+
+}
+
+int
+ModalSuperpositionAnalysis::elementDofs(Element *theEle, std::vector<int> &dofs)
+{
+  dofs.clear();
+  const ID &eleNodes = theEle->getExternalNodes();
+  for (int i = 0; i < eleNodes.Size(); i++) {
+    std::map<int, int>::iterator it = nodeIndex.find(eleNodes(i));
+    if (it == nodeIndex.end())
+      return -1;
+    int n = it->second;
+    int ndf = theNodes[n]->getNumberDOF();
+    for (int j = 0; j < ndf; j++)
+      dofs.push_back(nodeStart[n] + j);
+  }
+  return dofs.size();
+}
+
+void
+ModalSuperpositionAnalysis::addProjection(const std::vector<int> &dofs, const Vector &f, Vector &p)
+{
+  // p += Phi(dofs)^T f
+  int m = numModes;
+  for (size_t j = 0; j < dofs.size(); j++) {
+    double fj = f(j);
+    if (fj == 0.0)
+      continue;
+    const double *row = &phi[dofs[j]*m];
+    for (int k = 0; k < m; k++)
+      p(k) += row[k]*fj;
+  }
+}
+
+void
+ModalSuperpositionAnalysis::addProjection(const std::vector<int> &dofs, const Matrix &A, Matrix &Ar)
+{
+  // Ar += Phi(dofs)^T A Phi(dofs)
+  int m = numModes;
+  int n = dofs.size();
+  Matrix Phi(n, m);
+  for (int j = 0; j < n; j++) {
+    const double *row = &phi[dofs[j]*m];
+    for (int k = 0; k < m; k++)
+      Phi(j, k) = row[k];
+  }
+  Ar.addMatrixTripleProduct(1.0, Phi, A, 1.0);
+}
+
+int
+ModalSuperpositionAnalysis::formBasis(void)
+{
+  Domain *theDomain = this->getDomainPtr();
+  const Vector &lambda = theDomain->getEigenvalues();
+  int m = numModes;
+  if (m < 1 || lambda.Size() < m) {
+    opserr << "WARNING ModalSuperpositionAnalysis::formBasis() - " << m
+	   << " modes requested but " << lambda.Size()
+	   << " eigenvectors are set, run eigen first\n";
+    return -1;
+  }
+
+  //
+  // the basis, in a dof numbering of its own running node by node
+  //
+
+  theNodes.clear();
+  nodeIndex.clear();
+  nodeStart.clear();
+  numDOF = 0;
+  NodeIter &theNodeIter = theDomain->getNodes();
+  Node *theNode;
+  while ((theNode = theNodeIter()) != 0) {
+    nodeIndex[theNode->getTag()] = theNodes.size();
+    theNodes.push_back(theNode);
+    nodeStart.push_back(numDOF);
+    numDOF += theNode->getNumberDOF();
+  }
+  if (numDOF == 0) {
+    opserr << "WARNING ModalSuperpositionAnalysis::formBasis() - no nodes in the domain\n";
+    return -1;
+  }
+
+  phi.assign(numDOF*m, 0.0);
+  for (size_t i = 0; i < theNodes.size(); i++) {
+    const Matrix &ev = theNodes[i]->getEigenvectors();
+    int ndf = theNodes[i]->getNumberDOF();
+    double *row = &phi[nodeStart[i]*m];
+    for (int j = 0; j < ndf; j++)
+      for (int k = 0; k < m; k++)
+	row[j*m + k] = ev(j, k);
+  }
+
+  //
+  // the reduced mass & initial stiffness, the nonlinear links stay in
+  // the model with their initial stiffness
+  //
+
+  Mr.resize(m, m);
+  Kr.resize(m, m);
+  Cr.resize(m, m);
+  Mr.Zero();
+  Kr.Zero();
+  Cr.Zero();
+
+  std::vector<int> dofs;
+  for (size_t i = 0; i < theNodes.size(); i++) {
+    int ndf = theNodes[i]->getNumberDOF();
+    dofs.clear();
+    for (int j = 0; j < ndf; j++)
+      dofs.push_back(nodeStart[i] + j);
+    this->addProjection(dofs, theNodes[i]->getMass(), Mr);
+  }
+
+  links.clear();
+  linkStart.clear();
+  linkDof.clear();
+  linkK0.clear();
+  linkR0.clear();
+  linkStart.push_back(0);
+  std::vector<bool> isLinkNode(theNodes.size(), false);
+
+  ElementIter &theEleIter = theDomain->getElements();
+  Element *theEle;
+  while ((theEle = theEleIter()) != 0) {
+    int n = this->elementDofs(theEle, dofs);
+    const Matrix &K = theEle->getInitialStiff();
+    if (n < 0 || K.noRows() != n) {
+      opserr << "WARNING ModalSuperpositionAnalysis::formBasis() - element "
+	     << theEle->getTag() << " ignored, its dofs do not match its nodes\n";
+      continue;
+    }
+    this->addProjection(dofs, K, Kr);
+    this->addProjection(dofs, theEle->getMass(), Mr);
+
+    bool isLink = false;
+    if (linkTags.Size() != 0)
+      isLink = (linkTags.getLocation(theEle->getTag()) >= 0);
+    else {
+      const char *type = theEle->getClassType();
+      isLink = (strstr(type, "ZeroLength") != 0 || strstr(type, "TwoNodeLink") != 0);
+    }
+    if (isLink) {
+      links.push_back(theEle);
+      linkK0.push_back(K);
+      linkR0.push_back(Vector(n));
+      linkDof.insert(linkDof.end(), dofs.begin(), dofs.end());
+      linkStart.push_back(linkDof.size());
+      const ID &eleNodes = theEle->getExternalNodes();
+      for (int i = 0; i < eleNodes.Size(); i++)
+	isLinkNode[nodeIndex[eleNodes(i)]] = true;
+    }
+  }
+
+  linkNodes.clear();
+  for (size_t i = 0; i < theNodes.size(); i++)
+    if (isLinkNode[i] == true)
+      linkNodes.push_back(i);
+
+  // modal damping on the diagonal, from the given ratio or the one set
+  // by the modalDamping command
+  const Vector *modalDamping = theDomain->getModalDampingFactors();
+  for (int k = 0; k < m; k++) {
+    double zeta = dampRatio;
+    if (zeta < 0.0)
+      zeta = (modalDamping != 0 && modalDamping->Size() > k) ? (*modalDamping)(k) : 0.0;
+    double omega = (lambda(k) > 0.0) ? sqrt(lambda(k)) : 0.0;
+    Cr(k, k) = 2.0*zeta*omega*Mr(k, k);
+  }
+
+  //
+  // the nodes taken back to physical coordinates each step
+  //
+
+  recordNodes.clear();
+  if (recordTags.Size() == 0) {
+    for (size_t i = 0; i < theNodes.size(); i++)
+      recordNodes.push_back(i);
+  } else {
+    for (int i = 0; i < recordTags.Size(); i++) {
+      std::map<int, int>::iterator it = nodeIndex.find(recordTags(i));
+      if (it == nodeIndex.end())
+	opserr << "WARNING ModalSuperpositionAnalysis::formBasis() - no node " << recordTags(i) << endln;
+      else
+	recordNodes.push_back(it->second);
+    }
+  }
+
+  basisEigenvalues = lambda;
+  effDt = 0.0;
+  loadPatterns.clear();
+  validState = false;
+
+  return 0;
+}
+
+int
+ModalSuperpositionAnalysis::formLoads(void)
+{
+  //
+  // the plain patterns are projected with unit factor & the uniform
+  // excitations with unit ground acceleration, -Phi^T M r; any other
+  // pattern is projected from the nodal loads it applies each step
+  //
+
+  Domain *theDomain = this->getDomainPtr();
+  int m = numModes;
+  double time = theDomain->getCurrentTime();
+
+  loadPatterns.clear();
+  patternKind.clear();
+  patternLoads.clear();
+
+  std::vector<int> dofs;
+  Vector one(1);
+  one(0) = 1.0;
+
+  LoadPatternIter &thePatterns = theDomain->getLoadPatterns();
+  LoadPattern *thePattern;
+  while ((thePattern = thePatterns()) != 0) {
+    Vector p(m);
+    int kind = 2;
+
+    if (thePattern->getClassTag() == PATTERN_TAG_LoadPattern) {
+      kind = 0;
+      NodalLoadIter &theNodalLoads = thePattern->getNodalLoads();
+      NodalLoad *theNodalLoad;
+      while ((theNodalLoad = theNodalLoads()) != 0) {
+	std::map<int, int>::iterator it = nodeIndex.find(theNodalLoad->getNodeTag());
+	if (it == nodeIndex.end())
+	  continue;
+	Node *theNode = theNodes[it->second];
+	theNode->zeroUnbalancedLoad();
+	theNodalLoad->applyLoad(1.0);
+	int ndf = theNode->getNumberDOF();
+	dofs.clear();
+	for (int j = 0; j < ndf; j++)
+	  dofs.push_back(nodeStart[it->second] + j);
+	this->addProjection(dofs, theNode->getUnbalancedLoad(), p);
+      }
+
+      // the element loads show up in the resisting force only
+      ElementalLoadIter &theEleLoads = thePattern->getElementalLoads();
+      ElementalLoad *theEleLoad;
+      while ((theEleLoad = theEleLoads()) != 0) {
+	Element *theEle = theDomain->getElement(theEleLoad->getElementTag());
+	if (theEle == 0 || this->elementDofs(theEle, dofs) < 0)
+	  continue;
+	theEle->zeroLoad();
+	Vector R0(theEle->getResistingForce());
+	theEleLoad->applyLoad(1.0);
+	R0 -= theEle->getResistingForce();
+	this->addProjection(dofs, R0, p);
+      }
+    }
+
+    else if (thePattern->getClassTag() == PATTERN_TAG_UniformExcitation) {
+      kind = 1;
+      thePattern->applyLoad(time);   // sets the influence vectors r
+
+      for (size_t i = 0; i < theNodes.size(); i++) {
+	int ndf = theNodes[i]->getNumberDOF();
+	const Vector &r = theNodes[i]->getRV(one);
+	Vector f(ndf);
+	f.addMatrixVector(0.0, theNodes[i]->getMass(), r, -1.0);
+	dofs.clear();
+	for (int j = 0; j < ndf; j++)
+	  dofs.push_back(nodeStart[i] + j);
+	this->addProjection(dofs, f, p);
+      }
+
+      ElementIter &theEleIter = theDomain->getElements();
+      Element *theEle;
+      while ((theEle = theEleIter()) != 0) {
+	int n = this->elementDofs(theEle, dofs);
+	const Matrix &M = theEle->getMass();
+	if (n < 0 || M.noRows() != n)
+	  continue;
+	Vector r(n);
+	const ID &eleNodes = theEle->getExternalNodes();
+	for (int i = 0, loc = 0; i < eleNodes.Size(); i++) {
+	  Node *theNode = theNodes[nodeIndex[eleNodes(i)]];
+	  const Vector &rNode = theNode->getRV(one);
+	  for (int j = 0; j < rNode.Size(); j++)
+	    r(loc++) = rNode(j);
+	}
+	Vector f(n);
+	f.addMatrixVector(0.0, M, r, -1.0);
+	this->addProjection(dofs, f, p);
+      }
+    }
+
+    else
+      opserr << "WARNING ModalSuperpositionAnalysis - pattern " << thePattern->getTag()
+	     << " is projected from its nodal loads only\n";
+
+    loadPatterns.push_back(thePattern);
+    patternKind.push_back(kind);
+    patternLoads.push_back(p);
+  }
+
+  // back to the loads of the current time
+  theDomain->applyLoad(time);
+
+  return 0;
+}
+
+void
+ModalSuperpositionAnalysis::formLoad(double time, Vector &p)
+{
+  p.Zero();
+
+  std::vector<int> dofs;
+  for (size_t l = 0; l < loadPatterns.size(); l++) {
+    LoadPattern *thePattern = loadPatterns[l];
+    if (patternKind[l] == 0)
+      p.addVector(1.0, patternLoads[l], thePattern->getLoadFactor(time));
+
+    else if (patternKind[l] == 1) {
+      GroundMotion *theMotion =
+	const_cast<GroundMotion *>(((UniformExcitation *)thePattern)->getGroundMotion());
+      if (theMotion != 0)
+	p.addVector(1.0, patternLoads[l], theMotion->getAccel(time));
+    }
+
+    else {
+      for (size_t i = 0; i < theNodes.size(); i++)
+	theNodes[i]->zeroUnbalancedLoad();
+      thePattern->applyLoad(time);
+      for (size_t i = 0; i < theNodes.size(); i++) {
+	int ndf = theNodes[i]->getNumberDOF();
+	dofs.clear();
+	for (int j = 0; j < ndf; j++)
+	  dofs.push_back(nodeStart[i] + j);
+	this->addProjection(dofs, theNodes[i]->getUnbalancedLoad(), p);
+      }
+    }
+  }
+}
+
+int
+ModalSuperpositionAnalysis::formInitialState(void)
+{
+  //
+  // the response is measured from the committed state: q = 0 and
+  // qdot the projection of the committed velocity, Mr qdot = Phi^T M v0
+  //
+
+  Domain *theDomain = this->getDomainPtr();
+  int m = numModes;
+
+  u0.assign(numDOF, 0.0);
+  std::vector<double> v0(numDOF, 0.0);
+  for (size_t i = 0; i < theNodes.size(); i++) {
+    const Vector &d = theNodes[i]->getDisp();
+    const Vector &v = theNodes[i]->getVel();
+    for (int j = 0; j < d.Size(); j++) {
+      u0[nodeStart[i] + j] = d(j);
+      v0[nodeStart[i] + j] = v(j);
+    }
+  }
+
+  Vector Mv(m);
+  std::vector<int> dofs;
+  for (size_t i = 0; i < theNodes.size(); i++) {
+    int ndf = theNodes[i]->getNumberDOF();
+    dofs.clear();
+    for (int j = 0; j < ndf; j++)
+      dofs.push_back(nodeStart[i] + j);
+    Vector f(ndf);
+    f.addMatrixVector(0.0, theNodes[i]->getMass(), theNodes[i]->getVel(), 1.0);
+    this->addProjection(dofs, f, Mv);
+  }
+
+  ElementIter &theEleIter = theDomain->getElements();
+  Element *theEle;
+  while ((theEle = theEleIter()) != 0) {
+    int n = this->elementDofs(theEle, dofs);
+    const Matrix &M = theEle->getMass();
+    if (n < 0 || M.noRows() != n)
+      continue;
+    Vector v(n);
+    for (int j = 0; j < n; j++)
+      v(j) = v0[dofs[j]];
+    Vector f(n);
+    f.addMatrixVector(0.0, M, v, 1.0);
+    this->addProjection(dofs, f, Mv);
+  }
+
+  q.resize(m);
+  qdot.resize(m);
+  qddot.resize(m);
+  fnl.resize(m);
+  q.Zero();
+  fnl.Zero();
+  if (Mr.Solve(Mv, qdot) < 0) {
+    opserr << "WARNING ModalSuperpositionAnalysis - singular reduced mass, check the eigenvectors\n";
+    return -1;
+  }
+
+  // Mr qddot = -Cr qdot, the loads at the start are in equilibrium
+  Vector Cv(m);
+  Cv.addMatrixVector(0.0, Cr, qdot, -1.0);
+  Mr.Solve(Cv, qddot);
+
+  for (size_t l = 0; l < links.size(); l++)
+    linkR0[l] = links[l]->getResistingForce();
+
+  stateTime = theDomain->getCurrentTime();
+  p0.resize(m);
+  this->formLoad(stateTime, p0);
+
+  validState = true;
+  return 0;
+}
+
+int
+ModalSuperpositionAnalysis::formEffectiveMass(double dT)
+{
+  // average acceleration: Meff = Mr + dt/2 Cr + dt^2/4 Kr
+  Matrix Meff(Mr);
+  Meff.addMatrix(1.0, Cr, 0.5*dT);
+  Meff.addMatrix(1.0, Kr, 0.25*dT*dT);
+  MeffInv.resize(numModes, numModes);
+  if (Meff.Invert(MeffInv) < 0) {
+    opserr << "WARNING ModalSuperpositionAnalysis - singular effective mass\n";
+    return -1;
+  }
+  effDt = dT;
+  return 0;
+}
+
+void
+ModalSuperpositionAnalysis::recoverNodes(const std::vector<int> &nodes, bool commit)
+{
+  // u = u0 + Phi q, v = Phi qdot, a = Phi qddot
+  int m = numModes;
+  for (size_t i = 0; i < nodes.size(); i++) {
+    Node *theNode = theNodes[nodes[i]];
+    int ndf = theNode->getNumberDOF();
+    int start = nodeStart[nodes[i]];
+    if (disp.Size() != ndf) {
+      disp.resize(ndf);
+      vel.resize(ndf);
+      accel.resize(ndf);
+    }
+    for (int j = 0; j < ndf; j++) {
+      const double *row = &phi[(start + j)*m];
+      double d = u0[start + j];
+      double v = 0.0;
+      double a = 0.0;
+      for (int k = 0; k < m; k++) {
+	d += row[k]*q(k);
+	v += row[k]*qdot(k);
+	a += row[k]*qddot(k);
+      }
+      disp(j) = d;
+      vel(j) = v;
+      accel(j) = a;
+    }
+    theNode->setTrialDisp(disp);
+    theNode->setTrialVel(vel);
+    theNode->setTrialAccel(accel);
+    if (commit)
+      theNode->commitState();
+  }
+}
+
+int
+ModalSuperpositionAnalysis::formLinkForces(const Vector &qTrial, const Vector &qdotTrial, Vector &f)
+{
+  // f = Phi^T (R(u) - R(u0) - K0 (u - u0)) over the links
+  int m = numModes;
+  f.Zero();
+
+  this->recoverNodes(linkNodes, false);
+
+  for (size_t l = 0; l < links.size(); l++) {
+    Element *theLink = links[l];
+    if (theLink->update() < 0)
+      return -1;
+    const Vector &R = theLink->getResistingForce();
+    const Matrix &K0 = linkK0[l];
+    const Vector &R0 = linkR0[l];
+    int n = linkStart[l+1] - linkStart[l];
+    const int *dofs = &linkDof[linkStart[l]];
+
+    Vector du(n);
+    for (int j = 0; j < n; j++) {
+      const double *row = &phi[dofs[j]*m];
+      double d = 0.0;
+      for (int k = 0; k < m; k++)
+	d += row[k]*qTrial(k);
+      du(j) = d;
+    }
+
+    for (int j = 0; j < n; j++) {
+      double r = R(j) - R0(j);
+      for (int i = 0; i < n; i++)
+	r -= K0(j, i)*du(i);
+      if (r == 0.0)
+	continue;
+      const double *row = &phi[dofs[j]*m];
+      for (int k = 0; k < m; k++)
+	f(k) += row[k]*r;
+    }
+  }
+
+  return 0;
+}
+
+int
+ModalSuperpositionAnalysis::analyze(int numSteps, double dT, bool flush)
+{
+  Domain *theDomain = this->getDomainPtr();
+  int m = numModes;
+
+  //
+  // rebuild the basis if the model or the eigenvectors changed & start
+  // from the committed state unless continuing the previous analyze()
+  //
+
+  int stamp = theDomain->hasDomainChanged();
+  const Vector &lambda = theDomain->getEigenvalues();
+  bool newBasis = (stamp != basisStamp || basisEigenvalues.Size() != lambda.Size());
+  for (int k = 0; newBasis == false && k < lambda.Size(); k++)
+    if (basisEigenvalues(k) != lambda(k))
+      newBasis = true;
+  if (newBasis) {
+    if (this->formBasis() < 0)
+      return -1;
+    basisStamp = stamp;
+  }
+
+  bool newLoads = (loadPatterns.size() == 0);
+  LoadPatternIter &thePatterns = theDomain->getLoadPatterns();
+  LoadPattern *thePattern;
+  size_t numPatterns = 0;
+  while ((thePattern = thePatterns()) != 0) {
+    if (numPatterns >= loadPatterns.size() || loadPatterns[numPatterns] != thePattern)
+      newLoads = true;
+    numPatterns++;
+  }
+  if (numPatterns != loadPatterns.size())
+    newLoads = true;
+  if (newLoads) {
+    this->formLoads();
+    validState = false;
+  }
+
+  if (validState == false || stateTime != theDomain->getCurrentTime())
+    if (this->formInitialState() < 0)
+      return -1;
+
+  if (dT != effDt)
+    if (this->formEffectiveMass(dT) < 0)
+      return -1;
+
+  Vector p(m), rhs0(m), fnlTrial(m);
+  Vector qn(m), qdotn(m), qddotn(m);
+  double c1 = 0.5*dT;
+  double c2 = 0.25*dT*dT;
+
+  for (int step = 0; step < numSteps; step++) {
+    double time = stateTime + dT;
+
+    this->formLoad(time, p);
+    p -= p0;
+
+    qn = q;
+    qdotn = qdot;
+    qddotn = qddot;
+
+    // the part of Meff qddot = rhs independent of the new state
+    rhs0 = p;
+    rhs0.addMatrixVector(1.0, Cr, qdotn, -1.0);
+    rhs0.addMatrixVector(1.0, Cr, qddotn, -c1);
+    rhs0.addMatrixVector(1.0, Kr, qn, -1.0);
+    rhs0.addMatrixVector(1.0, Kr, qdotn, -dT);
+    rhs0.addMatrixVector(1.0, Kr, qddotn, -c2);
+    double rhsNorm = rhs0.Norm();
+
+    bool converged = false;
+    for (int iter = 0; iter < maxLinkIter; iter++) {
+      Vector rhs(rhs0);
+      rhs -= fnl;
+      qddot.addMatrixVector(0.0, MeffInv, rhs, 1.0);
+      q = qn;
+      q.addVector(1.0, qdotn, dT);
+      q.addVector(1.0, qddotn, c2);
+      q.addVector(1.0, qddot, c2);
+      qdot = qdotn;
+      qdot.addVector(1.0, qddotn, c1);
+      qdot.addVector(1.0, qddot, c1);
+
+      if (links.size() == 0) {
+	converged = true;
+	break;
+      }
+
+      if (this->formLinkForces(q, qdot, fnlTrial) < 0)
+	break;
+      fnlTrial -= fnl;
+      double change = fnlTrial.Norm();
+      fnl += fnlTrial;
+      if (change <= linkTol*(fnl.Norm() + rhsNorm)) {
+	converged = true;
+	break;
+      }
+    }
+
+    if (converged == false) {
+      opserr << "WARNING ModalSuperpositionAnalysis::analyze() - the link forces failed to converge at time "
+	     << time << endln;
+      q = qn;
+      qdot = qdotn;
+      qddot = qddotn;
+      this->formLinkForces(q, qdot, fnl);
+      return -3;
+    }
+
+    for (size_t l = 0; l < links.size(); l++)
+      links[l]->commitState();
+
+    this->recoverNodes(recordNodes, true);
+    stateTime = time;
+    theDomain->setCurrentTime(time);
+    theDomain->setCommittedTime(time);
+    theDomain->record();
+  }
+
+  // all nodes take the physical response for the commands that follow
+  if (recordNodes.size() != theNodes.size()) {
+    std::vector<int> allNodes(theNodes.size());
+    for (size_t i = 0; i < theNodes.size(); i++)
+      allNodes[i] = i;
+    this->recoverNodes(allNodes, true);
+  }
+
+  if (flush)
+    theDomain->flushRecorders();
+
+  return 0;
+}
@@ -0,0 +1,128 @@
+/* ****************************************************************** **
+**    OpenSees - Open System for Earthquake Engineering Simulation    **
+**          Pacific Earthquake Engineering Research Center            **
+**                                                                    **
+**                                                                    **
+** (C) Copyright 1999, The Regents of the University of California    **
+** All Rights Reserved.                                               **
+**                                                                    **
+** Commercial use of this program without express permission of the   **
+** University of California, Berkeley, is strictly prohibited.  See   **
+** file 'COPYRIGHT'  in main directory for information on usage and   **
+** redistribution,  and for a DISCLAIMER OF ALL WARRANTIES.           **
+**                                                                    **
+** Developed by:                                                      **
+**   Frank McKenna (fmckenna@ce.berkeley.edu)                         **
+**   Gregory L. Fenves (fenves@ce.berkeley.edu)                       **
+**   Filip C. Filippou (filippou@ce.berkeley.edu)                     **
+**                                                                    **
+** ****************************************************************** */
+
+#ifndef ModalSuperpositionAnalysis_h
+#define ModalSuperpositionAnalysis_h
+
+// Description: This file contains the class definition for
+// ModalSuperpositionAnalysis. ModalSuperpositionAnalysis is a subclass
+// of DirectIntegrationAnalysis that integrates the response in the basis
+// of the eigenvectors set by the last eigen analysis:
+//
+//   u = u0 + Phi q,   Mr q'' + Cr q' + Kr q = Phi^T (P(t) - P(t0)) - fnl
+//
+// Mr and Kr are the projections of the element and nodal mass and
+// initial stiffness, Cr holds modal damping. The nonlinear link elements
+// (zeroLength & twoNodeLink by default) stay in physical coordinates as
+// the pseudo force fnl = Phi^T (R(u) - R(u0) - K0 (u - u0)), iterated
+// within each average acceleration step. Loads are projected once per
+// pattern and scaled with the pattern factor, so a step costs
+// O(modes^2 + modes x link dofs) plus the recovery of the recorded nodes.
+
+#include <DirectIntegrationAnalysis.h>
+#include <Vector.h>
+#include <Matrix.h>
+#include <ID.h>
+#include <vector>
+#include <map>
+
+class ConstraintHandler;
+class DOF_Numberer;
+class AnalysisModel;
+class TransientIntegrator;
+class LinearSOE;
+class EquiSolnAlgo;
+class ConvergenceTest;
+class Node;
+class Element;
+class LoadPattern;
+
+class ModalSuperpositionAnalysis: public DirectIntegrationAnalysis
+{
+  public:
+    ModalSuperpositionAnalysis(Domain &theDomain,
+			       ConstraintHandler &theHandler,
+			       DOF_Numberer &theNumberer,
+			       AnalysisModel &theModel,
+			       EquiSolnAlgo &theSolnAlgo,
+			       LinearSOE &theSOE,
+			       TransientIntegrator &theIntegrator,
+			       ConvergenceTest *theTest,
+			       int numModes,
+			       double dampRatio = -1.0,
+			       const ID *linkTags = 0,
+			       const ID *recordNodes = 0);
+    virtual ~ModalSuperpositionAnalysis();
+
+    int analyze(int numSteps, double dT, bool flush = true);
+
+  protected:
+
+  private:
+    int formBasis(void);
+    int formLoads(void);
+    int formInitialState(void);
+    int formEffectiveMass(double dT);
+    void formLoad(double time, Vector &p);
+    int formLinkForces(const Vector &q, const Vector &qdot, Vector &f);
+    int elementDofs(Element *theEle, std::vector<int> &dofs);
+    void addProjection(const std::vector<int> &dofs, const Vector &f, Vector &p);
+    void addProjection(const std::vector<int> &dofs, const Matrix &A, Matrix &Ar);
+    void recoverNodes(const std::vector<int> &nodes, bool commit);
+
+    int numModes;
+    double dampRatio;                  // < 0: the domain modal damping
+    ID linkTags;
+    ID recordTags;
+
+    // the nodes, their first dof in the basis & the basis (dof x mode)
+    std::vector<Node *> theNodes;
+    std::map<int, int> nodeIndex;
+    std::vector<int> nodeStart;
+    std::vector<double> phi;
+    std::vector<double> u0;            // the disp the response is added to
+    std::vector<int> recordNodes, linkNodes;
+    int numDOF;
+    int basisStamp;
+    Vector basisEigenvalues;
+
+    Matrix Mr, Kr, Cr, MeffInv;
+    double effDt;
+
+    // the nonlinear links: basis dofs, initial stiffness & start forces
+    std::vector<Element *> links;
+    std::vector<int> linkStart, linkDof;
+    std::vector<Matrix> linkK0;
+    std::vector<Vector> linkR0;
+
+    // the patterns with their projected unit load (kind 0: plain,
+    // 1: uniform excitation, 2: projected from the nodal loads each step)
+    std::vector<LoadPattern *> loadPatterns;
+    std::vector<int> patternKind;
+    std::vector<Vector> patternLoads;
+    Vector p0;
+
+    Vector q, qdot, qddot, fnl;
+    Vector disp, vel, accel;
+    double stateTime;
+    bool validState;
+};
+
+#endif
@@ -0,0 +1,391 @@
+/* ****************************************************************** **
+**    OpenSees - Open System for Earthquake Engineering Simulation    **
+**          Pacific Earthquake Engineering Research Center            **
+**                                                                    **
+**                                                                    **
+** (C) Copyright 1999, The Regents of the University of California    **
+** All Rights Reserved.                                               **
+**                                                                    **
+** Commercial use of this program without express permission of the   **
+** University of California, Berkeley, is strictly prohibited.  See   **
+** file 'COPYRIGHT'  in main directory for information on usage and   **
+** redistribution,  and for a DISCLAIMER OF ALL WARRANTIES.           **
+**                                                                    **
+** Developed by:                                                      **
+**   Frank McKenna (fmckenna@ce.berkeley.edu)                         **
+**   Gregory L. Fenves (fenves@ce.berkeley.edu)                       **
+**   Filip C. Filippou (filippou@ce.berkeley.edu)                     **
+**                                                                    **
+** ****************************************************************** */
+
+// Description: This file contains the implementation of the
+// PararealAnalysis class.
+
+#include <PararealAnalysis.h>
+#include <TransientIntegrator.h>
+#include <Domain.h>
+#include <Node.h>
+#include <NodeIter.h>
+#include <OPS_Globals.h>
+#include <math.h>
+#include <stdio.h>
+
+#if !defined(_WIN32) && !defined(_PARALLEL_PROCESSING) && !defined(_PARALLEL_INTERPRETERS)
+#define _PARAREAL_WORKERS
+#include <unistd.h>
+#include <sys/types.h>
+#include <sys/wait.h>
+
+static bool
+writePararealRecord(int fd, const double *data, int numBytes)
+{
+  const char *ptr = (const char *)data;
+  while (numBytes > 0) {
+    ssize_t numWritten = write(fd, ptr, numBytes);
+    if (numWritten <= 0)
+      return false;
+    ptr += numWritten;
+    numBytes -= numWritten;
+  }
+  return true;
+}
+
+static bool
+readPararealRecord(int fd, double *data, int numBytes)
+{
+  char *ptr = (char *)data;
+  while (numBytes > 0) {
+    ssize_t numRead = read(fd, ptr, numBytes);
+    if (numRead <= 0)
+      return false;
+    ptr += numRead;
+    numBytes -= numRead;
+  }
+  return true;
+}
+#endif
+
+PararealAnalysis::PararealAnalysis(Domain &the_Domain,
+				   ConstraintHandler &theHandler,
+				   DOF_Numberer &theNumberer,
+				   AnalysisModel &theModel,
+				   EquiSolnAlgo &theSolnAlgo,
+				   LinearSOE &theLinSOE,
+				   TransientIntegrator &theTransientIntegrator,
+				   ConvergenceTest *theTest,
+				   int num_Workers,
+				   int num_Windows,
+				   int coarse_Steps,
+				   int max_Iter,
+				   double _tol)
+:DirectIntegrationAnalysis(the_Domain, theHandler, theNumberer, theModel,
+			   theSolnAlgo, theLinSOE, theTransientIntegrator, theTest),
+ numWorkers(num_Workers), numWindows(num_Windows),
+ coarseSteps(coarse_Steps > 0 ? coarse_Steps : 1),
+ maxIter(max_Iter > 0 ? max_Iter : 1), tol(_tol),
+ stateSize(0), startTime(0.0)
+{
+
+}
+
+PararealAnalysis::~PararealAnalysis()
+{
+
+}
+
+int
+PararealAnalysis::getState(Vector &state)
+{
+  Domain *the_Domain = this->getDomainPtr();
+
+  if (state.Size() != stateSize)
+    state.resize(stateSize);
+
+  int loc = 0;
+  NodeIter &theNodes = the_Domain->getNodes();
+  Node *theNode;
+  while ((theNode = theNodes()) != 0) {
+    const Vector &disp = theNode->getTrialDisp();
+    const Vector &vel = theNode->getTrialVel();
+    const Vector &accel = theNode->getTrialAccel();
+    int ndf = theNode->getNumberDOF();
+    for (int i = 0; i < ndf; i++) {
+      state(loc++) = disp(i);
+      state(loc++) = vel(i);
+      state(loc++) = accel(i);
+    }
+  }
+
+  return 0;
+}
+
+int
+PararealAnalysis::setState(const Vector &state, double time)
+{
+  // the nodes take the state as committed response, the elements follow
+  // through update() & commit(), and the integrator picks it up from the
+  // committed response of its DOF_Groups in domainChanged()
+  Domain *the_Domain = this->getDomainPtr();
+
+  int loc = 0;
+  NodeIter &theNodes = the_Domain->getNodes();
+  Node *theNode;
+  while ((theNode = theNodes()) != 0) {
+    int ndf = theNode->getNumberDOF();
+    Vector disp(ndf), vel(ndf), accel(ndf);
+    for (int i = 0; i < ndf; i++) {
+      disp(i) = state(loc++);
+      vel(i) = state(loc++);
+      accel(i) = state(loc++);
+    }
+    theNode->setTrialDisp(disp);
+    theNode->setTrialVel(vel);
+    theNode->setTrialAccel(accel);
+  }
+
+  the_Domain->setCurrentTime(time);
+  the_Domain->setCommittedTime(time);
+  the_Domain->applyLoad(time);
+  if (the_Domain->update() < 0 || the_Domain->commit() < 0) {
+    opserr << "WARNING PararealAnalysis - failed to set the state at time " << time << endln;
+    return -1;
+  }
+
+  return this->getIntegrator()->domainChanged();
+}
+
+int
+PararealAnalysis::propagate(Vector &state, double time, int numSteps, double dT)
+{
+  if (this->setState(state, time) < 0)
+    return -1;
+
+  for (int i = 0; i < numSteps; i++) {
+    int result = this->analyzeStep(dT);
+    if (result < 0)
+      return result;
+  }
+
+  return this->getState(state);
+}
+
+int
+PararealAnalysis::runFineWindows(int first, double dT)
+{
+  int J = windowStart.size() - 1;
+  std::vector<int> done(J, 0);
+
+#ifdef _PARAREAL_WORKERS
+  //
+  // Each worker is a forked copy of this process, with its own copy of
+  // the domain, that runs every numProcs'th of the pending windows and
+  // returns (window, status, end state) through a pipe. Windows not returned are run serially below.
+  //
+
+  int numPending = J - first;
+  int numProcs = (numWorkers < numPending) ? numWorkers : numPending;
+  if (numProcs >= 2) {
+    std::vector<int> readEnds;
+    std::vector<pid_t> pids;
+
+    opserr.flush();
+    fflush(stdout);
+    fflush(stderr);
+
+    for (int w = 0; w < numProcs; w++) {
+      int fd[2];
+      if (pipe(fd) != 0) break;
+
+      pid_t pid = fork();
+      if (pid == 0) {
+	close(fd[0]);
+	for (unsigned int k = 0; k < readEnds.size(); k++)
+	  close(readEnds[k]);
+
+	// results are written once all windows are done, so a worker never
+	// waits on the parent reading another worker's pipe
+	std::vector<double> records;
+	for (int j = first + w; j < J; j += numProcs) {
+	  Vector state(windowState[j]);
+	  int res = this->propagate(state, startTime + windowStart[j]*dT,
+				    windowStart[j+1] - windowStart[j], dT);
+	  records.push_back(j);
+	  records.push_back((res < 0) ? -1.0 : 1.0);
+	  if (res < 0)
+	    continue;
+	  for (int i = 0; i < stateSize; i++)
+	    records.push_back(state(i));
+	}
+	writePararealRecord(fd[1], &records[0], records.size() * sizeof(double));
+
+	close(fd[1]);
+	opserr.flush();
+	fflush(stdout);
+	_exit(0);
+      }
+
+      close(fd[1]);
+      if (pid < 0) {
+	close(fd[0]);
+	break;
+      }
+      readEnds.push_back(fd[0]);
+      pids.push_back(pid);
+    }
+
+    for (unsigned int w = 0; w < readEnds.size(); w++) {
+      double header[2];
+      while (readPararealRecord(readEnds[w], header, 2 * sizeof(double))) {
+	int j = (int)header[0];
+	if (j < first || j >= J)
+	  break;
+	if (header[1] < 0.0)
+	  continue;
+	if (!readPararealRecord(readEnds[w], &(fineState[j])(0), stateSize * sizeof(double)))
+	  break;
+	done[j] = 1;
+      }
+      close(readEnds[w]);
+      waitpid(pids[w], 0, 0);
+    }
+  }
+#endif
+
+  for (int j = first; j < J; j++) {
+    if (done[j] != 0)
+      continue;
+    fineState[j] = windowState[j];
+    int res = this->propagate(fineState[j], startTime + windowStart[j]*dT,
+			      windowStart[j+1] - windowStart[j], dT);
+    if (res < 0) {
+      opserr << "WARNING PararealAnalysis::analyze() - fine propagation of window " << j;
+      opserr << " failed\n";
+      return res;
+    }
+  }
+
+  return 0;
+}
+
+int
+PararealAnalysis::analyze(int numSteps, double dT, bool flush)
+{
+  int J = (numWindows > 0) ? numWindows : numWorkers;
+  if (J > numSteps)
+    J = numSteps;
+  if (J < 2)
+    return this->DirectIntegrationAnalysis::analyze(numSteps, dT, flush);
+
+  Domain *the_Domain = this->getDomainPtr();
+  if (this->checkDomainChange() < 0) {
+    opserr << "WARNING PararealAnalysis::analyze() - domainChanged() failed\n";
+    return -1;
+  }
+
+  stateSize = 0;
+  NodeIter &theNodes = the_Domain->getNodes();
+  Node *theNode;
+  while ((theNode = theNodes()) != 0)
+    stateSize += 3*theNode->getNumberDOF();
+  if (stateSize == 0)
+    return this->DirectIntegrationAnalysis::analyze(numSteps, dT, flush);
+
+  startTime = the_Domain->getCurrentTime();
+  windowStart.resize(J+1);
+  for (int j = 0; j <= J; j++)
+    windowStart[j] = (int)(((long long)j*numSteps)/J);
+
+  windowState.assign(J+1, Vector(stateSize));
+  fineState.assign(J, Vector(stateSize));
+  std::vector<Vector> coarseState(J, Vector(stateSize));
+  this->getState(windowState[0]);
+  Vector initialState(windowState[0]);
+
+  // trajectories of the propagators are not part of the result
+  the_Domain->setRecordOnCommit(false);
+
+  // initial coarse sweep
+  int result = 0;
+  for (int j = 0; j < J && result >= 0; j++) {
+    double T = (windowStart[j+1] - windowStart[j])*dT;
+    coarseState[j] = windowState[j];
+    result = this->propagate(coarseState[j], startTime + windowStart[j]*dT,
+			     coarseSteps, T/coarseSteps);
+    windowState[j+1] = coarseState[j];
+  }
+
+  // after k iterations the first k window start states are exact
+  int numExact = 1;
+  bool converged = false;
+  for (int k = 0; k < maxIter && result >= 0 && !converged; k++) {
+
+    result = this->runFineWindows(k, dT);
+    if (result < 0)
+      break;
+
+    // U_j+1 = G(U_j) + F(U_j_old) - G(U_j_old)
+    double change = 0.0;
+    double norm = 0.0;
+    for (int j = k; j < J && result >= 0; j++) {
+      Vector next(fineState[j]);
+      if (j > k) {
+	double T = (windowStart[j+1] - windowStart[j])*dT;
+	Vector coarse(windowState[j]);
+	result = this->propagate(coarse, startTime + windowStart[j]*dT,
+				 coarseSteps, T/coarseSteps);
+	next.addVector(1.0, coarse, 1.0);
+	next.addVector(1.0, coarseState[j], -1.0);
+	coarseState[j] = coarse;
+      }
+      for (int i = 0; i < stateSize; i++) {
+	double d = fabs(next(i) - windowState[j+1](i));
+	if (d > change) change = d;
+	if (fabs(next(i)) > norm) norm = fabs(next(i));
+      }
+      windowState[j+1] = next;
+    }
+    numExact = k + 2;
+
+    if (change <= tol*norm || numExact > J)
+      converged = true;
+  }
+
+  if (result >= 0 && !converged) {
+    opserr << "WARNING PararealAnalysis::analyze() - no convergence in " << maxIter;
+    opserr << " iterations, windows " << numExact << " to " << J << " are run serially\n";
+  }
+
+  if (result < 0) {
+    // back to where the analysis started
+    this->setState(initialState, startTime);
+    the_Domain->setRecordOnCommit(true);
+    opserr << "WARNING PararealAnalysis::analyze() - failed\n";
+    return result;
+  }
+
+  // the converged windows are integrated once more with the fine steps,
+  // each from its corrected start state, committing and recording every
+  // step; the windows that did not converge continue from the end of the
+  // previous one as in a serial analysis
+  int numConverged = converged ? J : numExact - 1;
+  for (int j = 0; j < J && result >= 0; j++) {
+    if (j < numConverged) {
+      the_Domain->setRecordOnCommit(false);
+      result = this->setState(windowState[j], startTime + windowStart[j]*dT);
+    }
+    the_Domain->setRecordOnCommit(true);
+    for (int i = windowStart[j]; i < windowStart[j+1] && result >= 0; i++)
+      result = this->analyzeStep(dT);
+  }
+  the_Domain->setRecordOnCommit(true);
+
+  if (result < 0) {
+    opserr << "WARNING PararealAnalysis::analyze() - failed in the fine steps\n";
+    return result;
+  }
+
+  if (flush)
+    the_Domain->flushRecorders();
+
+  return 0;
+}
@@ -0,0 +1,93 @@
+/* ****************************************************************** **
+**    OpenSees - Open System for Earthquake Engineering Simulation    **
+**          Pacific Earthquake Engineering Research Center            **
+**                                                                    **
+**                                                                    **
+** (C) Copyright 1999, The Regents of the University of California    **
+** All Rights Reserved.                                               **
+**                                                                    **
+** Commercial use of this program without express permission of the   **
+** University of California, Berkeley, is strictly prohibited.  See   **
+** file 'COPYRIGHT'  in main directory for information on usage and   **
+** redistribution,  and for a DISCLAIMER OF ALL WARRANTIES.           **
+**                                                                    **
+** Developed by:                                                      **
+**   Frank McKenna (fmckenna@ce.berkeley.edu)                         **
+**   Gregory L. Fenves (fenves@ce.berkeley.edu)                       **
+**   Filip C. Filippou (filippou@ce.berkeley.edu)                     **
+**                                                                    **
+** ****************************************************************** */
+
+#ifndef PararealAnalysis_h
+#define PararealAnalysis_h
+
+// Description: This file contains the class definition for
+// PararealAnalysis. PararealAnalysis is a subclass of
+// DirectIntegrationAnalysis that splits the time interval of analyze()
+// into windows and solves them with the Parareal iteration: a coarse
+// propagator (the same integrator with a few large steps) sweeps serially
+// across the windows, while the fine propagator (the given dT) runs the
+// windows concurrently in forked copies of the process. The iteration
+// corrects the window start states until they stop changing.
+//
+// The state passed between windows is the nodal displacement, velocity
+// and acceleration, so the method is meant for linear or weakly nonlinear
+// models and unconditionally stable integrators. Only the states at the
+// window ends are kept; once the iteration is done each window is run
+// once more with the fine steps from its corrected start state, so the
+// recorders see every step as in a serial analysis.
+
+#include <DirectIntegrationAnalysis.h>
+#include <Vector.h>
+#include <vector>
+
+class ConstraintHandler;
+class DOF_Numberer;
+class AnalysisModel;
+class TransientIntegrator;
+class LinearSOE;
+class EquiSolnAlgo;
+class ConvergenceTest;
+
+class PararealAnalysis: public DirectIntegrationAnalysis
+{
+  public:
+    PararealAnalysis(Domain &theDomain,
+		     ConstraintHandler &theHandler,
+		     DOF_Numberer &theNumberer,
+		     AnalysisModel &theModel,
+		     EquiSolnAlgo &theSolnAlgo,
+		     LinearSOE &theSOE,
+		     TransientIntegrator &theIntegrator,
+		     ConvergenceTest *theTest = 0,
+		     int numWorkers = 1,
+		     int numWindows = 0,
+		     int coarseSteps = 1,
+		     int maxIter = 10,
+		     double tol = 1.0e-6);
+    virtual ~PararealAnalysis();
+
+    int analyze(int numSteps, double dT, bool flush = true);
+
+  protected:
+    
+  private:
+    int getState(Vector &state);
+    int setState(const Vector &state, double time);
+    int propagate(Vector &state, double time, int numSteps, double dT);
+    int runFineWindows(int first, double dT);
+
+    int numWorkers;
+    int numWindows;
+    int coarseSteps;
+    int maxIter;
+    double tol;
+
+    int stateSize;
+    std::vector<Vector> windowState;   // corrected start states
+    std::vector<Vector> fineState;     // fine propagator at the window ends
+    std::vector<int> windowStart;      // first step of each window
+    double startTime;
+};
+
+#endif
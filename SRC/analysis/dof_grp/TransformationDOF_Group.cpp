@@ -832,6 +832,14 @@ TransformationDOF_Group::setEigenvector(int mode, const Vector &u)
 }
 
 
+bool
+TransformationDOF_Group::isTimeVarying(void) const
+{
+    if (theMP == 0)
+	return false;
+    return theMP->isTimeVarying();
+}
+
 Matrix *
 TransformationDOF_Group::getT(void)
 {
@@ -37,6 +37,7 @@
 // What: "@(#) TransformationFE.h, revA"
 
 #include <FE_Element.h>
+#include <vector>
 class SP_Constraint;
 class DOF_Group;
 class TransformationConstraintHandler;
@@ -79,6 +80,8 @@ class TransformationFE: public FE_Element
     int transformResponse(const Vector &modResponse, Vector &unmodResponse);
     
   private:
+    int formTransformation(void);
+    void transformTangent(const Matrix &theTangent);
     
     // private variables - a copy for each object of the class        
     DOF_Group **theDOFs;
@@ -90,17 +93,22 @@ class TransformationFE: public FE_Element
     int numGroups;
     int numTransformedDOF;
     int numOriginalDOF;
+
+    // T in compressed row form, one row per original dof holding the
+    // transformed dof & the weights; formed again only after setID() or
+    // each time if one of the MP_Constraints is time varying
+    std::vector<int> transRowStart;
+    std::vector<int> transCol;
+    std::vector<double> transVal;
+    bool transFormed;
+    bool transVarying;
     
     // static variables - single copy for all objects of the class	
     static Matrix **modMatrices; // array of pointers to class wide matrices
     static Vector **modVectors;  // array of pointers to class widde vectors
-    static Matrix **theTransformations; // for holding pointers to the T matrices
     static int numTransFE;     // number of objects    
     static int transCounter;   // a counter used to indicate when to do something
-    static int sizeTransformations; // size of theTransformations array
     static double *dataBuffer;
-    static double *localKbuffer;
-    static int    *dofData;
     static int sizeBuffer;
 };
 
@@ -129,7 +129,7 @@ EQPath::newStep(void)
 
     double dLambda = sign*arclen/uq0->Norm();
 
-    (*du)=dLambda*(*uq0);
+    du->addVector(0.0, *uq0, dLambda);
 
     du0=new Vector(du->Size());
     (*du0)=(*du);
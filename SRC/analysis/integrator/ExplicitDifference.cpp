@@ -10,13 +10,49 @@
 #include <Channel.h>
 #include <FEM_ObjectBroker.h>
 #include <elementAPI.h>
+#include <Element.h>
+#include <Node.h>
+#include <Domain.h>
+#include <ElementIter.h>
+#include <NodeIter.h>
+#include <Matrix.h>
+#include <ID.h>
+#include <math.h>
+#include <map>
+#include <algorithm>
+#include <typeinfo>
+#include <string.h>
 #define OPS_Export 
 
 
 void* OPS_ExplicitDifference(void)
 {
 	TransientIntegrator *theIntegrator = 0;
-	theIntegrator = new ExplicitDifference();
+
+	// integrator ExplicitDifference <-subcycle <$maxLevel>>
+	int maxLevel = 0;
+	while (OPS_GetNumRemainingInputArgs() > 0) {
+		const char *opt = OPS_GetString();
+		if (opt != 0 && strcmp(opt, "-subcycle") == 0) {
+			maxLevel = 4;
+			if (OPS_GetNumRemainingInputArgs() > 0) {
+				int numData = 1;
+				if (OPS_GetIntInput(&numData, &maxLevel) < 0) {
+					opserr << "WARNING integrator ExplicitDifference -subcycle - invalid maxLevel\n";
+					return 0;
+				}
+			}
+			if (maxLevel < 0 || maxLevel > 16) {
+				opserr << "WARNING integrator ExplicitDifference -subcycle - maxLevel must be in [0,16]\n";
+				return 0;
+			}
+		}
+	}
+
+	if (maxLevel > 0)
+		theIntegrator = new ExplicitDifference(0.0, 0.0, 0.0, 0.0, maxLevel);
+	else
+		theIntegrator = new ExplicitDifference();
 
 	if (theIntegrator == 0)
 		opserr << "WARNING - out of memory creating ExplicitDifference integrator\n";
@@ -31,20 +67,25 @@ ExplicitDifference::ExplicitDifference()
 	alphaM(0.0), betaK(0.0), betaKi(0.0), betaKc(0.0),
 	updateCount(0), c2(0.0), c3(0.0),
     Ut(0), Utdot(0), Utdotdot(0),
-	Udot(0), Utdotdot1(0), U(0), Utdot1(0)
+	Udot(0), Utdotdot1(0), U(0), Utdot1(0),
+	useDirectResidual(false),
+	maxSubcycleLevel(0), subLevel(0), subLevelDt(0.0), subLoadValid(false)
 {
 
 }
 
 
 ExplicitDifference::ExplicitDifference(
-	double _alphaM, double _betaK, double _betaKi, double _betaKc)
+	double _alphaM, double _betaK, double _betaKi, double _betaKc,
+	int _maxSubcycleLevel)
 	: TransientIntegrator(INTEGRATOR_TAGS_ExplicitDifference),
 	deltaT(0.0),
 	alphaM(_alphaM), betaK(_betaK), betaKi(_betaKi), betaKc(_betaKc),
 	updateCount(0), c2(0.0), c3(0.0),
 	Ut(0), Utdot(0), Utdotdot(0),
-	Udot(0), Utdotdot1(0), U(0), Utdot1(0)
+	Udot(0), Utdotdot1(0), U(0), Utdot1(0),
+	useDirectResidual(false),
+	maxSubcycleLevel(_maxSubcycleLevel), subLevel(0), subLevelDt(0.0), subLoadValid(false)
 {
 
 }
@@ -87,29 +128,59 @@ int ExplicitDifference::newStep(double _deltaT)
 	// get a pointer to the AnalysisModel
 	AnalysisModel *theModel = this->getAnalysisModel();
 
-	//calculate vel at t+0.5deltaT and U at t+delatT
-	Utdot->addVector(1.0, *Utdotdot, deltaT);
-	Ut->addVector(1.0, *Utdot, deltaT);
-
-	int size = Utdotdot->Size();
-
 	if (Ut == 0)  {
 		opserr << "ExplicitDifference::newStep() - domainChange() failed or hasn't been called\n";
 		return -2;
 	}
 
-	// for leap-frog method Ma=f-ku-cv, on the right side there is no Ma
-	(*Utdotdot) *= 0;
+	// subcycling needs the direct residual maps and a diagonal mass
+	subLevel = 0;
+	if (maxSubcycleLevel > 0 && useDirectResidual && theModel->getModalDampingFactors() == 0) {
+		if (deltaT != subLevelDt && this->assignSubcycleLevels(deltaT) < 0)
+			return -2;
+		subLevel = subEles.empty() ? 0 : (int)subEles.size() - 1;
+	}
+
+	double time = theModel->getCurrentDomainTime();
+	time += deltaT;
+
+	if (subLevel == 0) {
+		//calculate vel at t+0.5deltaT and U at t+delatT
+		Utdot->addVector(1.0, *Utdotdot, deltaT);
+		Ut->addVector(1.0, *Utdot, deltaT);
+
+		// for leap-frog method Ma=f-ku-cv, on the right side there is no Ma
+		(*Utdotdot) *= 0;
+	}
+	else {
+		// first substep of every equation with its own step deltaT/2^k
+		int size = Ut->Size();
+		for (int i = 0; i < size; i++) {
+			double h = subScale[i] * deltaT;
+			(*Utdot)(i) += h * (*Utdotdot)(i);
+			(*Ut)(i) += h * (*Utdot)(i);
+		}
+		(*Utdotdot) *= 0;
+		theModel->setAccel(*Utdotdot);
+
+		// the loads at t+deltaT are applied once for the step; inside the
+		// step the subcycled equations interpolate them from those at t
+		theModel->applyLoadDomain(time);
+		if (this->subcycle() < 0) {
+			opserr << "ExplicitDifference::newStep() - subcycling failed\n";
+			return -3;
+		}
+	}
 
 	// set the garbage response quantities for the nodes
 	theModel->setVel(*Utdot);
 	theModel->setAccel(*Utdotdot);
 	theModel->setDisp(*Ut);
 
-	// increment the time to t and apply the load
-	double time = theModel->getCurrentDomainTime();
-	time += deltaT;
-	if (theModel->updateDomain(time, deltaT) < 0)  {
+	// increment the time to t and apply the load, unless the subcycling
+	// has applied it already
+	int res = (subLevel == 0) ? theModel->updateDomain(time, deltaT) : theModel->updateDomain();
+	if (res < 0)  {
 		opserr << "ExplicitDifference::newStep() - failed to update the domain\n";
 		return -3;
 	}
@@ -262,12 +333,521 @@ int ExplicitDifference::domainChanged()
 		}
 	}
 
+	this->setupDirectResidual();
+	if (maxSubcycleLevel > 0)
+		this->setupSubcycling();
+
 	opserr << "WARNING: ExplicitDifference::domainChanged() - assuming Ut-1 = Ut\n";
 
 	return 0;
 }
 
 
+// adds the Gershgorin row sums sum_j |K_ij| and the lumped (row sum)
+// mass of one element to the rows given by dofs; negative dofs are skipped
+static void
+addStableRateRows(const Matrix &K, const Matrix &M, const int *dofs, int n,
+	double *rowSum, double *mass)
+{
+	for (int i = 0; i < n; i++) {
+		if (dofs[i] < 0)
+			continue;
+		double sum = 0.0;
+		for (int j = 0; j < n; j++)
+			sum += fabs(K(i, j));
+		rowSum[dofs[i]] += sum;
+		if (M.noRows() == n) {
+			sum = 0.0;
+			for (int j = 0; j < n; j++)
+				sum += M(i, j);
+			mass[dofs[i]] += sum;
+		}
+	}
+}
+
+
+int ExplicitDifference::setupDirectResidual(void)
+{
+	useDirectResidual = false;
+	directEles.clear();
+	directEleStart.assign(1, 0);
+	directEleLoc.clear();
+	directNodes.clear();
+	directNodeStart.assign(1, 0);
+	directNodeLoc.clear();
+
+	AnalysisModel *theModel = this->getAnalysisModel();
+	LinearSOE *theLinSOE = this->getLinearSOE();
+	Domain *theDomain = theModel->getDomainPtr();
+	if (theLinSOE == 0 || theDomain == 0)
+		return -1;
+
+	// only plain FE_Elements/DOF_Groups are equivalent to R = P - F(u);
+	// the transformation, Lagrange and penalty handlers keep the generic path
+	FE_EleIter &theEles = theModel->getFEs();
+	FE_Element *elePtr;
+	while ((elePtr = theEles()) != 0) {
+		Element *theEle = elePtr->getElement();
+		if (typeid(*elePtr) != typeid(FE_Element) || theEle == 0 || theEle->isSubdomain())
+			return 0;
+		const ID &id = elePtr->getID();
+		directEles.push_back(theEle);
+		for (int i = 0; i < id.Size(); i++)
+			directEleLoc.push_back(id(i));
+		directEleStart.push_back(directEleLoc.size());
+	}
+
+	DOF_GrpIter &theDOFs = theModel->getDOFs();
+	DOF_Group *dofPtr;
+	while ((dofPtr = theDOFs()) != 0) {
+		if (typeid(*dofPtr) != typeid(DOF_Group))
+			return 0;
+		Node *theNode = theDomain->getNode(dofPtr->getNodeTag());
+		if (theNode == 0)
+			return 0;
+		const ID &id = dofPtr->getID();
+		directNodes.push_back(theNode);
+		for (int i = 0; i < id.Size(); i++)
+			directNodeLoc.push_back(id(i));
+		directNodeStart.push_back(directNodeLoc.size());
+	}
+
+	theB.resize(theLinSOE->getNumEqn());
+	useDirectResidual = true;
+	return 0;
+}
+
+int ExplicitDifference::formUnbalance(void)
+{
+	LinearSOE *theLinSOE = this->getLinearSOE();
+	AnalysisModel *theModel = this->getAnalysisModel();
+
+	if (!useDirectResidual || theModel == 0 || theLinSOE == 0 ||
+		theModel->getModalDampingFactors() != 0 || theB.Size() != theLinSOE->getNumEqn())
+		return this->TransientIntegrator::formUnbalance();
+
+	// same sums as zeroB + addB(-R_e) + addB(P_n), in the same order
+	int size = theB.Size();
+	double *B = &theB(0);
+	for (int i = 0; i < size; i++)
+		B[i] = 0.0;
+
+	int numEle = directEles.size();
+	for (int e = 0; e < numEle; e++) {
+		Element *theEle = directEles[e];
+		if (!theEle->isActive())
+			continue;
+		const Vector &R = theEle->getResistingForceIncInertia();
+		const int *loc = &directEleLoc[directEleStart[e]];
+		int n = directEleStart[e + 1] - directEleStart[e];
+		for (int i = 0; i < n; i++) {
+			int pos = loc[i];
+			if (pos >= 0 && pos < size)
+				B[pos] -= R(i);
+		}
+	}
+
+	// the DOF_Groups own disjoint equations and the nodal inertia forces
+	// only touch node-local storage, so this loop can run in parallel;
+	// elements are evaluated serially as most use class-wide work arrays
+	int numNodes = directNodes.size();
+#pragma omp parallel for
+	for (int j = 0; j < numNodes; j++) {
+		const Vector &P = directNodes[j]->getUnbalancedLoadIncInertia();
+		const int *loc = &directNodeLoc[directNodeStart[j]];
+		int n = directNodeStart[j + 1] - directNodeStart[j];
+		for (int i = 0; i < n; i++) {
+			int pos = loc[i];
+			if (pos >= 0 && pos < size)
+				B[pos] += P(i);
+		}
+	}
+
+	if (theLinSOE->setB(theB) < 0) {
+		opserr << "WARNING ExplicitDifference::formUnbalance() - setB failed\n";
+		return -1;
+	}
+
+	return 0;
+}
+
+int ExplicitDifference::setupSubcycling(void)
+{
+	eqLevel.clear();
+	subEles.clear();
+	subNodes.clear();
+	subTargets.clear();
+	subLevelDt = 0.0;
+	subLoadValid = false;
+
+	if (!useDirectResidual) {
+		opserr << "WARNING ExplicitDifference::domainChanged() - subcycling needs the Plain constraint";
+		opserr << " handler, stepping all elements with the analysis time step\n";
+		return 0;
+	}
+
+	int size = Ut->Size();
+	subOmega2.assign(size, 0.0);
+	subMass.assign(size, 0.0);
+	subScale.assign(size, 1.0);
+	subB.resize(size);
+	subP.resize(size);
+	subDP.resize(size);
+
+	std::map<int, int> nodeIndex;
+	size_t maxDOF = 1;
+	int numNodes = directNodes.size();
+	for (int j = 0; j < numNodes; j++) {
+		nodeIndex[directNodes[j]->getTag()] = j;
+		int n = directNodeStart[j + 1] - directNodeStart[j];
+		if ((size_t)n > maxDOF)
+			maxDOF = n;
+		const Matrix &M = directNodes[j]->getMass();
+		for (int i = 0; i < n && i < M.noRows(); i++) {
+			int loc = directNodeLoc[directNodeStart[j] + i];
+			if (loc >= 0 && loc < size)
+				subMass[loc] += M(i, i);
+		}
+	}
+	subWork.assign(maxDOF, 0.0);
+
+	std::vector<double> rowSum(size, 0.0);
+	eleNodeStart.assign(1, 0);
+	eleNodes.clear();
+	int numEle = directEles.size();
+	for (int e = 0; e < numEle; e++) {
+		Element *theEle = directEles[e];
+		const ID &nodes = theEle->getExternalNodes();
+		for (int a = 0; a < nodes.Size(); a++) {
+			std::map<int, int>::iterator it = nodeIndex.find(nodes(a));
+			if (it != nodeIndex.end())
+				eleNodes.push_back(it->second);
+		}
+		eleNodeStart.push_back(eleNodes.size());
+
+		if (!theEle->isActive())
+			continue;
+		const Matrix &K = theEle->getInitialStiff();
+		int n = directEleStart[e + 1] - directEleStart[e];
+		if (K.noRows() != n) {
+			opserr << "WARNING ExplicitDifference::domainChanged() - subcycling disabled, element ";
+			opserr << theEle->getTag() << " stiffness does not match its dofs\n";
+			return -1;
+		}
+		addStableRateRows(K, theEle->getMass(), &directEleLoc[directEleStart[e]], n,
+			&rowSum[0], &subMass[0]);
+	}
+
+	for (int i = 0; i < size; i++)
+		if (subMass[i] > 0.0)
+			subOmega2[i] = rowSum[i] / subMass[i];
+
+	eqLevel.assign(size, 0);
+	return 0;
+}
+
+
+int ExplicitDifference::assignSubcycleLevels(double dT)
+{
+	subLevelDt = dT;
+	subLoadValid = false;
+	subEles.clear();
+	subNodes.clear();
+	subTargets.clear();
+
+	int size = Ut->Size();
+	subScale.assign(size, 1.0);
+	if ((int)eqLevel.size() != size)
+		return 0;
+
+	// smallest k with dT/2^k below the stable step of the equation
+	std::vector<int> rate(size, 0);
+	int numUnstable = 0;
+	for (int i = 0; i < size; i++) {
+		if (subMass[i] <= 0.0 || subOmega2[i] <= 0.0)
+			continue;
+		double dtCrit = 2.0 / sqrt(subOmega2[i]);
+		double h = dT;
+		int k = 0;
+		while (h > dtCrit && k < maxSubcycleLevel) {
+			h *= 0.5;
+			k++;
+		}
+		if (h > dtCrit)
+			numUnstable++;
+		rate[i] = k;
+	}
+
+	// every node of an element steps at least at the rate of the element;
+	// massless equations are only interpolated
+	int numEle = directEles.size();
+	eqLevel.assign(size, 0);
+	for (int e = 0; e < numEle; e++) {
+		int k = 0;
+		for (int i = directEleStart[e]; i < directEleStart[e + 1]; i++) {
+			int loc = directEleLoc[i];
+			if (loc >= 0 && loc < size && rate[loc] > k)
+				k = rate[loc];
+		}
+		for (int i = directEleStart[e]; i < directEleStart[e + 1]; i++) {
+			int loc = directEleLoc[i];
+			if (loc >= 0 && loc < size && subMass[loc] > 0.0 && eqLevel[loc] < k)
+				eqLevel[loc] = k;
+		}
+	}
+
+	int maxLevel = 0;
+	for (int i = 0; i < size; i++) {
+		if (eqLevel[i] > maxLevel)
+			maxLevel = eqLevel[i];
+		subScale[i] = ldexp(1.0, -eqLevel[i]);
+	}
+
+	if (numUnstable > 0) {
+		opserr << "WARNING ExplicitDifference::newStep() - " << numUnstable;
+		opserr << " equations are above the stable time step at subcycle level " << maxSubcycleLevel << endln;
+	}
+
+	if (maxLevel == 0)
+		return 0;
+
+	subEles.resize(maxLevel + 1);
+	subNodes.resize(maxLevel + 1);
+	subTargets.resize(maxLevel + 1);
+
+	// an element is evaluated at the rate of its fastest node
+	for (int e = 0; e < numEle; e++) {
+		if (!directEles[e]->isActive())
+			continue;
+		int k = 0;
+		for (int i = directEleStart[e]; i < directEleStart[e + 1]; i++) {
+			int loc = directEleLoc[i];
+			if (loc >= 0 && loc < size && eqLevel[loc] > k)
+				k = eqLevel[loc];
+		}
+		if (k == 0)
+			continue;
+		subEles[k].push_back(e);
+		for (int a = eleNodeStart[e]; a < eleNodeStart[e + 1]; a++)
+			subNodes[k].push_back(eleNodes[a]);
+	}
+	for (int k = 1; k <= maxLevel; k++) {
+		std::sort(subNodes[k].begin(), subNodes[k].end());
+		subNodes[k].erase(std::unique(subNodes[k].begin(), subNodes[k].end()), subNodes[k].end());
+	}
+
+	int numNodes = directNodes.size();
+	for (int j = 0; j < numNodes; j++) {
+		int k = 0;
+		for (int i = directNodeStart[j]; i < directNodeStart[j + 1]; i++) {
+			int loc = directNodeLoc[i];
+			if (loc >= 0 && loc < size && eqLevel[loc] > k)
+				k = eqLevel[loc];
+		}
+		if (k > 0)
+			subTargets[k].push_back(j);
+	}
+
+	return 0;
+}
+
+
+int ExplicitDifference::subcycle(void)
+{
+	// On entry every equation of level k holds u at t+deltaT/2^k and the
+	// half step velocity; the finest level is walked in nSub substeps and
+	// at substep s the levels k >= L - ctz(s) are due. Positions of the
+	// nodes that are not due are interpolated with their velocity.
+	// The due elements are committed at the end of each of their substeps,
+	// so their materials follow the path through the step.
+	int L = subLevel;
+	int nSub = 1 << L;
+	double h = deltaT / nSub;
+	int size = Ut->Size();
+	double *u = &(*Ut)(0);
+	double *v = &(*Utdot)(0);
+	double *B = &subB(0);
+	double *P = &subP(0);
+	double *dP = &subDP(0);
+
+	// load increment over the step for the subcycled equations
+	for (int k = 1; k <= L; k++) {
+		for (size_t t = 0; t < subTargets[k].size(); t++) {
+			int j = subTargets[k][t];
+			const Vector &load = directNodes[j]->getUnbalancedLoad();
+			for (int i = directNodeStart[j]; i < directNodeStart[j + 1]; i++) {
+				int loc = directNodeLoc[i];
+				if (loc < 0 || loc >= size || eqLevel[loc] == 0)
+					continue;
+				double p = load(i - directNodeStart[j]);
+				dP[loc] = subLoadValid ? p - P[loc] : 0.0;
+				P[loc] = p;
+			}
+		}
+	}
+	subLoadValid = true;
+
+	for (int s = 1; s < nSub; s++) {
+		int tz = 0;
+		while (((s >> tz) & 1) == 0)
+			tz++;
+		int kMin = L - tz;
+
+		// trial state of the nodes of the due elements at t+s*h
+		for (int k = kMin; k <= L; k++) {
+			for (size_t t = 0; t < subNodes[k].size(); t++) {
+				int j = subNodes[k][t];
+				Node *theNode = directNodes[j];
+				int n = directNodeStart[j + 1] - directNodeStart[j];
+				const int *loc = &directNodeLoc[directNodeStart[j]];
+				Vector vel(&subWork[0], n);
+				vel = theNode->getTrialVel();
+				for (int i = 0; i < n; i++) {
+					if (loc[i] < 0 || loc[i] >= size)
+						continue;
+					int p = 1 << (L - eqLevel[loc[i]]);
+					int next = ((s + p - 1) / p) * p;
+					theNode->setTrialDisp(u[loc[i]] - (next - s) * h * v[loc[i]], i);
+					vel(i) = v[loc[i]];
+					B[loc[i]] = 0.0;
+				}
+				theNode->setTrialVel(vel);
+			}
+		}
+
+		for (int k = kMin; k <= L; k++) {
+			for (size_t t = 0; t < subEles[k].size(); t++) {
+				int e = subEles[k][t];
+				Element *theEle = directEles[e];
+				if (theEle->update() < 0) {
+					opserr << "WARNING ExplicitDifference::subcycle() - element " << theEle->getTag();
+					opserr << " failed in update\n";
+					return -1;
+				}
+				const Vector &R = theEle->getResistingForceIncInertia();
+				const int *loc = &directEleLoc[directEleStart[e]];
+				int n = directEleStart[e + 1] - directEleStart[e];
+				for (int i = 0; i < n; i++)
+					if (loc[i] >= 0 && loc[i] < size)
+						B[loc[i]] -= R(i);
+
+				// the next substep of the element starts from this state
+				if (theEle->commitState() < 0) {
+					opserr << "WARNING ExplicitDifference::subcycle() - element " << theEle->getTag();
+					opserr << " failed in commitState\n";
+					return -1;
+				}
+			}
+		}
+
+		// advance the due equations by their own step
+		double theta = (double)s / nSub;
+		for (int k = kMin; k <= L; k++) {
+			double hk = ldexp(deltaT, -k);
+			for (size_t t = 0; t < subTargets[k].size(); t++) {
+				int j = subTargets[k][t];
+				const Vector &load = directNodes[j]->getUnbalancedLoadIncInertia();
+				const int *loc = &directNodeLoc[directNodeStart[j]];
+				int n = directNodeStart[j + 1] - directNodeStart[j];
+				for (int i = 0; i < n; i++) {
+					int pos = loc[i];
+					if (pos < 0 || pos >= size || eqLevel[pos] != k)
+						continue;
+					double a = (B[pos] + load(i) - (1.0 - theta) * dP[pos]) / subMass[pos];
+					v[pos] += hk * a;
+					u[pos] += hk * v[pos];
+				}
+			}
+		}
+	}
+
+	return 0;
+}
+
+
+double ExplicitDifference::getCriticalTimeStep(Domain *theDomain, const ID *eleTags, Vector *eleDt)
+{
+	// With a lumped (diagonal) mass M, omega_max^2 is bounded by the largest
+	// Gershgorin row bound of M^-1 K, i.e. max_i sum_j |K_ij| / m_i. The
+	// assembled row sums are bounded by the sums of the element row sums.
+	if (theDomain == 0)
+		return 0.0;
+
+	std::map<int, int> nodeStart;
+	int numDOF = 0;
+	NodeIter &theNodes = theDomain->getNodes();
+	Node *theNode;
+	while ((theNode = theNodes()) != 0) {
+		nodeStart[theNode->getTag()] = numDOF;
+		numDOF += theNode->getNumberDOF();
+	}
+	std::vector<double> rowSum(numDOF, 0.0), mass(numDOF, 0.0);
+
+	theNodes = theDomain->getNodes();
+	while ((theNode = theNodes()) != 0) {
+		const Matrix &M = theNode->getMass();
+		int start = nodeStart[theNode->getTag()];
+		int n = theNode->getNumberDOF();
+		for (int i = 0; i < n && i < M.noRows(); i++)
+			mass[start + i] += M(i, i);
+	}
+
+	// equation positions of the element dofs, element by element
+	std::map<int, std::vector<int> > eleDofs;
+	ElementIter &theEles = theDomain->getElements();
+	Element *theEle;
+	while ((theEle = theEles()) != 0) {
+		if (theEle->isSubdomain() || !theEle->isActive())
+			continue;
+		const ID &nodes = theEle->getExternalNodes();
+		std::vector<int> &dofs = eleDofs[theEle->getTag()];
+		for (int a = 0; a < nodes.Size(); a++) {
+			Node *aNode = theDomain->getNode(nodes(a));
+			if (aNode == 0)
+				continue;
+			int start = nodeStart[nodes(a)];
+			for (int i = 0; i < aNode->getNumberDOF(); i++)
+				dofs.push_back(start + i);
+		}
+
+		const Matrix &K = theEle->getInitialStiff();
+		if (K.noRows() != (int)dofs.size()) {
+			opserr << "WARNING ExplicitDifference::getCriticalTimeStep() - element " << theEle->getTag();
+			opserr << " skipped, matrix size does not match its nodal dofs\n";
+			dofs.clear();
+			continue;
+		}
+		if (!dofs.empty())
+			addStableRateRows(K, theEle->getMass(), &dofs[0], dofs.size(), &rowSum[0], &mass[0]);
+	}
+
+	// dofs without mass carry no inertia and are skipped
+	std::vector<double> omega2(numDOF, 0.0);
+	double omega2Max = 0.0;
+	for (int i = 0; i < numDOF; i++) {
+		if (mass[i] > 0.0)
+			omega2[i] = rowSum[i] / mass[i];
+		if (omega2[i] > omega2Max)
+			omega2Max = omega2[i];
+	}
+
+	if (eleTags != 0 && eleDt != 0) {
+		eleDt->resize(eleTags->Size());
+		for (int e = 0; e < eleTags->Size(); e++) {
+			double w2 = 0.0;
+			std::map<int, std::vector<int> >::iterator it = eleDofs.find((*eleTags)(e));
+			if (it != eleDofs.end()) {
+				for (size_t i = 0; i < it->second.size(); i++)
+					if (omega2[it->second[i]] > w2)
+						w2 = omega2[it->second[i]];
+			}
+			(*eleDt)(e) = w2 > 0.0 ? 2.0 / sqrt(w2) : 0.0;
+		}
+	}
+
+	return omega2Max > 0.0 ? 2.0 / sqrt(omega2Max) : 0.0;
+}
+
 int ExplicitDifference::update(const Vector &Udotdot)
 {
 	updateCount++;
@@ -310,6 +890,13 @@ int ExplicitDifference::update(const Vector &Udotdot)
 	Utdot1->addVector(1.0, *Utdotdot1, halfT);
 
 
+	// the subcycled equations hold the velocity half of their own step back
+	if (subLevel > 0) {
+		for (int i = 0; i < size; i++)
+			if (subScale[i] < 1.0)
+				(*Utdot1)(i) = (*Utdot)(i) + halfT * subScale[i] * (*Utdotdot1)(i);
+	}
+
 	theModel->setResponse(*Ut, *Utdot1, Udotdot);
 
 	if (theModel->updateDomain() < 0)  {
@@ -345,11 +932,12 @@ int ExplicitDifference::commit(void)
 
 int ExplicitDifference::sendSelf(int cTag, Channel &theChannel)
 {
-	Vector data(4);
+	Vector data(5);
 	data(0) = alphaM;
 	data(1) = betaK;
 	data(2) = betaKi;
 	data(3) = betaKc;
+	data(4) = maxSubcycleLevel;
 
 	if (theChannel.sendVector(this->getDbTag(), cTag, data) < 0)  {
 		opserr << "WARNING ExplicitDifference::sendSelf() - could not send data\n";
@@ -362,7 +950,7 @@ int ExplicitDifference::sendSelf(int cTag, Channel &theChannel)
 
 int ExplicitDifference::recvSelf(int cTag, Channel &theChannel, FEM_ObjectBroker &theBroker)
 {
-	Vector data(4);
+	Vector data(5);
 	if (theChannel.recvVector(this->getDbTag(), cTag, data) < 0)  {
 		opserr << "WARNING ExplicitDifference::recvSelf() - could not receive data\n";
 		return -1;
@@ -372,6 +960,7 @@ int ExplicitDifference::recvSelf(int cTag, Channel &theChannel, FEM_ObjectBroker
 	betaK = data(1);
 	betaKi = data(2);
 	betaKc = data(3);
+	maxSubcycleLevel = (int)data(4);
 
 	return 0;
 }
@@ -385,6 +974,8 @@ void ExplicitDifference::Print(OPS_Stream &s, int flag)
 		s << "ExplicitDifference - currentTime: " << currentTime << endln;
 		s << "  Rayleigh Damping - alphaM: " << alphaM << "  betaK: " << betaK;
 		s << "  betaKi: " << betaKi << "  betaKc: " << betaKc << endln;
+		if (maxSubcycleLevel > 0)
+			s << "  Subcycling - maxLevel: " << maxSubcycleLevel << "  levels in use: " << subLevel << endln;
 	}
 	else
 		s << "ExplicitDifference - no associated AnalysisModel\n";
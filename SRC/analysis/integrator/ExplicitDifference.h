@@ -4,16 +4,21 @@
 
 
 #include<TransientIntegrator.h>
+#include <Vector.h>
+#include <vector>
 
 class DOF_Group;
 class FE_Element;
-class Vector;
+class Element;
+class Node;
+class Domain;
 
 class ExplicitDifference : public TransientIntegrator
 {
 public:
 	ExplicitDifference();
-	ExplicitDifference(double alphaM, double betaK, double betaKi, double betaKc);
+	ExplicitDifference(double alphaM, double betaK, double betaKi, double betaKc,
+		int maxSubcycleLevel = 0);
 	~ExplicitDifference();                                                                //constructors and unconstructor
 
 	                                                 
@@ -25,6 +30,7 @@ public:
 	const Vector & getVel(void);    //added for Modal damping
 
 	int domainChanged(void);
+	int formUnbalance(void);
 	int newStep(double deltaT);
 	int update(const Vector &U);
 
@@ -35,6 +41,11 @@ public:
 
 	void Print(OPS_Stream &s, int flag = 0);
 
+	// stable time step 2/omega_max estimated from the initial stiffness and
+	// lumped mass; if eleTags is given, the estimate restricted to the dofs
+	// of each of those elements is returned in eleDt
+	static double getCriticalTimeStep(Domain *theDomain, const ID *eleTags = 0, Vector *eleDt = 0);
+
 
 protected:
 private:
@@ -51,6 +62,35 @@ private:
 	Vector  *Utdotdot, *Utdotdot1;
 	Vector *Udot, *Utdot, *Utdot1;
 
+	// Direct residual assembly used when the model consists of plain
+	// FE_Elements and DOF_Groups: the element and nodal forces are
+	// scattered into theB through flat equation maps and handed to the
+	// SOE with one setB(), bypassing the per-element residual copies
+	int setupDirectResidual(void);
+	bool useDirectResidual;
+	std::vector<Element *> directEles;
+	std::vector<int> directEleStart, directEleLoc;
+	std::vector<Node *> directNodes;
+	std::vector<int> directNodeStart, directNodeLoc;
+	Vector theB;
+
+	// Element subcycling: equations are binned by their stable time step
+	// into levels k = 0..maxSubcycleLevel and advanced with deltaT/2^k;
+	// the elements of level k are only evaluated at that rate and the
+	// slower nodes they touch are interpolated inside the step
+	int setupSubcycling(void);
+	int assignSubcycleLevels(double dT);
+	int subcycle(void);
+	int maxSubcycleLevel;
+	int subLevel;
+	double subLevelDt;
+	bool subLoadValid;
+	std::vector<double> subOmega2, subMass, subScale;
+	std::vector<int> eqLevel, eleNodeStart, eleNodes;
+	std::vector<std::vector<int> > subEles, subNodes, subTargets;
+	std::vector<double> subWork;
+	Vector subB, subP, subDP;
+
 };
 
 #endif
@@ -36,6 +36,7 @@
 #include <LinearSOE.h>
 #include <AnalysisModel.h>
 #include <Vector.h>
+#include <math.h>
 #include <DOF_Group.h>
 #include <DOF_GrpIter.h>
 #include <Channel.h>
@@ -181,12 +182,10 @@ int GeneralizedAlpha::newStep(double _deltaT)
     Udotdot->addVector(a4, *Utdot, a3);
 
     // determine the velocities at t+alphaF*deltaT
-    (*Ualphadot) = *Utdot;
-    Ualphadot->addVector((1.0-alphaF), *Udot, alphaF);
+    Ualphadot->addVector(0.0, *Utdot, 1.0-alphaF, *Udot, alphaF);
 
     // determine the velocities at t+alphaM*deltaT
-    (*Ualphadotdot) = *Utdotdot;
-    Ualphadotdot->addVector((1.0-alphaM), *Udotdot, alphaM);
+    Ualphadotdot->addVector(0.0, *Utdotdot, 1.0-alphaM, *Udotdot, alphaM);
     
     // set the trial response quantities
     theModel->setVel(*Ualphadot);
@@ -390,15 +389,12 @@ int GeneralizedAlpha::update(const Vector &deltaU)
     Udotdot->addVector(1.0, deltaU, c3);
 
     // determine displacement and velocity at t+alphaF*deltaT
-    (*Ualpha) = *Ut;
-    Ualpha->addVector((1.0-alphaF), *U, alphaF);
+    Ualpha->addVector(0.0, *Ut, 1.0-alphaF, *U, alphaF);
 
-    (*Ualphadot) = *Utdot;
-    Ualphadot->addVector((1.0-alphaF), *Udot, alphaF);
+    Ualphadot->addVector(0.0, *Utdot, 1.0-alphaF, *Udot, alphaF);
 
     // determine the velocities at t+alphaM*deltaT
-    (*Ualphadotdot) = *Utdotdot;
-    Ualphadotdot->addVector((1.0-alphaM), *Udotdot, alphaM);
+    Ualphadotdot->addVector(0.0, *Utdotdot, 1.0-alphaM, *Udotdot, alphaM);
 
     
     // update the response at the DOFs
@@ -441,6 +437,18 @@ GeneralizedAlpha::getVel()
   return *Udot;
 }
 
+
+int
+GeneralizedAlpha::getLocalErrorEstimate(double deltaT, double &errNorm, double &dispNorm)
+{
+  if (U == 0 || Udotdot == 0 || Utdotdot == 0)
+    return -1;
+
+  // the accelerations are those at t + (alphaF-alphaM)*dt
+  return this->newmarkErrorEstimate(beta, alphaF - alphaM, deltaT, *U, *Udotdot, *Utdotdot,
+				    errNorm, dispNorm);
+}
+
 int GeneralizedAlpha::sendSelf(int cTag, Channel &theChannel)
 {
     Vector data(4);
@@ -34,6 +34,7 @@
 #include <LinearSOE.h>
 #include <AnalysisModel.h>
 #include <Vector.h>
+#include <math.h>
 #include <DOF_Group.h>
 #include <DOF_GrpIter.h>
 #include <AnalysisModel.h>
@@ -174,8 +175,7 @@ int HHT::newStep(double _deltaT)
     Udotdot->addVector(a4, *Utdot, a3);
     
     // determine the velocities at t+alpha*deltaT
-    (*Ualphadot) = *Utdot;
-    Ualphadot->addVector((1.0-alpha), *Udot, alpha);
+    Ualphadot->addVector(0.0, *Utdot, 1.0-alpha, *Udot, alpha);
     
     // set the trial response quantities
     theModel->setVel(*Ualphadot);
@@ -384,11 +384,9 @@ int HHT::update(const Vector &deltaU)
     Udotdot->addVector(1.0, deltaU, c3);
     
     // determine displacement and velocity at t+alpha*deltaT
-    (*Ualpha) = *Ut;
-    Ualpha->addVector((1.0-alpha), *U, alpha);
+    Ualpha->addVector(0.0, *Ut, 1.0-alpha, *U, alpha);
     
-    (*Ualphadot) = *Utdot;
-    Ualphadot->addVector((1.0-alpha), *Udot, alpha);
+    Ualphadot->addVector(0.0, *Utdot, 1.0-alpha, *Udot, alpha);
     
     // update the response at the DOFs
     theModel->setResponse(*Ualpha,*Ualphadot,*Udotdot);
@@ -430,6 +428,18 @@ HHT::getVel()
   return *Udot;
 }
 
+
+int
+HHT::getLocalErrorEstimate(double deltaT, double &errNorm, double &dispNorm)
+{
+  if (U == 0 || Udotdot == 0 || Utdotdot == 0)
+    return -1;
+
+  // the accelerations lag the exact ones by (1-alpha)*dt
+  return this->newmarkErrorEstimate(beta, alpha - 1.0, deltaT, *U, *Udotdot, *Utdotdot,
+				    errNorm, dispNorm);
+}
+
 int HHT::sendSelf(int cTag, Channel &theChannel)
 {
     Vector data(3);
@@ -62,6 +62,7 @@ public:
     int commit(void);
 
     const Vector &getVel(void);
+    int getLocalErrorEstimate(double deltaT, double &errNorm, double &dispNorm);
     
     virtual int sendSelf(int commitTag, Channel &theChannel);
     virtual int recvSelf(int commitTag, Channel &theChannel, FEM_ObjectBroker &theBroker);
@@ -447,15 +447,19 @@ int HHTHSFixedNumIter::update(const Vector &deltaU)
     // get interpolation location and scale displacement increment 
     x = (double) theTest->getNumTests()/theTest->getMaxNumTests();
     if (polyOrder == 1)  {
-        (*scaledDeltaU) = x*((*U)+deltaU) - (x-1.0)*(*Ut)  - (*U);
+        scaledDeltaU->addVector(0.0, *U, x-1.0, deltaU, x);
+        scaledDeltaU->addVector(1.0, *Ut, -(x-1.0));
     }
     else if (polyOrder == 2)  {
-        (*scaledDeltaU) = x*(x+1.0)/2.0*((*U)+deltaU) - (x-1.0)*(x+1.0)*(*Ut) 
-                        + (x-1.0)*x/2.0*(*Utm1) - (*U);
+        double a = x*(x+1.0)/2.0;
+        scaledDeltaU->addVector(0.0, *U, a-1.0, deltaU, a);
+        scaledDeltaU->addVector(1.0, *Ut, -(x-1.0)*(x+1.0), *Utm1, (x-1.0)*x/2.0);
     }
     else if (polyOrder == 3)  {
-        (*scaledDeltaU) = x*(x+1.0)*(x+2.0)/6.0*((*U)+deltaU) - (x-1.0)*(x+1.0)*(x+2.0)/2.0*(*Ut)
-                        + (x-1.0)*x*(x+2.0)/2.0*(*Utm1) - (x-1.0)*x*(x+1.0)/6.0*(*Utm2) - (*U);
+        double a = x*(x+1.0)*(x+2.0)/6.0;
+        scaledDeltaU->addVector(0.0, *U, a-1.0, deltaU, a);
+        scaledDeltaU->addVector(1.0, *Ut, -(x-1.0)*(x+1.0)*(x+2.0)/2.0, *Utm1, (x-1.0)*x*(x+2.0)/2.0);
+        scaledDeltaU->addVector(1.0, *Utm2, -(x-1.0)*x*(x+1.0)/6.0);
     }
     else  {
         opserr << "WARNING HHTHSFixedNumIter::update() - polyOrder > 3 not supported\n";
@@ -376,6 +376,10 @@ int
 HarmonicSteadyState::computeSensitivities(void)
 {
 //  opserr<<" computeSensitivity::start"<<endln;
+    // parameters solved together against the factored tangent
+    if (this->getSensitivityBlockSize() > 1)
+      return this->computeBlockSensitivities();
+
     LinearSOE *theSOE = this->getLinearSOE();
 
     /*
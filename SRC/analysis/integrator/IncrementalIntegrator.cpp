@@ -39,14 +39,22 @@
 #include <FE_EleIter.h>
 #include <DOF_GrpIter.h>
 #include <EigenSOE.h>
+#include <Matrix.h>
+#include <Domain.h>
+#include <Parameter.h>
+#include <ParameterIter.h>
+#include <ID.h>
 #include <cmath>
+#include <vector>
 
 IncrementalIntegrator::IncrementalIntegrator(int clasTag)
 :Integrator(clasTag),
  statusFlag(CURRENT_TANGENT), theEigenSOE(0), 
  eigenVectors(0), eigenValues(0), dampingForces(0),isDiagonal(false),diagMass(0),
  mV(0),tmpV1(0),tmpV2(0),
- theSOE(0), theAnalysisModel(0), theTest(0)
+ theSOE(0), theAnalysisModel(0), theTest(0),
+ localTol(0.0), localStamp(-1), elementResidual(0), allEqns(0),
+ residualsFormed(false)
 {
   
 }
@@ -65,6 +73,10 @@ IncrementalIntegrator::~IncrementalIntegrator()
     delete tmpV1;
   if (tmpV2 != 0)
     delete tmpV2;
+  if (elementResidual != 0)
+    delete elementResidual;
+  if (allEqns != 0)
+    delete allEqns;
 }
 
 void
@@ -242,6 +254,87 @@ IncrementalIntegrator::getAnalysisModel(void) const
     return theAnalysisModel;
 }
 
+int
+IncrementalIntegrator::computeBlockSensitivities(void)
+{
+    LinearSOE *theLinSOE = this->getLinearSOE();
+    if (theLinSOE == 0 || theAnalysisModel == 0) {
+	opserr << "WARNING IncrementalIntegrator::computeBlockSensitivities() - ";
+	opserr << "no LinearSOE or AnalysisModel has been set\n";
+	return -1;
+    }
+    Domain *theDomain = theAnalysisModel->getDomainPtr();
+
+    theLinSOE->zeroB();
+
+    // Form the part of the RHS which are independent of parameter
+    this->formIndependentSensitivityRHS();
+
+    // De-activate all parameters
+    std::vector<Parameter *> theParams;
+    ParameterIter &paramIter = theDomain->getParameters();
+    Parameter *theParam;
+    while ((theParam = paramIter()) != 0) {
+	theParam->activate(false);
+	theParams.push_back(theParam);
+    }
+
+    int numGrads = theDomain->getNumParameters();
+    int numEqn = theLinSOE->getNumEqn();
+    if (numGrads == 0 || numEqn == 0)
+	return 0;
+
+    int blockSize = this->getSensitivityBlockSize();
+    if (blockSize > numGrads)
+	blockSize = numGrads;
+
+    Matrix BX(numEqn, blockSize);
+
+    for (int start = 0; start < numGrads; start += blockSize) {
+	int numCols = numGrads - start;
+	if (numCols > blockSize)
+	    numCols = blockSize;
+
+	// leading numCols columns of BX
+	Matrix theBlock(&BX(0,0), numEqn, numCols);
+
+	// form the RHS of each parameter in the block, one column each
+	for (int k = 0; k < numCols; k++) {
+	    theParam = theParams[start+k];
+	    theParam->activate(true);
+	    theLinSOE->zeroB();
+	    this->formSensitivityRHS(theParam->getGradIndex());
+
+	    const Vector &B = theLinSOE->getB();
+	    for (int i = 0; i < numEqn; i++)
+		theBlock(i,k) = B(i);
+	    theParam->activate(false);
+	}
+
+	// solve for the displacement sensitivities of the whole block
+	if (theLinSOE->solveMultiple(theBlock) < 0) {
+	    opserr << "WARNING IncrementalIntegrator::computeBlockSensitivities() - ";
+	    opserr << "failed to solve for the sensitivities\n";
+	    return -1;
+	}
+
+	// save sensitivities to nodes & commit history variables
+	for (int k = 0; k < numCols; k++) {
+	    theParam = theParams[start+k];
+	    int gradIndex = theParam->getGradIndex();
+	    theParam->activate(true);
+
+	    Vector dUdh(&theBlock(0,k), numEqn);
+	    this->saveSensitivity(dUdh, gradIndex, numGrads);
+	    this->commitSensitivity(gradIndex, numGrads);
+
+	    theParam->activate(false);
+	}
+    }
+
+    return 0;
+}
+
 int 
 IncrementalIntegrator::formNodalUnbalance(void)
 {
@@ -263,6 +356,156 @@ IncrementalIntegrator::formNodalUnbalance(void)
     return res;
 }
 
+int
+IncrementalIntegrator::setLocalUpdate(double tol)
+{
+  if (tol == localTol)
+    return 0;
+
+  localTol = tol;
+  localStamp = -1;
+  residualsFormed = false;
+  if (theAnalysisModel != 0)
+    theAnalysisModel->setActiveFEs(0);
+
+  if (localTol <= 0.0) {
+    localTol = 0.0;
+    localFEs.clear(); eqnFEStart.clear(); eqnFEs.clear();
+    residualStart.clear(); feResiduals.clear(); pendingIncr.clear();
+    feMarked.clear(); activeFEs.clear(); activeIndex.clear();
+    if (elementResidual != 0)
+      delete elementResidual;
+    if (allEqns != 0)
+      delete allEqns;
+    elementResidual = 0;
+    allEqns = 0;
+  }
+
+  return 0;
+}
+
+int
+IncrementalIntegrator::formLocalMap(void)
+{
+  int numEqn = theAnalysisModel->getNumEqn();
+
+  localFEs.clear();
+  residualStart.assign(1, 0);
+  eqnFEStart.assign(numEqn+1, 0);
+
+  // count the FE_Elements at each equation
+  FE_EleIter &theEles = theAnalysisModel->getFEs();
+  FE_Element *elePtr;
+  while ((elePtr = theEles()) != 0) {
+    const ID &id = elePtr->getID();
+    for (int j = 0; j < id.Size(); j++)
+      if (id(j) >= 0 && id(j) < numEqn)
+	eqnFEStart[id(j)+1]++;
+    localFEs.push_back(elePtr);
+    residualStart.push_back(residualStart.back() + id.Size());
+  }
+  for (int i = 0; i < numEqn; i++)
+    eqnFEStart[i+1] += eqnFEStart[i];
+
+  // & fill them in, an FE_Element listed once per equation
+  eqnFEs.assign(eqnFEStart[numEqn], 0);
+  std::vector<int> next(eqnFEStart.begin(), eqnFEStart.end()-1);
+  for (std::size_t e = 0; e < localFEs.size(); e++) {
+    const ID &id = localFEs[e]->getID();
+    for (int j = 0; j < id.Size(); j++) {
+      int eqn = id(j);
+      if (eqn >= 0 && eqn < numEqn) {
+	int k = eqnFEStart[eqn];
+	while (k < next[eqn] && eqnFEs[k] != (int)e)
+	  k++;
+	if (k == next[eqn])
+	  eqnFEs[next[eqn]++] = e;
+      }
+    }
+  }
+
+  feResiduals.assign(residualStart.back(), 0.0);
+  pendingIncr.assign(numEqn, 0.0);
+  feMarked.assign(localFEs.size(), 0);
+  activeFEs.clear();
+  activeIndex.clear();
+
+  if (elementResidual == 0 || elementResidual->Size() != numEqn) {
+    if (elementResidual != 0)
+      delete elementResidual;
+    if (allEqns != 0)
+      delete allEqns;
+    elementResidual = new Vector(numEqn);
+    allEqns = new ID(numEqn);
+    for (int i = 0; i < numEqn; i++)
+      (*allEqns)(i) = i;
+  }
+
+  localStamp = theAnalysisModel->getModelStamp();
+  residualsFormed = false;
+
+  return 0;
+}
+
+int
+IncrementalIntegrator::selectActiveFEs(const Vector &deltaU)
+{
+  if (localTol <= 0.0 || theAnalysisModel == 0)
+    return 0;
+
+  if (localStamp != theAnalysisModel->getModelStamp())
+    if (this->formLocalMap() < 0)
+      return -1;
+
+  // until the residuals have been formed once, a full update
+  int numEqn = pendingIncr.size();
+  if (residualsFormed == false || deltaU.Size() != numEqn) {
+    theAnalysisModel->setActiveFEs(0);
+    return 0;
+  }
+
+  double maxIncr = 0.0;
+  for (int i = 0; i < numEqn; i++) {
+    double incr = fabs(deltaU(i));
+    if (incr > maxIncr)
+      maxIncr = incr;
+  }
+  double tol = localTol*maxIncr;
+
+  // an equation whose accumulated increment is above the tolerance
+  // activates all its FE_Elements; the others keep accumulating
+  activeFEs.clear();
+  activeIndex.clear();
+  for (int i = 0; i < numEqn; i++) {
+    pendingIncr[i] += deltaU(i);
+    if (fabs(pendingIncr[i]) > tol) {
+      pendingIncr[i] = 0.0;
+      for (int k = eqnFEStart[i]; k < eqnFEStart[i+1]; k++) {
+	int e = eqnFEs[k];
+	if (feMarked[e] == 0) {
+	  feMarked[e] = 1;
+	  activeIndex.push_back(e);
+	  activeFEs.push_back(localFEs[e]);
+	}
+      }
+    }
+  }
+  for (std::size_t i = 0; i < activeIndex.size(); i++)
+    feMarked[activeIndex[i]] = 0;
+
+  theAnalysisModel->setActiveFEs(&activeFEs);
+
+  return activeFEs.size();
+}
+
+int
+IncrementalIntegrator::getNumActiveFEs(void) const
+{
+  if (localTol <= 0.0)
+    return 0;
+  return activeFEs.size();
+}
+
 int 
 IncrementalIntegrator::formElementResidual(void)
 {
@@ -271,14 +514,68 @@ IncrementalIntegrator::formElementResidual(void)
 
     int res = 0;    
 
-    FE_EleIter &theEles2 = theAnalysisModel->getFEs();    
-    while((elePtr = theEles2()) != 0) {
+    if (localTol <= 0.0) {
+      FE_EleIter &theEles2 = theAnalysisModel->getFEs();    
+      while((elePtr = theEles2()) != 0) {
 
 	if (theSOE->addB(elePtr->getResidual(this),elePtr->getID()) <0) {
 	    opserr << "WARNING IncrementalIntegrator::formElementResidual -";
 	    opserr << " failed in addB for ID " << elePtr->getID();
 	    res = -2;
 	}
+      }
+
+      return res;
+    }
+
+    if (localStamp != theAnalysisModel->getModelStamp())
+      if (this->formLocalMap() < 0)
+	return -1;
+
+    Vector &sumR = *elementResidual;
+    if (residualsFormed == true && theAnalysisModel->isLocalUpdate() == true) {
+
+      // replace the residuals of the FE_Elements just updated
+      for (std::size_t i = 0; i < activeIndex.size(); i++) {
+	int e = activeIndex[i];
+	elePtr = localFEs[e];
+	const ID &id = elePtr->getID();
+	const Vector &R = elePtr->getResidual(this);
+	double *oldR = &feResiduals[residualStart[e]];
+	for (int j = 0; j < id.Size(); j++) {
+	  int eqn = id(j);
+	  if (eqn >= 0)
+	    sumR(eqn) += R(j) - oldR[j];
+	  oldR[j] = R(j);
+	}
+      }
+
+      // the next update is a full one unless selected again
+      theAnalysisModel->setActiveFEs(0);
+
+    } else {
+
+      // all residuals are formed & kept
+      sumR.Zero();
+      for (std::size_t e = 0; e < localFEs.size(); e++) {
+	elePtr = localFEs[e];
+	const ID &id = elePtr->getID();
+	const Vector &R = elePtr->getResidual(this);
+	double *oldR = &feResiduals[residualStart[e]];
+	for (int j = 0; j < id.Size(); j++) {
+	  int eqn = id(j);
+	  if (eqn >= 0)
+	    sumR(eqn) += R(j);
+	  oldR[j] = R(j);
+	}
+      }
+      residualsFormed = true;
+    }
+
+    if (theSOE->addB(sumR, *allEqns) < 0) {
+      opserr << "WARNING IncrementalIntegrator::formElementResidual -";
+      opserr << " failed in addB\n";
+      res = -2;
     }
 
     return res;	    
@@ -37,6 +37,7 @@
 // What: "@(#) IncrementalIntegrator.h, revA"
 
 #include <Integrator.h>
+#include <vector>
 
 class LinearSOE;
 class EigenSOE;
@@ -45,6 +46,7 @@ class ConvergenceTest;
 class FE_Element;
 class DOF_Group;
 class Vector;
+class ID;
 
 #define CURRENT_TANGENT 0
 #define INITIAL_TANGENT 1
@@ -87,6 +89,13 @@ class IncrementalIntegrator : public Integrator
     virtual int revertToLastStep(void);
     virtual int initialize(void);
 
+    // local update iterations: only the FE_Elements with a dof whose
+    // accumulated increment exceeds tol times the largest increment are
+    // updated and their residuals replaced in the kept element residual
+    int setLocalUpdate(double tol);
+    int selectActiveFEs(const Vector &deltaU);
+    int getNumActiveFEs(void) const;
+
     //    int setModalDampingFactors(const Vector &);
     int setupModal(const Vector *modalDampingValues);
     int addModalDampingForce(const Vector *modalDampingValues);
@@ -111,6 +120,10 @@ class IncrementalIntegrator : public Integrator
 
     virtual int  formNodalUnbalance(void);        
     virtual int  formElementResidual(void);            
+
+    // sensitivities of blocks of parameters, solved together against the
+    // factored tangent; used when the sensitivity block size is > 1
+    int computeBlockSensitivities(void);
     int statusFlag;
     double iFactor;
     double cFactor;
@@ -127,10 +140,29 @@ class IncrementalIntegrator : public Integrator
     Vector *tmpV2;
     
   private:
+    int formLocalMap(void);
+
     LinearSOE *theSOE;
     AnalysisModel *theAnalysisModel;
     ConvergenceTest *theTest;
 
+    // local update data: the FE_Elements at each equation, the kept
+    // residuals of the FE_Elements & their sum, the increments not yet
+    // seen by the elements of each equation
+    double localTol;
+    int localStamp;
+    std::vector<FE_Element *> localFEs;
+    std::vector<int> eqnFEStart, eqnFEs;
+    std::vector<int> residualStart;
+    std::vector<double> feResiduals;
+    std::vector<double> pendingIncr;
+    std::vector<char> feMarked;
+    std::vector<FE_Element *> activeFEs;
+    std::vector<int> activeIndex;
+    Vector *elementResidual;
+    ID *allEqns;
+    bool residualsFormed;
+
 };
 
 #endif
@@ -37,7 +37,8 @@
 #include <Vector.h>
 
  Integrator::Integrator(int clasTag)
-     :MovableObject(clasTag), analysisTypeTag(0), SensitivityKey(false)
+     :MovableObject(clasTag), analysisTypeTag(0), SensitivityKey(false),
+      sensitivityBlockSize(1)
 {
 }
 
@@ -133,4 +134,10 @@ Integrator::setComputeType(int flag)
     analysisTypeTag = flag;
 }
 
+void
+Integrator::setSensitivityBlockSize(int numParams)
+{
+    sensitivityBlockSize = (numParams > 1) ? numParams : 1;
+}
+
  ////////////////////////Abbas/////////////////////////////////////
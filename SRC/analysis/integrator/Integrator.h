@@ -78,6 +78,8 @@ public:
     int sensitivityDomainChanged();//Abbass
     bool shouldComputeAtEachStep(void);
     void setComputeType(int flag);
+    void setSensitivityBlockSize(int numParams);
+    int getSensitivityBlockSize(void) {return sensitivityBlockSize;};
     bool newAlgorithm(void) {return true;}
     virtual  bool computeSensitivityAtEachIteration();    
     void activateSensitivityKey() {SensitivityKey=true;}
@@ -90,6 +92,7 @@ private:
 
     int analysisTypeTag;
     bool SensitivityKey;
+    int sensitivityBlockSize;
 };
 
 #endif
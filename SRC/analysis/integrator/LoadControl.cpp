@@ -350,6 +350,10 @@ int
 LoadControl::computeSensitivities(void)
 {
 //  opserr<<" computeSensitivity::start"<<endln; 
+    // parameters solved together against the factored tangent
+    if (this->getSensitivityBlockSize() > 1)
+      return this->computeBlockSensitivities();
+
     LinearSOE *theSOE = this->getLinearSOE();
 
     /*
@@ -37,6 +37,7 @@
 #include <LinearSOE.h>
 #include <AnalysisModel.h>
 #include <Vector.h>
+#include <math.h>
 #include <DOF_Group.h>
 #include <DOF_GrpIter.h>
 #include <AnalysisModel.h>
@@ -227,8 +228,7 @@ int Newmark::newStep(double deltaT)
     } else  {
         // determine new displacements and velocities at t+deltaT      
         double a1 = (deltaT*deltaT/2.0);
-        U->addVector(1.0, *Utdot, deltaT);
-        U->addVector(1.0, *Utdotdot, a1);
+        U->addVector(1.0, *Utdot, deltaT, *Utdotdot, a1);
         
         Udot->addVector(1.0, *Utdotdot, deltaT);
 
@@ -255,6 +255,17 @@ Newmark::getVel(void)
   return *Udot;
 }
 
+
+int
+Newmark::getLocalErrorEstimate(double deltaT, double &errNorm, double &dispNorm)
+{
+  if (U == 0 || Udotdot == 0 || Utdotdot == 0)
+    return -1;
+
+  return this->newmarkErrorEstimate(beta, 0.0, deltaT, *U, *Udotdot, *Utdotdot,
+				    errNorm, dispNorm);
+}
+
 int Newmark::revertToLastStep()
 {
   // set response at t+deltaT to be that at t .. for next newStep
@@ -948,6 +959,10 @@ int
 Newmark::computeSensitivities(void)
 {
   //  opserr<<" computeSensitivity::start"<<endln; 
+  // parameters solved together against the factored tangent
+  if (this->getSensitivityBlockSize() > 1)
+    return this->computeBlockSensitivities();
+
   LinearSOE *theSOE = this->getLinearSOE();
   
   /*
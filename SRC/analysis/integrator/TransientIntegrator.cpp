@@ -44,16 +44,21 @@
 #include <DOF_Group.h>
 #include <FE_EleIter.h>
 #include <DOF_GrpIter.h>
+#include <math.h>
 
 TransientIntegrator::TransientIntegrator(int clasTag)
-:IncrementalIntegrator(clasTag)
+:IncrementalIntegrator(clasTag),
+ errAccel(0), errAccelIncr(0), errDeltaT(0.0), errLastDeltaT(0.0)
 {
 
 }
 
 TransientIntegrator::~TransientIntegrator()
 {
-
+  if (errAccel != 0)
+    delete errAccel;
+  if (errAccelIncr != 0)
+    delete errAccelIncr;
 }
 
 int 
@@ -169,4 +174,57 @@ TransientIntegrator::formNodUnbalance(DOF_Group *theDof)
 }    
 
 
+int
+TransientIntegrator::newmarkErrorEstimate(double beta, double shift, double deltaT,
+					  const Vector &U, const Vector &Udotdot,
+					  const Vector &Utdotdot,
+					  double &errNorm, double &dispNorm)
+{
+  // u(t+dt) = u + dt*v + dt^2*((1/2-beta)*a + beta*a(t+dt)), with a(t)
+  // standing for the exact acceleration at t + shift*dt, expands to the
+  // exact displacement + c3*dt^3*a' + c4*dt^4*a''. c3 vanishes for the
+  // linear acceleration method, so the dt^4 term is kept.
+  double c3 = beta + 0.5*shift - 1.0/6.0;
+  double c4 = 0.5*((0.5 - beta)*shift*shift + beta*(1.0 + shift)*(1.0 + shift)) - 1.0/24.0;
+
+  int size = U.Size();
+  if (deltaT <= 0.0 || Udotdot.Size() != size || Utdotdot.Size() != size)
+    return -1;
+
+  // a new step starts from new accelerations; the increment of the step
+  // before gives a'' by a difference over the two steps
+  if (errAccel == 0 || errAccel->Size() != size) {
+    if (errAccel != 0)
+      delete errAccel;
+    if (errAccelIncr != 0)
+      delete errAccelIncr;
+    errAccel = new Vector(Utdotdot);
+    errAccelIncr = new Vector(size);
+    errDeltaT = 0.0;
+  } else if (*errAccel != Utdotdot) {
+    errAccelIncr->addVector(0.0, Utdotdot, 1.0);
+    errAccelIncr->addVector(1.0, *errAccel, -1.0);
+    *errAccel = Utdotdot;
+    errDeltaT = errLastDeltaT;
+  }
+  errLastDeltaT = deltaT;
+
+  double dt2 = deltaT*deltaT;
+  errNorm = 0.0;
+  dispNorm = 0.0;
+  for (int i=0; i<size; i++) {
+    double da = Udotdot(i) - Utdotdot(i);
+    // without a step before, a'' is bounded by the increment over dt^2
+    double d2a = da/dt2;
+    if (errDeltaT > 0.0)
+      d2a = 2.0*(da/deltaT - (*errAccelIncr)(i)/errDeltaT)/(deltaT + errDeltaT);
+    double e = fabs(c3*dt2*da + c4*dt2*dt2*d2a);
+    if (e > errNorm)
+      errNorm = e;
+    double u = fabs(U(i));
+    if (u > dispNorm)
+      dispNorm = u;
+  }
 
+  return 0;
+}
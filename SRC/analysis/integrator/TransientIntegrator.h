@@ -63,12 +63,28 @@ class TransientIntegrator : public IncrementalIntegrator
     virtual int formNodUnbalance(DOF_Group *theDof);    
 
     virtual const Vector& getVel(void) = 0; // For modal damping
+
+    // local truncation error estimate of the current step (infinity norm)
+    // and the norm of the trial displacements, used by the adaptive time
+    // stepping of DirectIntegrationAnalysis; -1 if there is no estimate
+    virtual int getLocalErrorEstimate(double deltaT, double &errNorm, double &dispNorm) {return -1;};
     
     virtual int initialize(void) {return 0;};
 
   protected:
+    // the estimate for a Newmark displacement update whose accelerations
+    // lead the exact ones by shift*deltaT (0 Newmark, alpha-1 HHT,
+    // alphaF-alphaM GeneralizedAlpha)
+    int newmarkErrorEstimate(double beta, double shift, double deltaT,
+			     const Vector &U, const Vector &Udotdot,
+			     const Vector &Utdotdot,
+			     double &errNorm, double &dispNorm);
     
   private:
+    Vector *errAccel;       // acceleration at the start of the last step estimated
+    Vector *errAccelIncr;   // acceleration increment of the step before it
+    double errDeltaT;       // and its size, 0 if there is none
+    double errLastDeltaT;   // size of the last step estimated
 };
 
 #endif
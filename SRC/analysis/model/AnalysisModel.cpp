@@ -41,6 +41,7 @@
 #include <AnalysisModel.h>
 #include <Domain.h>
 #include <FE_Element.h>
+#include <Element.h>
 #include <DOF_Group.h>
 #include <DOF_GrpIter.h>
 #include <FE_EleIter.h>
@@ -63,7 +64,8 @@ AnalysisModel::AnalysisModel(int theClassTag)
 :MovableObject(theClassTag),
  myDomain(0), myHandler(0),
  myDOFGraph(0), myGroupGraph(0),
- numFE_Ele(0), numDOF_Grp(0), numEqn(0)
+ numFE_Ele(0), numDOF_Grp(0), numEqn(0),
+ activeFEs(0), localUpdate(false), modelStamp(0)
 {
     theFEs     = new ArrayOfTaggedObjects(1024);
     theDOFs    =  new ArrayOfTaggedObjects(1024);
@@ -77,7 +79,8 @@ AnalysisModel::AnalysisModel()
 :MovableObject(AnaMODEL_TAGS_AnalysisModel),
  myDomain(0), myHandler(0),
  myDOFGraph(0), myGroupGraph(0),
- numFE_Ele(0), numDOF_Grp(0), numEqn(0)
+ numFE_Ele(0), numDOF_Grp(0), numEqn(0),
+ activeFEs(0), localUpdate(false), modelStamp(0)
 {
   theFEs     = new ArrayOfTaggedObjects(256);
   theDOFs    = new ArrayOfTaggedObjects(256);
@@ -90,7 +93,8 @@ AnalysisModel::AnalysisModel(TaggedObjectStorage &theFes, TaggedObjectStorage &t
 :MovableObject(AnaMODEL_TAGS_AnalysisModel),
  myDomain(0), myHandler(0),
  myDOFGraph(0), myGroupGraph(0),
- numFE_Ele(0), numDOF_Grp(0), numEqn(0)
+ numFE_Ele(0), numDOF_Grp(0), numEqn(0),
+ activeFEs(0), localUpdate(false), modelStamp(0)
 {
   theFEs     = &theFes;
   theDOFs    = &theDofs;
@@ -159,6 +163,7 @@ AnalysisModel::addFE_Element(FE_Element *theElement)
   if (result == true) {
     theElement->setAnalysisModel(*this);
     numFE_Ele++;
+    modelStamp++;
     return true;  // o.k.
   } else
     return false;
@@ -219,6 +224,10 @@ AnalysisModel::clearAll(void)
     numFE_Ele =0;
     numDOF_Grp = 0;
     numEqn = 0;    
+
+    activeFEs = 0;
+    localUpdate = false;
+    modelStamp++;
 }
 
 void
@@ -279,6 +288,7 @@ void
 AnalysisModel::setNumEqn(int theNumEqn)
 {
     numEqn = theNumEqn;
+    modelStamp++;
 }
 
 int 
@@ -562,6 +572,10 @@ AnalysisModel::applyLoadDomain(double pseudoTime)
 	return;
     }
 
+    // a change in load may change the element loads of any element, the
+    // next update is a full one
+    activeFEs = 0;
+
     // invoke the method
     myDomain->applyLoad(pseudoTime);
     myHandler->applyLoad();
@@ -578,8 +592,21 @@ AnalysisModel::updateDomain(void)
 	return -1;
     }
 
-    // invoke the method
-    int res = myDomain->update();
+    int res = 0;
+    if (activeFEs != 0) {
+
+      // only update the elements of the FE_Elements set
+      activeFEs = 0;
+      localUpdate = true;
+      res = myDomain->update(activeEles);
+
+    } else {
+
+      // invoke the method
+      localUpdate = false;
+      res = myDomain->update();
+    }
+
     if (res == 0)
       return myHandler->update();
 
@@ -601,6 +628,8 @@ AnalysisModel::updateDomain(double newTime, double dT)
     // invoke the method
 
     int res = 0;
+    activeFEs = 0;
+    localUpdate = false;
     myDomain->applyLoad(newTime);
     if (res == 0)
       res = myHandler->applyLoad();
@@ -652,6 +681,8 @@ AnalysisModel::commitDomain(void)
 	return -1;
     }
 
+    localUpdate = false;
+
     // invoke the method
     if (myDomain->commit() < 0) {
 	opserr << "WARNING: AnalysisModel::commitDomain - Domain::commit() failed\n";
@@ -672,6 +703,9 @@ AnalysisModel::revertDomainToLastCommit(void)
 	return -1;
     }
 
+    activeFEs = 0;
+    localUpdate = false;
+
     // invoke the method
     if (myDomain->revertToLastCommit() < 0) {
 	opserr << "WARNING: AnalysisModel::revertDomainToLastCommit.";
@@ -681,6 +715,34 @@ AnalysisModel::revertDomainToLastCommit(void)
     return 0;
 }
 
+void
+AnalysisModel::setActiveFEs(const std::vector<FE_Element *> *theActive)
+{
+    activeFEs = theActive;
+    localUpdate = false;
+
+    activeEles.clear();
+    if (theActive != 0) {
+      for (std::size_t i = 0; i < theActive->size(); i++) {
+	Element *theEle = (*theActive)[i]->getElement();
+	if (theEle != 0 && theEle->isActive())
+	  activeEles.push_back(theEle);
+      }
+    }
+}
+
+bool
+AnalysisModel::isLocalUpdate(void) const
+{
+    return localUpdate;
+}
+
+int
+AnalysisModel::getModelStamp(void) const
+{
+    return modelStamp;
+}
+
 double
 AnalysisModel::getCurrentDomainTime(void)
 {
@@ -40,6 +40,7 @@
 // What: "@(#) AnalysisModel.h, revA"
 
 #include <MovableObject.h>
+#include <vector>
 
 class TaggedObjectStorage;
 class Domain;
@@ -47,6 +48,7 @@ class FE_EleIter;
 class DOF_GrpIter;
 class Graph;
 class FE_Element;
+class Element;
 class DOF_Group;
 class Vector;
 class FEM_ObjectBroker;
@@ -107,6 +109,13 @@ class AnalysisModel: public MovableObject
     virtual void   applyLoadDomain(double newTime);
     virtual int    updateDomain(void);
     virtual int    updateDomain(double newTime, double dT);
+
+    // local update: the next updateDomain(void) only updates the elements
+    // of the given FE_Elements; isLocalUpdate() reports if the last update
+    // was such, getModelStamp() changes whenever the model is rebuilt
+    void   setActiveFEs(const std::vector<FE_Element *> *theFEs);
+    bool   isLocalUpdate(void) const;
+    int    getModelStamp(void) const;
     virtual int    analysisStep(double dT =0.0);
     virtual int    eigenAnalysis(int numMode, bool generalized, bool findSmallest);
     virtual int    commitDomain(void);
@@ -140,6 +149,11 @@ class AnalysisModel: public MovableObject
     
     FE_EleIter    *theFEiter;     
     DOF_GrpIter   *theDOFiter;    
+
+    const std::vector<FE_Element *> *activeFEs;
+    std::vector<Element *> activeEles;   // their elements
+    bool localUpdate;
+    int modelStamp;
 };
 
 #endif
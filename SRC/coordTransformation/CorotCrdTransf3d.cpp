@@ -36,6 +36,7 @@
 #include <math.h>
 #include <Vector.h>
 #include <Matrix.h>
+#include <MatrixND.h>
 #include <Node.h>
 #include <Channel.h>
 #include <elementAPI.h>
@@ -47,12 +48,15 @@ Matrix CorotCrdTransf3d::RI(3,3);
 Matrix CorotCrdTransf3d::RJ(3,3); 
 Matrix CorotCrdTransf3d::Rbar(3,3); 
 Matrix CorotCrdTransf3d::e(3,3); 
-Matrix CorotCrdTransf3d::Tp(6,7); 
-Matrix CorotCrdTransf3d::T(7,12);
+MatrixND<6,7> CorotCrdTransf3d::TpData;
+MatrixND<7,12> CorotCrdTransf3d::TData;
+MatrixND<12,12> CorotCrdTransf3d::kgData;
+Matrix CorotCrdTransf3d::Tp(&TpData.values[0][0], 6, 7);
+Matrix CorotCrdTransf3d::T(&TData.values[0][0], 7, 12);
 Matrix CorotCrdTransf3d::Tlg(12,12);
 Matrix CorotCrdTransf3d::TlgInv(12, 12);
 Matrix CorotCrdTransf3d::Tbl(6,12);
-Matrix CorotCrdTransf3d::kg(12,12);
+Matrix CorotCrdTransf3d::kg(&kgData.values[0][0], 12, 12);
 Matrix CorotCrdTransf3d::Lr2(12,3);
 Matrix CorotCrdTransf3d::Lr3(12,3);
 Matrix CorotCrdTransf3d::A(3,3);
@@ -1117,11 +1121,15 @@ CorotCrdTransf3d::getGlobalResistingForce(const Vector &pb, const Vector &p0)
     // if there are no element loads present
     if (p0 == 0.0) {
         // transform resisting forces from the basic system to local coordinates
-        static Vector pl(7);
-        pl.addMatrixTransposeVector(0.0, Tp, pb, 1.0);    // pl = Tp ^ pb;
+        static VectorND<6> pbN;
+        static VectorND<7> pl;
+        static VectorND<12> pgN;
+        pbN = pb;
+        addMatrixTransposeVector(pl, 0.0, TpData, pbN, 1.0);    // pl = Tp ^ pb;
 
         // transform resisting forces from local to global coordinates
-        pg.addMatrixTransposeVector(0.0, T, pl, 1.0);   // pg = T ^ pl; residual
+        addMatrixTransposeVector(pgN, 0.0, TData, pl, 1.0);   // pg = T ^ pl; residual
+        pgN.addTo(pg);
     }
 
     // if there are element loads present
@@ -1147,11 +1155,15 @@ CorotCrdTransf3d::getGlobalResistingForce(const Vector &pb, const Vector &p0)
         // FASTER!!!! TRANSFORM REACTIONS AND ADD AT END
         // =============================================
         // transform resisting forces from the basic system to local coordinates
-        static Vector pl(7);
-        pl.addMatrixTransposeVector(0.0, Tp, pb, 1.0);    // pl = Tp ^ pb;
+        static VectorND<6> pbN;
+        static VectorND<7> pl;
+        static VectorND<12> pgN;
+        pbN = pb;
+        addMatrixTransposeVector(pl, 0.0, TpData, pbN, 1.0);    // pl = Tp ^ pb;
 
         // transform resisting forces from local to global coordinates
-        pg.addMatrixTransposeVector(0.0, T, pl, 1.0);   // pg = T ^ pl; residual
+        addMatrixTransposeVector(pgN, 0.0, TData, pl, 1.0);   // pg = T ^ pl; residual
+        pgN.addTo(pg);
 
         // add end forces due to element p0 loads
         // assuming member loads are in local system
@@ -1178,21 +1190,25 @@ CorotCrdTransf3d::getGlobalStiffMatrix(const Matrix &kb, const Vector &pb)
     
     int i, j, k;   
     // transform tangent stiffness matrix from the basic system to local coordinates
-    static Matrix kl(7,7);
-    kl.addMatrixTripleProduct(0.0, Tp, kb, 1.0);      // kl = Tp ^ kb * Tp;
+    static MatrixND<6,6> kbN;
+    static MatrixND<7,7> kl;
+    kbN = kb;
+    kl.addMatrixTripleProduct(0.0, TpData, kbN, 1.0);      // kl = Tp ^ kb * Tp;
 
     //    opserr << "kb: " << kb;
     //    opserr << "Tp: " << Tp;
     
     // transform resisting forces from the basic system to local coordinates
-    static Vector pl(7);
-    pl.addMatrixTransposeVector(0.0, Tp, pb, 1.0);    // pl = Tp ^ pb;
+    static VectorND<6> pbN;
+    static VectorND<7> pl;
+    pbN = pb;
+    addMatrixTransposeVector(pl, 0.0, TpData, pbN, 1.0);    // pl = Tp ^ pb;
     
     // transform tangent  stiffness matrix from local to global coordinates
     //static Matrix kg(12,12);
     
     // compute the tangent stiffness matrix in global coordinates
-    kg.addMatrixTripleProduct(0.0, T, kl, 1.0);
+    kgData.addMatrixTripleProduct(0.0, TData, kl, 1.0);
     
     static Vector m(6);
     for (i = 0; i < 6; i++)
@@ -1437,9 +1453,11 @@ CorotCrdTransf3d::getGlobalStiffMatrix(const Matrix &kb, const Vector &pb)
             for (k = 0; k < 6; k++)
             {
                 factor = pl(k) * tan(ul(k));
-                for (i = 0; i < 12; i++)
-                    for (j = 0; j < 12; j++)
-                        kg(i,j) += T(k,i) * factor * T(k,j);
+                for (j = 0; j < 12; j++) {
+                    double fTkj = factor * TData(k,j);
+                    for (i = 0; i < 12; i++)
+                        kgData(i,j) += TData(k,i) * fTkj;
+                }
             }
             
 	    //            opserr << "COROATIONAL 3d: kg final: " << kg;
@@ -1452,14 +1470,16 @@ const Matrix &
 CorotCrdTransf3d::getInitialGlobalStiffMatrix(const Matrix &kb)
 {
     // transform tangent stiffness matrix from the basic system to local coordinates
-    static Matrix kl(7,7);
-    kl.addMatrixTripleProduct(0.0, Tp, kb, 1.0);      // kl = Tp ^ kb * Tp;
+    static MatrixND<6,6> kbN;
+    static MatrixND<7,7> kl;
+    kbN = kb;
+    kl.addMatrixTripleProduct(0.0, TpData, kbN, 1.0);      // kl = Tp ^ kb * Tp;
     
     // transform tangent  stiffness matrix from local to global coordinates
     //static Matrix kg(12,12);
     
     // compute the tangent stiffness matrix in global coordinates
-    kg.addMatrixTripleProduct(0.0, T, kl, 1.0);
+    kgData.addMatrixTripleProduct(0.0, TData, kl, 1.0);
     
     return kg;
 }
@@ -39,6 +39,7 @@
 #include <CrdTransf.h>
 #include <Vector.h>
 #include <Matrix.h>
+#include <MatrixND.h>
 
 class CorotCrdTransf3d: public CrdTransf
 {
@@ -133,6 +134,9 @@ private:
     static Matrix e;            // base vectors
     static Matrix Tp;           // transformation matrix to renumber dofs
     static Matrix T;            // transformation matrix from basic to global system
+    static MatrixND<6,7> TpData;   // the data of Tp, T & kg, for the fixed
+    static MatrixND<7,12> TData;   // size products of the stiffness and
+    static MatrixND<12,12> kgData; // resisting force
     static Matrix Tlg;          // transformation matrix from global to local system
     static Matrix TlgInv;       // inverse of transformation matrix from global to local system
     static Matrix Tbl;          // transformation matrix from local to basic system
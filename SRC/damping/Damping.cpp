@@ -40,6 +40,7 @@
 
 #include <Damping.h>
 
+#include <string.h>
 #include <TaggedObject.h>
 #include <MapOfTaggedObjects.h>
 
@@ -110,3 +111,138 @@ Damping::~Damping()
 {
 }
 
+
+
+DampingFilterBank::DampingFilterBank(int n, const double *g, const double *w)
+  :nFilter(n), gain(g, g+n), omegac(w, w+n), coef(3*n), km(0.0), lastDT(-1.0)
+{
+}
+
+const double *
+DampingFilterBank::getCoefficients(double dT)
+{
+  if (lastDT.load(std::memory_order_acquire) != dT)
+  {
+    std::lock_guard<std::mutex> lock(coefMutex);
+    if (lastDT.load(std::memory_order_relaxed) != dT)
+    {
+      km = 0.0;
+      for (int i = 0; i < nFilter; ++i)
+      {
+        double dTomegac = dT * omegac[i];
+        coef[3*i] = 4.0 * gain[i] / (2.0 + dTomegac);
+        coef[3*i+1] = dTomegac / (2.0 + dTomegac);
+        coef[3*i+2] = (2.0 - dTomegac) / (2.0 + dTomegac);
+        km += coef[3*i];
+      }
+      lastDT.store(dT, std::memory_order_release);
+    }
+  }
+  return &coef[0];
+}
+
+double
+DampingFilterBank::getStiffnessMultiplier(double dT)
+{
+  this->getCoefficients(dT);
+  return km;
+}
+
+
+DampingFilterState::DampingFilterState()
+  :nComp(0), nFilter(0), size(0), trial(0), committed(0), qd()
+{
+}
+
+DampingFilterState::~DampingFilterState()
+{
+  if (trial) delete [] trial;
+}
+
+int
+DampingFilterState::setSize(int nC, int nF)
+{
+  if (trial) delete [] trial;
+  nComp = nC;
+  nFilter = nF;
+  size = nComp * (2 + nFilter);
+  trial = new double[2*size];
+  committed = trial + size;
+  for (int i = 0; i < 2*size; ++i)
+    trial[i] = 0.0;
+  qd.setData(trial, nComp);
+  return 0;
+}
+
+void
+DampingFilterState::commitState(void)
+{
+  memcpy(committed, trial, size*sizeof(double));
+}
+
+void
+DampingFilterState::revertToLastCommit(void)
+{
+  memcpy(trial, committed, size*sizeof(double));
+}
+
+void
+DampingFilterState::revertToStart(void)
+{
+  for (int i = 0; i < 2*size; ++i)
+    trial[i] = 0.0;
+}
+
+void
+DampingFilterState::setInput(const Vector &q)
+{
+  double *q0 = trial + nComp;
+  for (int j = 0; j < nComp; ++j)
+  {
+    trial[j] = 0.0;
+    q0[j] = q(j);
+  }
+}
+
+void
+DampingFilterState::resetFilters(const Vector &q)
+{
+  this->setInput(q);
+  double *qL = trial + 2*nComp;
+  for (int i = 0; i < nFilter; ++i, qL += nComp)
+    for (int j = 0; j < nComp; ++j)
+      qL[j] = q(j);
+}
+
+void
+DampingFilterState::filter(const Vector &q, const double *coef, double factor)
+{
+  double *qdT = trial;
+  double *q0 = trial + nComp;
+  double *qL = trial + 2*nComp;
+  const double *qdC = committed;
+  const double *q0C = committed + nComp;
+  const double *qLC = committed + 2*nComp;
+
+  for (int j = 0; j < nComp; ++j)
+  {
+    q0[j] = q(j);
+    qdT[j] = 0.0;
+  }
+
+  for (int i = 0; i < nFilter; ++i, qL += nComp, qLC += nComp, coef += 3)
+  {
+    double cd = coef[0];
+    double c0 = coef[1];
+    double cL = coef[2];
+    for (int j = 0; j < nComp; ++j)
+    {
+      double qsum = q0C[j] + q0[j];
+      qdT[j] += cd * (qsum - 2.0 * qLC[j]);
+      qL[j] = c0 * qsum + cL * qLC[j];
+    }
+  }
+
+  for (int j = 0; j < nComp; ++j)
+    qdT[j] = (qdT[j] - qdC[j]) * factor;
+}
@@ -45,8 +45,11 @@
 
 #include <MovableObject.h>
 #include <TaggedObject.h>
-
-class Vector;
+#include <Vector.h>
+#include <vector>
+#include <atomic>
+#include <mutex>
+#include <memory>
 
 // class definition
 
@@ -59,7 +62,7 @@ public:
 
   virtual Damping *getCopy(void) = 0;
   virtual int setDomain(Domain *domain, int nComp) = 0;
-  virtual int update(Vector q) = 0;
+  virtual int update(const Vector &q) = 0;
   virtual int commitState(void) = 0;
   virtual int revertToLastCommit(void) = 0;
   virtual int revertToStart(void) = 0;
@@ -72,6 +75,67 @@ protected:
 private:
 };
 
+// DampingFilterBank holds the constant part of the bank of first-order
+// filters used by UniformDamping, URDDamping and URDDampingbeta: the gain
+// and the cut-off frequency of every filter. All copies of one damping
+// definition share a single bank, so the coefficients for a time step dT
+// are evaluated once and not for every element and iteration.
+class DampingFilterBank
+{
+public:
+  DampingFilterBank(int nFilter, const double *gain, const double *omegac);
+
+  int getNumFilters(void) const {return nFilter;};
+  // {cd, c0, cL} for every filter
+  const double *getCoefficients(double dT);
+  // sum of the cd of all filters
+  double getStiffnessMultiplier(double dT);
+
+private:
+  int nFilter;
+  std::vector<double> gain, omegac, coef;
+  double km;
+  std::atomic<double> lastDT;
+  std::mutex coefMutex;
+};
+
+// DampingFilterState keeps the per-element history of a Damping object in
+// one contiguous block, trial values followed by committed values, so that
+// update() does not allocate and commit/revert are single copies:
+//   [ qd(nComp) | q0(nComp) | qL(nComp x nFilter, column-major) ]
+class DampingFilterState
+{
+public:
+  DampingFilterState();
+  ~DampingFilterState();
+
+  int setSize(int nComp, int nFilter);
+  void commitState(void);
+  void revertToLastCommit(void);
+  void revertToStart(void);
+
+  // q0 = q, qd = 0
+  void setInput(const Vector &q);
+  // setInput(q) and all filters at rest at q
+  void resetFilters(const Vector &q);
+  // advance all filters with the coefficients of DampingFilterBank and
+  // scale the resulting increment of qd by factor
+  void filter(const Vector &q, const double *coef, double factor);
+
+  const Vector &getDampingForce(void) {return qd;};
+  int getNumComponents(void) const {return nComp;};
+  double *getQd(void) {return trial;};
+  const double *getCommittedQ0(void) const {return committed + nComp;};
+
+private:
+  DampingFilterState(const DampingFilterState &);
+  DampingFilterState &operator=(const DampingFilterState &);
+
+  int nComp, nFilter, size;
+  double *trial, *committed;
+  Vector qd;
+};
+
 // some additional methods related to prototypes created for copy constructors
 extern bool     OPS_addDamping(Damping *newComponent);
 extern Damping *OPS_getDamping(int tag);
@@ -47,7 +47,7 @@
 // constructor:
 SecStifDamping::SecStifDamping(int tag, double b, double t1, double t2, TimeSeries *f):
 Damping(tag, DMP_TAG_SecStifDamping),
-beta(b), ta(t1), td(t2), fac(f), qd(0), q0(0), q0C(0)
+beta(b), ta(t1), td(t2), fac(f), theState()
 {
   if (beta <= 0.0) opserr << "SecStifDamping::SecStifDamping:  Invalid damping factor\n";
 }
@@ -57,7 +57,7 @@ beta(b), ta(t1), td(t2), fac(f), qd(0), q0(0), q0C(0)
 // invoked by a FEM_ObjectBroker, recvSelf() needs to be invoked on this object.
 SecStifDamping::SecStifDamping():
 Damping(0, DMP_TAG_SecStifDamping),
-beta(0.0), ta(0.0), td(0.0), fac(0), qd(0), q0(0), q0C(0)
+beta(0.0), ta(0.0), td(0.0), fac(0), theState()
 {
     
 }
@@ -67,16 +67,13 @@ beta(0.0), ta(0.0), td(0.0), fac(0), qd(0), q0(0), q0C(0)
 SecStifDamping::~SecStifDamping() 
 {
   if (fac) delete fac;
-  if(qd) delete qd;
-  if(q0) delete q0;
-  if(q0C) delete q0C;
 }
 
 
 int
 SecStifDamping::commitState(void)
 {
-  *q0C = *q0;
+  theState.commitState();
   return 0;
 }
 
@@ -84,7 +81,7 @@ SecStifDamping::commitState(void)
 int
 SecStifDamping::revertToLastCommit(void)
 {
-  *q0 = *q0C;
+  theState.revertToLastCommit();
   return 0;
 }
 
@@ -92,8 +89,7 @@ SecStifDamping::revertToLastCommit(void)
 int
 SecStifDamping::revertToStart(void)
 {
-  (*q0).Zero();
-  (*q0C).Zero();
+  theState.revertToStart();
   return 0;
 }
 
@@ -103,35 +99,35 @@ SecStifDamping::setDomain(Domain *domain, int nComp)
 {       
   theDomain = domain;
   
-  qd = new Vector(nComp);
-  q0 = new Vector(nComp);
-  q0C = new Vector(nComp);
+  theState.setSize(nComp, 0);
     
   return 0;
 }
 
 
 int
-SecStifDamping::update(Vector q)
+SecStifDamping::update(const Vector &q)
 {       
   double t = theDomain->getCurrentTime();
   double dT = theDomain->getDT();
+  int nComp = theState.getNumComponents();
+  double *qd = theState.getQd();
   StaticAnalysis **theStaticAnalysis = OPS_GetStaticAnalysis();
   if (*theStaticAnalysis)
   {
-    (*qd).Zero();
+    for (int j = 0; j < nComp; ++j)
+      qd[j] = 0.0;
   }
   else if (dT > 0.0)
   {
-    *q0 = q;
+    theState.setInput(q);
     if (t > ta && t < td)
     {
-      *qd = (beta / dT) * (*q0 - *q0C);
-      if (fac) *qd *= fac->getFactor(t);
-    }
-    else
-    {
-      (*qd).Zero();
+      double c = beta / dT;
+      if (fac) c *= fac->getFactor(t);
+      const double *q0C = theState.getCommittedQ0();
+      for (int j = 0; j < nComp; ++j)
+        qd[j] = c * (q(j) - q0C[j]);
     }
   }
   return 0;
@@ -140,7 +136,7 @@ SecStifDamping::update(Vector q)
 const Vector &
 SecStifDamping::getDampingForce(void)
 {
-  return *qd;
+  return theState.getDampingForce();
 }
 
 double SecStifDamping::getStiffnessMultiplier(void)
@@ -50,7 +50,7 @@ public:
   const char *getClassType() const {return "SecStifDamping";};
   
   int setDomain(Domain *domain, int nComp);
-  int update(Vector q);
+  int update(const Vector &q);
   
   int commitState(void);
   int revertToLastCommit(void);    
@@ -71,7 +71,7 @@ private:
   // internal data
   double beta, ta, td;
   TimeSeries *fac;
-  Vector *qd, *q0, *q0C;
+  DampingFilterState theState;
   Domain *theDomain;
 };
 
@@ -55,10 +55,12 @@ using namespace std;
 // constructor:
 URDDamping::URDDamping(int tag, int nfreq, Matrix *etaf, double tol, double t1, double t2, TimeSeries *f, int ptag, int iter):
 Damping(tag, DMP_TAG_URDDamping),
+numfreq(nfreq), prttag(ptag), maxiter(iter),
 nComp(0), nFilter(0),
-numfreq(nfreq), dptol(tol), ta(t1), td(t2), fac(f), prttag(ptag), maxiter(iter),
-alpha(0), omegac(0), omegaetaf(0), qL(0), qLC(0), qd(0), qdC(0), q0(0), q0C(0),
-Freqlog(0), Fredif(0), Freqk(0), Freqb(0)
+ta(t1), td(t2), dptol(tol), fac(f),
+alpha(0), omegac(0), omegaetaf(0),
+Freqlog(0), Fredif(0), Freqk(0), Freqb(0),
+theFilters(), theState(), theDomain(0)
 {
   etaFreq = new Matrix(*etaf);
   Initialize();
@@ -68,10 +70,12 @@ Freqlog(0), Fredif(0), Freqk(0), Freqb(0)
 // constructor:
 URDDamping::URDDamping(int tag, int nfreq, Matrix* etaf, double tol, double t1, double t2, TimeSeries *f, int nF, Vector *a, Vector *w, Vector *ef, int ptag, int iter):
 Damping(tag, DMP_TAG_URDDamping),
+numfreq(nfreq), prttag(ptag), maxiter(iter),
 nComp(0), nFilter(0),
-numfreq(nfreq), dptol(tol), ta(t1), td(t2), fac(f), prttag(ptag), maxiter(iter),
-alpha(0), omegac(0), omegaetaf(0), qL(0), qLC(0), qd(0), qdC(0), q0(0), q0C(0),
-Freqlog(0), Fredif(0), Freqk(0), Freqb(0)
+ta(t1), td(t2), dptol(tol), fac(f),
+alpha(0), omegac(0), omegaetaf(0),
+Freqlog(0), Fredif(0), Freqk(0), Freqb(0),
+theFilters(), theState(), theDomain(0)
 {
   etaFreq = new Matrix(*etaf);
   if (nF > 0 && a->Size() == nF && w->Size() == nF && ef->Size() == nF)
@@ -92,10 +96,12 @@ Freqlog(0), Fredif(0), Freqk(0), Freqb(0)
 // invoked by a FEM_ObjectBroker, recvSelf() needs to be invoked on this object.
 URDDamping::URDDamping():
 Damping(0, DMP_TAG_URDDamping),
+numfreq(0), prttag(0), maxiter(0),
 nComp(0), nFilter(0),
-numfreq(0), etaFreq(0), dptol(0.0), ta(0.0), td(0.0), fac(0), prttag(0), maxiter(0),
-alpha(0), omegac(0), omegaetaf(0), qL(0), qLC(0), qd(0), qdC(0), q0(0), q0C(0),
-Freqlog(0), Fredif(0), Freqk(0), Freqb(0)
+ta(0.0), td(0.0), dptol(0.0), fac(0),
+alpha(0), omegac(0), omegaetaf(0),
+Freqlog(0), Fredif(0), Freqk(0), Freqb(0), etaFreq(0),
+theFilters(), theState(), theDomain(0)
 {
 
 }
@@ -108,12 +114,6 @@ URDDamping::~URDDamping()
   if (alpha) delete alpha;
   if (omegac) delete omegac;
   if (omegaetaf) delete omegaetaf;
-  if (qL) delete qL;
-  if (qLC) delete qLC;
-  if (qd) delete qd;
-  if (qdC) delete qdC;
-  if (q0) delete q0;
-  if (q0C) delete q0C;
   if (Freqlog) delete Freqlog;
   if (Fredif) delete Fredif;
   if (Freqk) delete Freqk;
@@ -501,9 +501,7 @@ URDDamping::Initialize(void)
 int
 URDDamping::commitState(void)
 {
-  *qdC = *qd;
-  *q0C = *q0;
-  *qLC = *qL;
+  theState.commitState();
   return 0;
 }
 
@@ -511,9 +509,7 @@ URDDamping::commitState(void)
 int
 URDDamping::revertToLastCommit(void)
 {
-  *qd = *qdC;
-  *q0 = *q0C;
-  *qL = *qLC;
+  theState.revertToLastCommit();
   return 0;
 }
 
@@ -521,12 +517,7 @@ URDDamping::revertToLastCommit(void)
 int
 URDDamping::revertToStart(void)
 {
-  (*qd).Zero();
-  (*qdC).Zero();
-  (*q0).Zero();
-  (*q0C).Zero();
-  (*qL).Zero();
-  (*qLC).Zero();
+  theState.revertToStart();
   return 0;
 }
 
@@ -537,60 +528,45 @@ URDDamping::setDomain(Domain *domain, int nC)
   theDomain = domain;
   nComp = nC;
   
-  qd = new Vector(nComp);
-  qdC = new Vector(nComp);
-  q0 = new Vector(nComp);
-  q0C = new Vector(nComp);
-  qL = new Matrix(nComp, nFilter);
-  qLC = new Matrix(nComp, nFilter);
+  if (!theFilters) this->setFilters();
+  theState.setSize(nComp, nFilter);
   
   return 0;
 }
 
 
+void
+URDDamping::setFilters(void)
+{
+  std::vector<double> gain(nFilter);
+  for (int i = 0; i < nFilter; ++i)
+    gain[i] = (*alpha)(i) * (*omegaetaf)(i);
+  theFilters = std::make_shared<DampingFilterBank>(nFilter, &gain[0], &(*omegac)(0));
+}
+
+
 int
-URDDamping::update(Vector q)
+URDDamping::update(const Vector &q)
 {
   double t = theDomain->getCurrentTime();
   double dT = theDomain->getDT();
   StaticAnalysis **theStaticAnalysis = OPS_GetStaticAnalysis();
   if (*theStaticAnalysis)
   {
-    *q0 = q;
-    (*qd).Zero();
-    for (int i = 0; i < nFilter; ++i)
-      for (int j = 0; j < nComp; ++j)
-        (*qL)(j,i) = q(j);
+    theState.resetFilters(q);
   }
   else if (dT > 0.0)
   {
-    *q0 = q;
-    (*qd).Zero();
     if (t < td)
     {
       if (t > ta)
-      {
-        for (int i = 0; i < nFilter; ++i)
-        {
-          double dTomegac = dT * (*omegac)(i);
-          double cd = 4.0 * (*alpha)(i) * (*omegaetaf)(i) / (2.0 + dTomegac);
-          double c0 = dTomegac / (2.0 + dTomegac);
-          double cL = (2.0 - dTomegac) / (2.0 + dTomegac);
-          for (int j = 0; j < nComp; ++j)
-          {
-            (*qd)(j) += cd * ((*q0C)(j) + (*q0)(j) - 2.0 * (*qLC)(j,i));
-            (*qL)(j,i) = c0 * ((*q0C)(j) + (*q0)(j)) + cL * (*qLC)(j,i);
-          }
-        }
-        *qd -= *qdC;
-      }
+        theState.filter(q, theFilters->getCoefficients(dT), fac ? fac->getFactor(t) : 1.0);
       else
-      {
-        for (int i = 0; i < nFilter; ++i)
-          for (int j = 0; j < nComp; ++j)
-            (*qL)(j,i) = q(j);
-      }
-      if (fac) *qd *= fac->getFactor(t);
+        theState.resetFilters(q);
+    }
+    else
+    {
+      theState.setInput(q);
     }
   }
   return 0;
@@ -599,7 +575,7 @@ URDDamping::update(Vector q)
 const Vector &
 URDDamping::getDampingForce(void)
 {
-  return (*qd);
+  return theState.getDampingForce();
 }
 
 double URDDamping::getStiffnessMultiplier(void)
@@ -610,10 +586,7 @@ double URDDamping::getStiffnessMultiplier(void)
   StaticAnalysis **theStaticAnalysis = OPS_GetStaticAnalysis();
   if (!*theStaticAnalysis && dT > 0.0 && t > ta && t < td)
   {
-    for (int i = 0; i < nFilter; ++i)
-    {
-        km += 4.0 * (*alpha)(i) * (*omegaetaf)(i) / (2.0 + (*omegac)(i) * dT); 
-    }
+    km = theFilters->getStiffnessMultiplier(dT);
     if (fac) km *= fac->getFactor(t);
   }
   return 1.0 + km;
@@ -627,6 +600,10 @@ Damping *URDDamping::getCopy(void)
 
   theCopy = new URDDamping(this->getTag(), numfreq, etaFreq, dptol, ta, td, fac, nFilter, alpha, omegac, omegaetaf, prttag, maxiter);
 
+  // the copies share the filter coefficients of this definition
+  if (!theFilters) this->setFilters();
+  theCopy->theFilters = theFilters;
+
   return theCopy;
 }
 
@@ -736,6 +713,7 @@ URDDamping::recvSelf(int cTag, Channel &theChannel, FEM_ObjectBroker &theBroker)
   (*etaFreq) = (*data2);
 
   Initialize();
+  theFilters.reset();
   return 0;
 }
 
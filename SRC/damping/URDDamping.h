@@ -56,7 +56,7 @@ public:
   int Initialize(void);
   
   int setDomain(Domain *domain, int nComp);
-  int update(Vector q);
+  int update(const Vector &q);
   
   int commitState(void);
   int revertToLastCommit(void);    
@@ -82,9 +82,11 @@ private:
   Vector *alpha, *omegac, *omegaetaf;
   Vector *Freqlog, *Fredif, *Freqk, *Freqb; 
   Matrix *etaFreq;
-  Matrix *qL, *qLC;
-  Vector *qd, *qdC, *q0, *q0C;
+  std::shared_ptr<DampingFilterBank> theFilters;
+  DampingFilterState theState;
   Domain *theDomain;
+
+  void setFilters(void);
 };
 
 #endif
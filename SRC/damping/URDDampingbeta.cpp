@@ -57,7 +57,7 @@ URDDampingbeta::URDDampingbeta(int tag, int nfreq, Vector *tmpomegac, Vector *tm
 Damping(tag, DMP_TAG_URDDampingbeta),
 nComp(0), nFilter(nfreq),
 ta(t1), td(t2), fac(f),
-qL(0), qLC(0), qd(0), qdC(0), q0(0), q0C(0)
+theFilters(), theState()
 {
   beta = new Vector(*tmpbeta);
   omegac = new Vector(*tmpomegac);
@@ -71,7 +71,7 @@ URDDampingbeta::URDDampingbeta():
 Damping(0, DMP_TAG_URDDampingbeta),
 nComp(0), nFilter(0),
 beta(0), omegac(0), ta(0.0), td(0.0), fac(0),
-qL(0), qLC(0), qd(0), qdC(0), q0(0), q0C(0)
+theFilters(), theState()
 {
 
 }
@@ -83,12 +83,6 @@ URDDampingbeta::~URDDampingbeta()
   if (fac) delete fac;
   if (beta) delete beta;
   if (omegac) delete omegac;
-  if (qL) delete qL;
-  if (qLC) delete qLC;
-  if (qd) delete qd;
-  if (qdC) delete qdC;
-  if (q0) delete q0;
-  if (q0C) delete q0C;
 }
 
 int
@@ -100,9 +94,7 @@ URDDampingbeta::Initialize(void)
 int
 URDDampingbeta::commitState(void)
 {
-  *qdC = *qd;
-  *q0C = *q0;
-  *qLC = *qL;
+  theState.commitState();
   return 0;
 }
 
@@ -110,9 +102,7 @@ URDDampingbeta::commitState(void)
 int
 URDDampingbeta::revertToLastCommit(void)
 {
-  *qd = *qdC;
-  *q0 = *q0C;
-  *qL = *qLC;
+  theState.revertToLastCommit();
   return 0;
 }
 
@@ -120,12 +110,7 @@ URDDampingbeta::revertToLastCommit(void)
 int
 URDDampingbeta::revertToStart(void)
 {
-  (*qd).Zero();
-  (*qdC).Zero();
-  (*q0).Zero();
-  (*q0C).Zero();
-  (*qL).Zero();
-  (*qLC).Zero();
+  theState.revertToStart();
   return 0;
 }
 
@@ -136,60 +121,45 @@ URDDampingbeta::setDomain(Domain *domain, int nC)
   theDomain = domain;
   nComp = nC;
   
-  qd = new Vector(nComp);
-  qdC = new Vector(nComp);
-  q0 = new Vector(nComp);
-  q0C = new Vector(nComp);
-  qL = new Matrix(nComp, nFilter);
-  qLC = new Matrix(nComp, nFilter);
+  if (!theFilters) this->setFilters();
+  theState.setSize(nComp, nFilter);
   
   return 0;
 }
 
 
+void
+URDDampingbeta::setFilters(void)
+{
+  std::vector<double> gain(nFilter);
+  for (int i = 0; i < nFilter; ++i)
+    gain[i] = (*beta)(i);
+  theFilters = std::make_shared<DampingFilterBank>(nFilter, &gain[0], &(*omegac)(0));
+}
+
+
 int
-URDDampingbeta::update(Vector q)
+URDDampingbeta::update(const Vector &q)
 {
   double t = theDomain->getCurrentTime();
   double dT = theDomain->getDT();
-  StaticAnalysis **theStaticAnalysis = OPS_GetStaticAnalysis();  
+  StaticAnalysis **theStaticAnalysis = OPS_GetStaticAnalysis();
   if (*theStaticAnalysis)
   {
-    *q0 = q;
-    (*qd).Zero();
-    for (int i = 0; i < nFilter; ++i)
-      for (int j = 0; j < nComp; ++j)
-        (*qL)(j,i) = q(j);
+    theState.resetFilters(q);
   }
   else if (dT > 0.0)
   {
-    *q0 = q;
-    (*qd).Zero();
     if (t < td)
     {
       if (t > ta)
-      {
-        for (int i = 0; i < nFilter; ++i)
-        {
-          double dTomegac = dT * (*omegac)(i);
-          double cd = 4.0 * (*beta)(i) / (2.0 + dTomegac);
-          double c0 = dTomegac / (2.0 + dTomegac);
-          double cL = (2.0 - dTomegac) / (2.0 + dTomegac);
-          for (int j = 0; j < nComp; ++j)
-          {
-            (*qd)(j) += cd * ((*q0C)(j) + (*q0)(j) - 2.0 * (*qLC)(j,i));
-            (*qL)(j,i) = c0 * ((*q0C)(j) + (*q0)(j)) + cL * (*qLC)(j,i);
-          }
-        }
-        *qd -= *qdC;
-      }
+        theState.filter(q, theFilters->getCoefficients(dT), fac ? fac->getFactor(t) : 1.0);
       else
-      {
-        for (int i = 0; i < nFilter; ++i)
-          for (int j = 0; j < nComp; ++j)
-            (*qL)(j,i) = q(j);
-      }
-      if (fac) *qd *= fac->getFactor(t);
+        theState.resetFilters(q);
+    }
+    else
+    {
+      theState.setInput(q);
     }
   }
   return 0;
@@ -198,7 +168,7 @@ URDDampingbeta::update(Vector q)
 const Vector &
 URDDampingbeta::getDampingForce(void)
 {
-  return (*qd);
+  return theState.getDampingForce();
 }
 
 double URDDampingbeta::getStiffnessMultiplier(void)
@@ -209,10 +179,7 @@ double URDDampingbeta::getStiffnessMultiplier(void)
   StaticAnalysis **theStaticAnalysis = OPS_GetStaticAnalysis();
   if (!*theStaticAnalysis && dT > 0.0 && t > ta && t < td)
   {
-    for (int i = 0; i < nFilter; ++i)
-    {
-        km += 4.0 * (*beta)(i) / (2.0 + (*omegac)(i) * dT); 
-    }
+    km = theFilters->getStiffnessMultiplier(dT);
     if (fac) km *= fac->getFactor(t);
   }
   return 1.0 + km;
@@ -226,6 +193,10 @@ Damping *URDDampingbeta::getCopy(void)
 
   theCopy = new URDDampingbeta(this->getTag(), nFilter, omegac, beta, ta, td, fac);
 
+  // the copies share the filter coefficients of this definition
+  if (!theFilters) this->setFilters();
+  theCopy->theFilters = theFilters;
+
   return theCopy;
 }
 
@@ -335,6 +306,7 @@ URDDampingbeta::recvSelf(int cTag, Channel &theChannel, FEM_ObjectBroker &theBro
   *beta = databeta;
 
   Initialize();
+  theFilters.reset();
   return 0;
 }
 
@@ -55,7 +55,7 @@ public:
   int Initialize(void);
   
   int setDomain(Domain *domain, int nComp);
-  int update(Vector q);
+  int update(const Vector &q);
   
   int commitState(void);
   int revertToLastCommit(void);    
@@ -78,9 +78,11 @@ private:
   double ta, td;
   TimeSeries *fac;
   Vector *beta, *omegac;
-  Matrix *qL, *qLC;
-  Vector *qd, *qdC, *q0, *q0C;
+  std::shared_ptr<DampingFilterBank> theFilters;
+  DampingFilterState theState;
   Domain *theDomain;
+
+  void setFilters(void);
 };
 
 #endif
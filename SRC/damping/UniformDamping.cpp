@@ -65,7 +65,7 @@ UniformDamping::UniformDamping(int tag, double cd, double f1, double f2, double
 Damping(tag, DMP_TAG_UniformDamping),
 nComp(0), nFilter(0),
 eta(cd), freq1(f1), freq2(f2), ta(t1), td(t2), fac(f),
-alpha(0), omegac(0), qL(0), qLC(0), qd(0), qdC(0), q0(0), q0C(0)
+alpha(0), omegac(0), theFilters(), theState()
 {
   if (eta <= 0.0) opserr << "UniformDamping::UniformDamping:  Invalid damping ratio\n";
   if (freq1 <= 0.0 || freq2 <= 0.0 || freq1 >= freq2)
@@ -79,7 +79,7 @@ UniformDamping::UniformDamping(int tag, double cd, double f1, double f2, double
 Damping(tag, DMP_TAG_UniformDamping),
 nComp(0), nFilter(0),
 eta(cd), freq1(f1), freq2(f2), ta(t1), td(t2), fac(f),
-alpha(0), omegac(0), qL(0), qLC(0), qd(0), qdC(0), q0(0), q0C(0)
+alpha(0), omegac(0), theFilters(), theState()
 {
   if (eta <= 0.0) opserr << "UniformDamping::UniformDamping:  Invalid damping ratio\n";
   if (freq1 <= 0.0 || freq2 <= 0.0 || freq1 >= freq2)
@@ -103,7 +103,7 @@ UniformDamping::UniformDamping():
 Damping(0, DMP_TAG_UniformDamping),
 nComp(0), nFilter(0),
 eta(0.0), freq1(0.0), freq2(0.0), ta(0.0), td(0.0), fac(0),
-alpha(0), omegac(0), qL(0), qLC(0), qd(0), qdC(0), q0(0), q0C(0)
+alpha(0), omegac(0), theFilters(), theState()
 {
 
 }
@@ -115,12 +115,6 @@ UniformDamping::~UniformDamping()
   if (fac) delete fac;
   if (alpha) delete alpha;
   if (omegac) delete omegac;
-  if (qL) delete qL;
-  if (qLC) delete qLC;
-  if (qd) delete qd;
-  if (qdC) delete qdC;
-  if (q0) delete q0;
-  if (q0C) delete q0C;
 }
 
 int
@@ -198,9 +192,7 @@ UniformDamping::Initialize(void)
 int
 UniformDamping::commitState(void)
 {
-  *qdC = *qd;
-  *q0C = *q0;
-  *qLC = *qL;
+  theState.commitState();
   return 0;
 }
 
@@ -208,9 +200,7 @@ UniformDamping::commitState(void)
 int
 UniformDamping::revertToLastCommit(void)
 {
-  *qd = *qdC;
-  *q0 = *q0C;
-  *qL = *qLC;
+  theState.revertToLastCommit();
   return 0;
 }
 
@@ -218,12 +208,7 @@ UniformDamping::revertToLastCommit(void)
 int
 UniformDamping::revertToStart(void)
 {
-  (*qd).Zero();
-  (*qdC).Zero();
-  (*q0).Zero();
-  (*q0C).Zero();
-  (*qL).Zero();
-  (*qLC).Zero();
+  theState.revertToStart();
   return 0;
 }
 
@@ -234,60 +219,45 @@ UniformDamping::setDomain(Domain *domain, int nC)
   theDomain = domain;
   nComp = nC;
   
-  qd = new Vector(nComp);
-  qdC = new Vector(nComp);
-  q0 = new Vector(nComp);
-  q0C = new Vector(nComp);
-  qL = new Matrix(nComp, nFilter);
-  qLC = new Matrix(nComp, nFilter);
+  if (!theFilters) this->setFilters();
+  theState.setSize(nComp, nFilter);
   
   return 0;
 }
 
 
+void
+UniformDamping::setFilters(void)
+{
+  std::vector<double> gain(nFilter);
+  for (int i = 0; i < nFilter; ++i)
+    gain[i] = (*alpha)(i) * eta;
+  theFilters = std::make_shared<DampingFilterBank>(nFilter, &gain[0], &(*omegac)(0));
+}
+
+
 int
-UniformDamping::update(Vector q)
+UniformDamping::update(const Vector &q)
 {
   double t = theDomain->getCurrentTime();
   double dT = theDomain->getDT();
   StaticAnalysis **theStaticAnalysis = OPS_GetStaticAnalysis();
   if (*theStaticAnalysis)
   {
-    *q0 = q;
-    (*qd).Zero();
-    for (int i = 0; i < nFilter; ++i)
-      for (int j = 0; j < nComp; ++j)
-        (*qL)(j,i) = q(j);
+    theState.resetFilters(q);
   }
   else if (dT > 0.0)
   {
-    *q0 = q;
-    (*qd).Zero();
     if (t < td)
     {
       if (t > ta)
-      {
-        for (int i = 0; i < nFilter; ++i)
-        {
-          double dTomegac = dT * (*omegac)(i);
-          double cd = 4.0 * (*alpha)(i) * eta / (2.0 + dTomegac);
-          double c0 = dTomegac / (2.0 + dTomegac);
-          double cL = (2.0 - dTomegac) / (2.0 + dTomegac);
-          for (int j = 0; j < nComp; ++j)
-          {
-            (*qd)(j) += cd * ((*q0C)(j) + (*q0)(j) - 2.0 * (*qLC)(j,i));
-            (*qL)(j,i) = c0 * ((*q0C)(j) + (*q0)(j)) + cL * (*qLC)(j,i);
-          }
-        }
-        *qd -= *qdC;
-      }
+        theState.filter(q, theFilters->getCoefficients(dT), fac ? fac->getFactor(t) : 1.0);
       else
-      {
-        for (int i = 0; i < nFilter; ++i)
-          for (int j = 0; j < nComp; ++j)
-            (*qL)(j,i) = q(j);
-      }
-      if (fac) *qd *= fac->getFactor(t);
+        theState.resetFilters(q);
+    }
+    else
+    {
+      theState.setInput(q);
     }
   }
   return 0;
@@ -296,7 +266,7 @@ UniformDamping::update(Vector q)
 const Vector &
 UniformDamping::getDampingForce(void)
 {
-  return (*qd);
+  return theState.getDampingForce();
 }
 
 double UniformDamping::getStiffnessMultiplier(void)
@@ -307,10 +277,7 @@ double UniformDamping::getStiffnessMultiplier(void)
   StaticAnalysis **theStaticAnalysis = OPS_GetStaticAnalysis();
   if (!*theStaticAnalysis && dT > 0.0 && t > ta && t < td)
   {
-    for (int i = 0; i < nFilter; ++i)
-    {
-      km += 4.0 * (*alpha)(i) * eta / (2.0 + (*omegac)(i) * dT);
-    }
+    km = theFilters->getStiffnessMultiplier(dT);
     if (fac) km *= fac->getFactor(t);
   }
   return 1.0 + km;
@@ -324,6 +291,10 @@ Damping *UniformDamping::getCopy(void)
 
   theCopy = new UniformDamping(this->getTag(), eta, freq1, freq2, ta, td, fac, nFilter, alpha, omegac);
 
+  // the copies share the filter coefficients of this definition
+  if (!theFilters) this->setFilters();
+  theCopy->theFilters = theFilters;
+
   return theCopy;
 }
 
@@ -427,6 +398,7 @@ UniformDamping::recvSelf(int cTag, Channel &theChannel, FEM_ObjectBroker &theBro
     opserr << "UniformDamping::recvSelf:  Invalid frequency range\n";
   
   Initialize();
+  theFilters.reset();
   return 0;
 }
 
@@ -69,7 +69,7 @@ public:
   int Initialize(void);
   
   int setDomain(Domain *domain, int nComp);
-  int update(Vector q);
+  int update(const Vector &q);
   
   int commitState(void);
   int revertToLastCommit(void);    
@@ -92,9 +92,11 @@ private:
   double eta, freq1, freq2, ta, td;
   TimeSeries *fac;
   Vector *alpha, *omegac;
-  Matrix *qL, *qLC;
-  Vector *qd, *qdC, *q0, *q0C;
+  std::shared_ptr<DampingFilterBank> theFilters;
+  DampingFilterState theState;
   Domain *theDomain;
+
+  void setFilters(void);
 };
 
 #endif
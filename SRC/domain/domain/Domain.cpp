@@ -34,6 +34,7 @@
 
 #include <stdlib.h>
 #include <math.h>
+#include <string.h>
 
 #include <OPS_Globals.h>
 #include <Domain.h>
@@ -45,6 +46,7 @@
 #include <NodalLoadIter.h>
 #include <Element.h>
 #include <Node.h>
+#include <classTags.h>
 #include <SP_Constraint.h>
 #include <Pressure_Constraint.h>
 #include <MP_Constraint.h>
@@ -98,12 +100,14 @@ Domain::Domain()
  dbEle(0), dbNod(0), dbSPs(0), dbPCs(0), dbMPs(0), dbLPs(0), dbParam(0),
  eleGraphBuiltFlag(false),  nodeGraphBuiltFlag(false), theNodeGraph(0), 
  theElementGraph(0), 
- theRegions(0), numRegions(0), commitTag(0), initBounds(true), resetBounds(false),
+ theRegions(0), numRegions(0), commitTag(0), recordOnCommit(true), initBounds(true), resetBounds(false),
  theBounds(6), theEigenvalues(0), theEigenvalueSetTime(0), 
  theModalProperties(0),
  theModalDampingFactors(0), inclModalMatrix(false),
  lastChannel(0),
- paramIndex(0), paramSize(0), numParameters(0)
+ paramIndex(0), paramSize(0), numParameters(0),
+ nodalState(0), nodalStateSize(0), nodalStateTag(-1), stateNodes(0),
+ numStateNodes(0), numOtherNodes(0)
 {
   
     // init the arrays for storing the domain components
@@ -154,11 +158,13 @@ Domain::Domain(int numNodes, int numElements, int numSPs, int numMPs,
  dbEle(0), dbNod(0), dbSPs(0), dbPCs(0), dbMPs(0), dbLPs(0), dbParam(0),
  eleGraphBuiltFlag(false), nodeGraphBuiltFlag(false), theNodeGraph(0), 
  theElementGraph(0),
- theRegions(0), numRegions(0), commitTag(0), initBounds(true), resetBounds(false),
+ theRegions(0), numRegions(0), commitTag(0), recordOnCommit(true), initBounds(true), resetBounds(false),
  theBounds(6), theEigenvalues(0), theEigenvalueSetTime(0), 
  theModalProperties(0),
  theModalDampingFactors(0), inclModalMatrix(false),
- lastChannel(0), paramIndex(0), paramSize(0), numParameters(0)
+ lastChannel(0), paramIndex(0), paramSize(0), numParameters(0),
+ nodalState(0), nodalStateSize(0), nodalStateTag(-1), stateNodes(0),
+ numStateNodes(0), numOtherNodes(0)
 {
     // init the arrays for storing the domain components
     theElements = new MapOfTaggedObjects();
@@ -215,11 +221,13 @@ Domain::Domain(TaggedObjectStorage &theNodesStorage,
  theSPs(&theSPsStorage),
  theMPs(&theMPsStorage), 
  theLoadPatterns(&theLoadPatternsStorage),
- theRegions(0), numRegions(0), commitTag(0), initBounds(true), resetBounds(false),
+ theRegions(0), numRegions(0), commitTag(0), recordOnCommit(true), initBounds(true), resetBounds(false),
  theBounds(6), theEigenvalues(0), theEigenvalueSetTime(0), 
  theModalProperties(0),
  theModalDampingFactors(0), inclModalMatrix(false),
- lastChannel(0),paramIndex(0), paramSize(0), numParameters(0)
+ lastChannel(0),paramIndex(0), paramSize(0), numParameters(0),
+ nodalState(0), nodalStateSize(0), nodalStateTag(-1), stateNodes(0),
+ numStateNodes(0), numOtherNodes(0)
 {
     // init the arrays for storing the domain components
     thePCs      = new MapOfTaggedObjects();
@@ -274,11 +282,13 @@ Domain::Domain(TaggedObjectStorage &theStorage)
  dbEle(0), dbNod(0), dbSPs(0), dbPCs(0), dbMPs(0), dbLPs(0), dbParam(0),
  eleGraphBuiltFlag(false), nodeGraphBuiltFlag(false), theNodeGraph(0), 
  theElementGraph(0), 
- theRegions(0), numRegions(0), commitTag(0),initBounds(true), resetBounds(false),
+ theRegions(0), numRegions(0), commitTag(0), recordOnCommit(true), initBounds(true), resetBounds(false),
  theBounds(6), theEigenvalues(0), theEigenvalueSetTime(0), 
  theModalProperties(0),
  theModalDampingFactors(0), inclModalMatrix(false),
- lastChannel(0),paramIndex(0), paramSize(0), numParameters(0)
+ lastChannel(0),paramIndex(0), paramSize(0), numParameters(0),
+ nodalState(0), nodalStateSize(0), nodalStateTag(-1), stateNodes(0),
+ numStateNodes(0), numOtherNodes(0)
 {
     // init the arrays for storing the domain components
     theStorage.clearAll(); // clear the storage just in case populated
@@ -391,6 +401,8 @@ Domain::~Domain()
 
   if (theModalDampingFactors != 0)
     delete theModalDampingFactors;
+
+  this->clearNodalState();
   
   int i;
   for (i=0; i<numRecorders; i++) 
@@ -566,16 +578,7 @@ Domain::addSP_Constraint(SP_Constraint *spConstraint)
     // #endif
 
     // check if an existing SP_COnstraint exists for that dof at the node
-    bool found = false;
-    SP_ConstraintIter &theExistingSPs = this->getSPs();
-    SP_Constraint *theExistingSP = 0;
-    while ((found == false) && ((theExistingSP = theExistingSPs()) != 0)) {
-      int spNodeTag = theExistingSP->getNodeTag();
-      int spDof = theExistingSP->getDOF_Number();
-      if (nodeTag == spNodeTag && spDof == dof) {
-	found = true;
-      }
-    }
+    bool found = (theSP_Dofs.count(std::make_pair(nodeTag, dof)) != 0);
     
     if (found == true) {
 	opserr << "Domain::addSP_Constraint - cannot add as node already constrained in that dof by existing SP_Constraint\n";
@@ -601,6 +604,7 @@ Domain::addSP_Constraint(SP_Constraint *spConstraint)
       return false;
   } 
 
+  theSP_Dofs.insert(std::make_pair(nodeTag, dof));
   spConstraint->setDomain(this);
   this->domainChange();  
 
@@ -981,7 +985,9 @@ Domain::clearAll(void) {
   // clean out the containers
   theElements->clearAll();
   theNodes->clearAll();
+  this->clearNodalState();
   theSPs->clearAll();
+  theSP_Dofs.clear();
   thePCs->clearAll();
   theMPs->clearAll();
   theLoadPatterns->clearAll();
@@ -1166,6 +1172,7 @@ Domain::removeSP_Constraint(int tag)
     // perform a downward cast, set the objects domain pointer to 0
     // and return the result of the cast    
     SP_Constraint *result = (SP_Constraint *)mc;
+    theSP_Dofs.erase(std::make_pair(result->getNodeTag(), result->getDOF_Number()));
     // result->setDomain(0);
 
     // should check that theLoad and result are the same    
@@ -2003,12 +2010,24 @@ int
 Domain::commit(void)
 {
     // 
-    // first invoke commit on all nodes and elements in the domain
+    // first invoke commit on all nodes and elements in the domain,
+    // the nodes in the nodal state arrays are committed in bulk
     //
+    this->formNodalState();
+    if (nodalState != 0) {
+      int n = nodalStateSize;
+      memcpy(&nodalState[n], nodalState, n*sizeof(double));
+      memset(&nodalState[2*n], 0, 2*n*sizeof(double));
+      memcpy(&nodalState[5*n], &nodalState[4*n], n*sizeof(double));
+      memcpy(&nodalState[7*n], &nodalState[6*n], n*sizeof(double));
+    }
+
     Node *nodePtr;
-    NodeIter &theNodeIter = this->getNodes();
-    while ((nodePtr = theNodeIter()) != 0) {
-      nodePtr->commitState();
+    if (numOtherNodes != 0) {
+      NodeIter &theNodeIter = this->getNodes();
+      while ((nodePtr = theNodeIter()) != 0)
+	if (nodePtr->getClassTag() != NOD_TAG_Node)
+	  nodePtr->commitState();
     }
 
     Element *elePtr;
@@ -2022,9 +2041,10 @@ Domain::commit(void)
     dT = 0.0;
 
     // invoke record on all recorders
-    for (int i=0; i<numRecorders; i++)
-      if (theRecorders[i] != 0)
-	theRecorders[i]->record(commitTag, currentTime);
+    if (recordOnCommit)
+      for (int i=0; i<numRecorders; i++)
+	if (theRecorders[i] != 0)
+	  theRecorders[i]->record(commitTag, currentTime);
 
     // update the commitTag
     commitTag++;
@@ -2038,10 +2058,22 @@ Domain::revertToLastCommit(void)
     // first invoke revertToLastCommit  on all nodes and elements in the domain
     //
     
+    this->formNodalState();
+    if (nodalState != 0) {
+      int n = nodalStateSize;
+      memcpy(nodalState, &nodalState[n], n*sizeof(double));
+      memset(&nodalState[2*n], 0, 2*n*sizeof(double));
+      memcpy(&nodalState[4*n], &nodalState[5*n], n*sizeof(double));
+      memcpy(&nodalState[6*n], &nodalState[7*n], n*sizeof(double));
+    }
+
     Node *nodePtr;
-    NodeIter &theNodeIter = this->getNodes();
-    while ((nodePtr = theNodeIter()) != 0)
-	nodePtr->revertToLastCommit();
+    if (numOtherNodes != 0) {
+      NodeIter &theNodeIter = this->getNodes();
+      while ((nodePtr = theNodeIter()) != 0)
+	if (nodePtr->getClassTag() != NOD_TAG_Node)
+	  nodePtr->revertToLastCommit();
+    }
     
     Element *elePtr;
     ElementIter &theElemIter = this->getElements();    
@@ -2067,10 +2099,21 @@ Domain::revertToStart(void)
     // elements in the domain
     //
 
+    this->formNodalState();
+    if (nodalState != 0)
+      memset(nodalState, 0, 8*nodalStateSize*sizeof(double));
+
+    // the nodes in the arrays still zero their loads and sensitivities
     Node *nodePtr;
     NodeIter &theNodeIter = this->getNodes();
-    while ((nodePtr = theNodeIter()) != 0) 
+    while ((nodePtr = theNodeIter()) != 0) {
+      if (nodePtr->getClassTag() != NOD_TAG_Node || nodalState == 0)
 	nodePtr->revertToStart();
+      else {
+	nodePtr->zeroUnbalancedLoad();
+	nodePtr->zeroSensitivity();
+      }
+    }
 
     Element *elePtr;
     ElementIter &theElements = this->getElements();    
@@ -2095,6 +2138,109 @@ Domain::revertToStart(void)
     return this->update();
 }
 
+// formNodalState():
+//	Method to place the response quantities of the nodes in contiguous
+//	arrays owned by the domain, so commit(), revertToLastCommit() and
+//	revertToStart() are a few block copies instead of a call on every
+//	node. The arrays are formed again when the domain has changed; nodes
+//	of a subclass of Node keep their own state.
+
+int
+Domain::formNodalState(void)
+{
+  if (hasDomainChangedFlag == false && nodalStateTag == currentGeoTag)
+    return 0;
+  int geoTag = currentGeoTag;
+
+  // count the nodes & dof, the arrays are kept if the nodes are the same
+  int numNodes = 0;
+  int numOther = 0;
+  int numDOF = 0;
+  bool same = true;
+  Node *nodePtr;
+  NodeIter &theNodeIter = this->getNodes();
+  while ((nodePtr = theNodeIter()) != 0) {
+    if (nodePtr->getClassTag() != NOD_TAG_Node) {
+      numOther++;
+      continue;
+    }
+    if (numNodes >= numStateNodes || stateNodes[numNodes] != nodePtr)
+      same = false;
+    numNodes++;
+    numDOF += nodePtr->getNumberDOF();
+  }
+
+  nodalStateTag = geoTag;
+  numOtherNodes = numOther;
+  if (same == true && numNodes == numStateNodes)
+    return 0;
+
+  this->clearNodalState();
+  if (numNodes == 0 || numDOF == 0)
+    return 0;
+
+  nodalState = new double[8*numDOF];
+  stateNodes = new Node *[numNodes];
+  if (nodalState == 0 || stateNodes == 0) {
+    opserr << "WARNING Domain::formNodalState() - out of memory for ";
+    opserr << numDOF << " nodal dof, the nodes keep their own state\n";
+    this->clearNodalState();
+    nodalStateTag = geoTag;
+    return -1;
+  }
+  nodalStateSize = numDOF;
+
+  int loc = 0;
+  NodeIter &theNodes = this->getNodes();
+  while ((nodePtr = theNodes()) != 0) {
+    if (nodePtr->getClassTag() != NOD_TAG_Node)
+      continue;
+    stateNodes[numStateNodes] = nodePtr;
+    if (nodePtr->setStateStorage(this, numStateNodes, &nodalState[loc], numDOF) < 0) {
+      opserr << "WARNING Domain::formNodalState() - failed for node ";
+      opserr << nodePtr->getTag() << endln;
+      numStateNodes++;
+      this->clearNodalState();
+      nodalStateTag = geoTag;
+      return -2;
+    }
+    numStateNodes++;
+    loc += nodePtr->getNumberDOF();
+  }
+
+  return 0;
+}
+
+// removeNodalState(int slot):
+//	Method invoked by a node leaving the nodal state arrays.
+
+void
+Domain::removeNodalState(int slot)
+{
+  if (slot >= 0 && slot < numStateNodes)
+    stateNodes[slot] = 0;
+}
+
+void
+Domain::clearNodalState(void)
+{
+  // the nodes still in the arrays take their state back
+  for (int i=0; i<numStateNodes; i++)
+    if (stateNodes[i] != 0)
+      stateNodes[i]->releaseStateStorage();
+
+  if (stateNodes != 0)
+    delete [] stateNodes;
+  if (nodalState != 0)
+    delete [] nodalState;
+
+  stateNodes = 0;
+  nodalState = 0;
+  numStateNodes = 0;
+  nodalStateSize = 0;
+  nodalStateTag = -1;
+}
+
 int
 Domain::update(void)
 {
@@ -2120,6 +2266,28 @@ Domain::update(void)
 }
 
 
+// updates only the given elements, for a local update in a Newton
+// iteration where the other elements are known not to change
+int
+Domain::update(const std::vector<Element *> &theElements)
+{
+  // set the global constants
+  ops_Dt = dT;
+  ops_TheActiveDomain = this;
+
+  int ok = 0;
+  for (std::size_t i = 0; i < theElements.size(); i++) {
+    ops_TheActiveElement = theElements[i];
+    ok += theElements[i]->update();
+  }
+
+  if (ok != 0)
+    opserr << "Domain::update - domain failed in local update\n";
+
+  return ok;
+}
+
+
 int
 Domain::update(double newTime, double dT)
 {
@@ -2491,6 +2659,18 @@ Domain::removeRecorders(void)
     return 0;
 }
 
+void
+Domain::setRecordOnCommit(bool onOff)
+{
+  recordOnCommit = onOff;
+}
+
+bool
+Domain::getRecordOnCommit(void)
+{
+  return recordOnCommit;
+}
+
 int Domain::flushRecorders() {
     for (int i = 0; i < numRecorders; i++) {
       if (theRecorders[i] != 0) {
@@ -38,6 +38,9 @@
 
 #include <OPS_Stream.h>
 #include <Vector.h>
+#include <set>
+#include <utility>
+#include <vector>
 
 class Element;
 class Node;
@@ -189,6 +192,11 @@ class Domain
     virtual  int  revertToLastCommit(void);
     virtual  int  revertToStart(void);    
     virtual  int  update(void);
+    virtual  int  update(const std::vector<Element *> &theElements);
+
+    // methods for the contiguous nodal state arrays
+    virtual  int  formNodalState(void);
+    void removeNodalState(int slot);
     virtual  int  update(double newTime, double dT);
     virtual  int  updateParameter(int tag, int value);
     virtual  int  updateParameter(int tag, double value);    
@@ -220,6 +228,8 @@ class Domain
     virtual int  removeRecorder(int tag);
     virtual int  record(bool fromAnalysis=true);
     virtual int flushRecorders();
+    virtual void setRecordOnCommit(bool onOff);  // recorders invoked in commit()
+    virtual bool getRecordOnCommit(void);
 
     virtual int  addRegion(MeshRegion &theRegion);    	
     virtual MeshRegion *getRegion(int region);    	
@@ -253,6 +263,8 @@ class Domain
     int numRecorders;    
 
   private:
+    void clearNodalState(void);
+
     double currentTime;               // current pseudo time
     double committedTime;             // the committed pseudo time
     double dT;                        // difference between committed and current time
@@ -289,6 +301,7 @@ class Domain
     int numRegions;    
 
     int commitTag;
+    bool recordOnCommit;
     
     Vector theBounds;
     bool initBounds; // added to fix bug when all nodes are positive or negative - ambaker1
@@ -309,6 +322,19 @@ class Domain
     enum {paramSize_grow = 20};
     int paramSize;
     int numParameters;
+
+    // the nodal response quantities of all plain nodes, 8 arrays of
+    // nodalStateSize one after the other (see Node::setStateStorage)
+    double *nodalState;
+    int nodalStateSize;
+    int nodalStateTag;                // geo tag of the domain when formed
+    Node **stateNodes;                // the nodes in the arrays, by slot
+    int numStateNodes;
+    int numOtherNodes;                // nodes that keep their own state
+
+    // the (node, dof) pairs constrained by the single point constraints
+    // of the domain, for the duplicate check in addSP_Constraint()
+    std::set<std::pair<int, int> > theSP_Dofs;
 };
 
 #endif
@@ -1042,6 +1042,15 @@ PartitionedDomain::update(void)
 }
 
 
+// the elements of the subdomains are not known here, so a local update
+// is done as a full one
+int
+PartitionedDomain::update(const std::vector<Element *> &theElements)
+{
+  return this->update();
+}
+
+
 #ifdef _PARALLEL_PROCESSING
 int
 PartitionedDomain::barrierCheck(int res)
@@ -109,6 +109,7 @@ class PartitionedDomain: public Domain
     virtual  int revertToStart(void);    
 
     virtual  int update(void);        
+    virtual  int update(const std::vector<Element *> &theElements);
     virtual  int update(double newTime, double dT);
 
     virtual  int analysisStep(double dT);
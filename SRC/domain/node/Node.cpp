@@ -213,7 +213,8 @@ Node::Node(int theClassTag)
  Crd(0), commitDisp(0), commitVel(0), commitAccel(0), 
  trialDisp(0), trialVel(0), trialAccel(0), unbalLoad(0), incrDisp(0), 
  incrDeltaDisp(0),
- disp(0), vel(0), accel(0), dbTag1(0), dbTag2(0), dbTag3(0), dbTag4(0),
+ disp(0), vel(0), accel(0), stateStride(0), stateOwner(0), stateSlot(-1),
+ dbTag1(0), dbTag2(0), dbTag3(0), dbTag4(0),
  R(0), mass(0), unbalLoadWithInertia(0), alphaM(0.0), theEigenvectors(0), 
  index(-1), reaction(0), displayLocation(0)
 {
@@ -236,7 +237,8 @@ Node::Node(int tag, int theClassTag)
  Crd(0), commitDisp(0), commitVel(0), commitAccel(0), 
  trialDisp(0), trialVel(0), trialAccel(0), unbalLoad(0), incrDisp(0),
  incrDeltaDisp(0), 
- disp(0), vel(0), accel(0), dbTag1(0), dbTag2(0), dbTag3(0), dbTag4(0),
+ disp(0), vel(0), accel(0), stateStride(0), stateOwner(0), stateSlot(-1),
+ dbTag1(0), dbTag2(0), dbTag3(0), dbTag4(0),
   R(0), mass(0), unbalLoadWithInertia(0), alphaM(0.0), theEigenvectors(0), 
  index(-1), reaction(0), displayLocation(0)
 {
@@ -259,7 +261,8 @@ Node::Node(int tag, int ndof, double Crd1, Vector *dLoc)
  Crd(0), commitDisp(0), commitVel(0), commitAccel(0), 
  trialDisp(0), trialVel(0), trialAccel(0), unbalLoad(0), incrDisp(0),
  incrDeltaDisp(0), 
- disp(0), vel(0), accel(0), dbTag1(0), dbTag2(0), dbTag3(0), dbTag4(0),
+ disp(0), vel(0), accel(0), stateStride(0), stateOwner(0), stateSlot(-1),
+ dbTag1(0), dbTag2(0), dbTag3(0), dbTag4(0),
  R(0), mass(0), unbalLoadWithInertia(0), alphaM(0.0), theEigenvectors(0), 
  index(-1), reaction(0), displayLocation(0)
 {
@@ -291,7 +294,8 @@ Node::Node(int tag, int ndof, double Crd1, double Crd2, Vector *dLoc)
  Crd(0), commitDisp(0), commitVel(0), commitAccel(0), 
  trialDisp(0), trialVel(0), trialAccel(0), unbalLoad(0), incrDisp(0),
  incrDeltaDisp(0), 
- disp(0), vel(0), accel(0), dbTag1(0), dbTag2(0), dbTag3(0), dbTag4(0),
+ disp(0), vel(0), accel(0), stateStride(0), stateOwner(0), stateSlot(-1),
+ dbTag1(0), dbTag2(0), dbTag3(0), dbTag4(0),
  R(0), mass(0), unbalLoadWithInertia(0), alphaM(0.0), theEigenvectors(0),
  reaction(0), displayLocation(0)
 {
@@ -325,7 +329,8 @@ Node::Node(int tag, int ndof, double Crd1, double Crd2, Vector *dLoc)
  Crd(0), commitDisp(0), commitVel(0), commitAccel(0), 
  trialDisp(0), trialVel(0), trialAccel(0), unbalLoad(0), incrDisp(0),
  incrDeltaDisp(0), 
- disp(0), vel(0), accel(0), dbTag1(0), dbTag2(0), dbTag3(0), dbTag4(0),
+ disp(0), vel(0), accel(0), stateStride(0), stateOwner(0), stateSlot(-1),
+ dbTag1(0), dbTag2(0), dbTag3(0), dbTag4(0),
  R(0), mass(0), unbalLoadWithInertia(0), alphaM(0.0), theEigenvectors(0),
  reaction(0), displayLocation(0)
 {
@@ -360,7 +365,8 @@ Node::Node(const Node &otherNode, bool copyMass)
  Crd(0), commitDisp(0), commitVel(0), commitAccel(0), 
  trialDisp(0), trialVel(0), trialAccel(0), unbalLoad(0), incrDisp(0),
  incrDeltaDisp(0), 
- disp(0), vel(0), accel(0), dbTag1(0), dbTag2(0), dbTag3(0), dbTag4(0),
+ disp(0), vel(0), accel(0), stateStride(0), stateOwner(0), stateSlot(-1),
+ dbTag1(0), dbTag2(0), dbTag3(0), dbTag4(0),
  R(0), mass(0), unbalLoadWithInertia(0), alphaM(0.0), theEigenvectors(0),
    reaction(0), displayLocation(0)
 {
@@ -388,8 +394,9 @@ Node::Node(const Node &otherNode, bool copyMass)
       opserr << " FATAL Node::Node(node *) - ran out of memory for displacement\n";
       exit(-1);
     }
-    for (int i=0; i<4*numberDOF; i++)
-      disp[i] = otherNode.disp[i];
+    for (int j=0; j<4; j++)
+      for (int i=0; i<numberDOF; i++)
+	disp[i+j*numberDOF] = otherNode.disp[i+j*otherNode.stateStride];
   }    
   
   if (otherNode.commitVel != 0) {
@@ -397,8 +404,9 @@ Node::Node(const Node &otherNode, bool copyMass)
       opserr << " FATAL Node::Node(node *) - ran out of memory for velocity\n";
       exit(-1);
     }
-    for (int i=0; i<2*numberDOF; i++)
-      vel[i] = otherNode.vel[i];
+    for (int j=0; j<2; j++)
+      for (int i=0; i<numberDOF; i++)
+	vel[i+j*numberDOF] = otherNode.vel[i+j*otherNode.stateStride];
   }    
   
   if (otherNode.commitAccel != 0) {
@@ -406,8 +414,9 @@ Node::Node(const Node &otherNode, bool copyMass)
       opserr << " FATAL Node::Node(node *) - ran out of memory for acceleration\n";
       exit(-1);
     }
-    for (int i=0; i<2*numberDOF; i++)
-      accel[i] = otherNode.accel[i];
+    for (int j=0; j<2; j++)
+      for (int i=0; i<numberDOF; i++)
+	accel[i+j*numberDOF] = otherNode.accel[i+j*otherNode.stateStride];
   }    
   
   
@@ -445,6 +454,10 @@ Node::Node(const Node &otherNode, bool copyMass)
 
 Node::~Node()
 {
+    // if the domain holds the response quantities, drop out of its list
+    if (stateOwner != 0)
+      stateOwner->removeNodalState(stateSlot);
+
     // delete anything that we created with new
     if (Crd != 0)
 	delete Crd;
@@ -476,13 +489,13 @@ Node::~Node()
     if (unbalLoad != 0)
 	delete unbalLoad;
     
-    if (disp != 0)
+    if (disp != 0 && stateOwner == 0)
 	delete [] disp;
 
-    if (vel != 0)
+    if (vel != 0 && stateOwner == 0)
 	delete [] vel;
 
-    if (accel != 0)
+    if (accel != 0 && stateOwner == 0)
 	delete [] accel;
 
     if (mass != 0)
@@ -702,8 +715,8 @@ Node::setTrialDisp(double value, int dof)
     // perform the assignment .. we don't go through Vector interface
     // as we are sure of size and this way is quicker
     double tDisp = value;
-    disp[dof+2*numberDOF] = tDisp - disp[dof+numberDOF];
-    disp[dof+3*numberDOF] = tDisp - disp[dof];	
+    disp[dof+2*stateStride] = tDisp - disp[dof+stateStride];
+    disp[dof+3*stateStride] = tDisp - disp[dof];	
     disp[dof] = tDisp;
 
     return 0;
@@ -733,8 +746,8 @@ Node::setTrialDisp(const Vector &newTrialDisp)
     // as we are sure of size and this way is quicker
     for (int i=0; i<numberDOF; i++) {
         double tDisp = newTrialDisp(i);
-	disp[i+2*numberDOF] = tDisp - disp[i+numberDOF];
-	disp[i+3*numberDOF] = tDisp - disp[i];	
+	disp[i+2*stateStride] = tDisp - disp[i+stateStride];
+	disp[i+3*stateStride] = tDisp - disp[i];	
 	disp[i] = tDisp;
     }
 
@@ -809,8 +822,8 @@ Node::incrTrialDisp(const Vector &incrDispl)
 	for (int i = 0; i<numberDOF; i++) {
 	  double incrDispI = incrDispl(i);
 	  disp[i] = incrDispI;
-	  disp[i+2*numberDOF] = incrDispI;
-	  disp[i+3*numberDOF] = incrDispI;
+	  disp[i+2*stateStride] = incrDispI;
+	  disp[i+3*stateStride] = incrDispI;
 	}
 	return 0;
     }
@@ -819,8 +832,8 @@ Node::incrTrialDisp(const Vector &incrDispl)
     for (int i = 0; i<numberDOF; i++) {
 	  double incrDispI = incrDispl(i);
 	  disp[i] += incrDispI;
-	  disp[i+2*numberDOF] += incrDispI;
-	  disp[i+3*numberDOF] = incrDispI;
+	  disp[i+2*stateStride] += incrDispI;
+	  disp[i+3*stateStride] = incrDispI;
     }
 
     return 0;
@@ -1054,22 +1067,22 @@ Node::commitState()
     // check disp exists, if does set commit = trial, incr = 0.0
     if (trialDisp != 0) {
       for (int i=0; i<numberDOF; i++) {
-	disp[i+numberDOF] = disp[i];  
-        disp[i+2*numberDOF] = 0.0;
-        disp[i+3*numberDOF] = 0.0;
+	disp[i+stateStride] = disp[i];  
+        disp[i+2*stateStride] = 0.0;
+        disp[i+3*stateStride] = 0.0;
       }
     }		    
     
     // check vel exists, if does set commit = trial    
     if (trialVel != 0) {
       for (int i=0; i<numberDOF; i++)
-	vel[i+numberDOF] = vel[i];
+	vel[i+stateStride] = vel[i];
     }
     
     // check accel exists, if does set commit = trial        
     if (trialAccel != 0) {
       for (int i=0; i<numberDOF; i++)
-	accel[i+numberDOF] = accel[i];
+	accel[i+stateStride] = accel[i];
     }
 
     // if we get here we are done
@@ -1084,22 +1097,22 @@ Node::revertToLastCommit()
     // check disp exists, if does set trial = last commit, incr = 0
     if (disp != 0) {
       for (int i=0 ; i<numberDOF; i++) {
-	disp[i] = disp[i+numberDOF];
-	disp[i+2*numberDOF] = 0.0;
-	disp[i+3*numberDOF] = 0.0;
+	disp[i] = disp[i+stateStride];
+	disp[i+2*stateStride] = 0.0;
+	disp[i+3*stateStride] = 0.0;
       }
     }
     
     // check vel exists, if does set trial = last commit
     if (vel != 0) {
       for (int i=0 ; i<numberDOF; i++)
-	vel[i] = vel[numberDOF+i];
+	vel[i] = vel[stateStride+i];
     }
 
     // check accel exists, if does set trial = last commit
     if (accel != 0) {    
       for (int i=0 ; i<numberDOF; i++)
-	accel[i] = accel[numberDOF+i];
+	accel[i] = accel[stateStride+i];
     }
 
     // if we get here we are done
@@ -1112,20 +1125,21 @@ Node::revertToStart()
 {
     // check disp exists, if does set all to zero
     if (disp != 0) {
-      for (int i=0 ; i<4*numberDOF; i++)
-	disp[i] = 0.0;
+      for (int i=0 ; i<numberDOF; i++)
+	for (int j=0; j<4; j++)
+	  disp[i+j*stateStride] = 0.0;
     }
 
     // check vel exists, if does set all to zero
     if (vel != 0) {
-      for (int i=0 ; i<2*numberDOF; i++)
-	vel[i] = 0.0;
+      for (int i=0 ; i<numberDOF; i++)
+	vel[i] = vel[i+stateStride] = 0.0;
     }
 
     // check accel exists, if does set all to zero
     if (accel != 0) {    
-      for (int i=0 ; i<2*numberDOF; i++)
-	accel[i] = 0.0;
+      for (int i=0 ; i<numberDOF; i++)
+	accel[i] = accel[i+stateStride] = 0.0;
     }
     
     if (unbalLoad != 0) 
@@ -1135,14 +1149,7 @@ Node::revertToStart()
 
 
 // AddingSensitivity: BEGIN /////////////////////////////////
-	if (dispSensitivity != 0) 
-		dispSensitivity->Zero();
-	
-	if (velSensitivity != 0) 
-		velSensitivity->Zero();
-	
-	if (accSensitivity != 0) 
-		accSensitivity->Zero();
+    this->zeroSensitivity();
 // AddingSensitivity: END ///////////////////////////////////
 
 
@@ -1552,7 +1559,7 @@ Node::recvSelf(int cTag, Channel &theChannel,
 
       // set the trial quantities equal to committed
       for (int i=0; i<numberDOF; i++)
-	disp[i] = disp[i+numberDOF];  // set trial equal committed
+	disp[i] = disp[i+stateStride];  // set trial equal committed
 
     } else if (commitDisp != 0) {
       // if going back to initial we will just zero the vectors
@@ -1574,7 +1581,7 @@ Node::recvSelf(int cTag, Channel &theChannel,
 
       // set the trial quantity
       for (int i=0; i<numberDOF; i++)
-	vel[i] = vel[i+numberDOF];  // set trial equal committed
+	vel[i] = vel[i+stateStride];  // set trial equal committed
     }
 
     if (data(4) == 0) {
@@ -1590,7 +1597,7 @@ Node::recvSelf(int cTag, Channel &theChannel,
       
       // set the trial values
       for (int i=0; i<numberDOF; i++)
-	accel[i] = accel[i+numberDOF];  // set trial equal committed
+	accel[i] = accel[i+stateStride];  // set trial equal committed
     }
 
     if (data(5) == 0) {
@@ -1765,6 +1772,7 @@ Node::createDisp(void)
 {
   // trial , committed, incr = (committed-trial)
   disp = new double[4*numberDOF];
+  stateStride = numberDOF;
     
   if (disp == 0) {
     opserr << "WARNING - Node::createDisp() ran out of memory for array of size " << 2*numberDOF << endln;
@@ -1793,6 +1801,7 @@ int
 Node::createVel(void)
 {
     vel = new double[2*numberDOF];
+    stateStride = numberDOF;
     
     if (vel == 0) {
       opserr << "WARNING - Node::createVel() ran out of memory for array of size " << 2*numberDOF << endln;
@@ -1817,6 +1826,7 @@ int
 Node::createAccel(void)
 {
     accel = new double[2*numberDOF];
+    stateStride = numberDOF;
     
     if (accel == 0) {
       opserr << "WARNING - Node::createAccel() ran out of memory for array of size " << 2*numberDOF << endln;
@@ -1837,6 +1847,109 @@ Node::createAccel(void)
 }
 
 
+// setStateStorage() & releaseStateStorage():
+// methods to move the response quantities into the nodal state arrays of
+// a Domain and back. In the arrays the trial disp, committed disp, incr
+// disp, incr delta disp, trial vel, committed vel, trial accel and
+// committed accel of all nodes are stored one after the other, each
+// stride long; data is the start of the node's trial disp.
+
+int
+Node::setStateStorage(Domain *owner, int slot, double *data, int stride)
+{
+  // get out of any arrays the node is in now
+  if (stateOwner != 0)
+    this->releaseStateStorage();
+
+  // make sure all the quantities exist
+  if ((trialDisp == 0 && this->createDisp() < 0) ||
+      (trialVel == 0 && this->createVel() < 0) ||
+      (trialAccel == 0 && this->createAccel() < 0)) {
+    opserr << "WARNING Node::setStateStorage() - node: " << this->getTag();
+    opserr << " ran out of memory\n";
+    return -1;
+  }
+
+  // copy the current values into the new arrays
+  double *newDisp = data;
+  double *newVel = &data[4*stride];
+  double *newAccel = &data[6*stride];
+  for (int i=0; i<numberDOF; i++) {
+    for (int j=0; j<4; j++)
+      newDisp[i+j*stride] = disp[i+j*stateStride];
+    for (int j=0; j<2; j++) {
+      newVel[i+j*stride] = vel[i+j*stateStride];
+      newAccel[i+j*stride] = accel[i+j*stateStride];
+    }
+  }
+
+  delete [] disp;
+  delete [] vel;
+  delete [] accel;
+
+  disp = newDisp;
+  vel = newVel;
+  accel = newAccel;
+  stateStride = stride;
+  stateOwner = owner;
+  stateSlot = slot;
+
+  trialDisp->setData(disp, numberDOF);
+  commitDisp->setData(&disp[stride], numberDOF);
+  incrDisp->setData(&disp[2*stride], numberDOF);
+  incrDeltaDisp->setData(&disp[3*stride], numberDOF);
+  trialVel->setData(vel, numberDOF);
+  commitVel->setData(&vel[stride], numberDOF);
+  trialAccel->setData(accel, numberDOF);
+  commitAccel->setData(&accel[stride], numberDOF);
+
+  return 0;
+}
+
+int
+Node::releaseStateStorage(void)
+{
+  if (stateOwner == 0)
+    return 0;
+
+  double *oldDisp = disp;
+  double *oldVel = vel;
+  double *oldAccel = accel;
+  int oldStride = stateStride;
+
+  stateOwner->removeNodalState(stateSlot);
+  stateOwner = 0;
+  stateSlot = -1;
+
+  // copy the values into arrays of the node's own; the Vectors are kept,
+  // so references to them stay valid
+  disp = new double[4*numberDOF];
+  vel = new double[2*numberDOF];
+  accel = new double[2*numberDOF];
+  stateStride = numberDOF;
+
+  for (int i=0; i<numberDOF; i++) {
+    for (int j=0; j<4; j++)
+      disp[i+j*numberDOF] = oldDisp[i+j*oldStride];
+    for (int j=0; j<2; j++) {
+      vel[i+j*numberDOF] = oldVel[i+j*oldStride];
+      accel[i+j*numberDOF] = oldAccel[i+j*oldStride];
+    }
+  }
+
+  trialDisp->setData(disp, numberDOF);
+  commitDisp->setData(&disp[numberDOF], numberDOF);
+  incrDisp->setData(&disp[2*numberDOF], numberDOF);
+  incrDeltaDisp->setData(&disp[3*numberDOF], numberDOF);
+  trialVel->setData(vel, numberDOF);
+  commitVel->setData(&vel[numberDOF], numberDOF);
+  trialAccel->setData(accel, numberDOF);
+  commitAccel->setData(&accel[numberDOF], numberDOF);
+
+  return 0;
+}
+
+
 // AddingSensitivity:BEGIN ///////////////////////////////////////
 
 Matrix
@@ -2066,6 +2179,23 @@ Node::getAccSensitivity(int dof, int gradIndex)
   else
     return 0.0;
 }
+
+// zeroSensitivity():
+//	Zeroes the response sensitivities, for revertToStart() and for the
+//	Domain when it reverts the nodal state arrays itself.
+
+void
+Node::zeroSensitivity(void)
+{
+  if (dispSensitivity != 0) 
+    dispSensitivity->Zero();
+  
+  if (velSensitivity != 0) 
+    velSensitivity->Zero();
+  
+  if (accSensitivity != 0) 
+    accSensitivity->Zero();
+}
 // AddingSensitivity:END /////////////////////////////////////////
 
 
@@ -109,6 +109,11 @@ class Node : public DomainComponent
     virtual int revertToLastCommit();    
     virtual int revertToStart();        
 
+    // public methods to keep the response quantities in the contiguous
+    // nodal state arrays of a Domain (see Domain::formNodalState)
+    int setStateStorage(Domain *owner, int slot, double *data, int stride);
+    int releaseStateStorage(void);
+
     // public methods for dynamic analysis
     virtual const Matrix &getMass(void);
     virtual int setMass(const Matrix &theMass);
@@ -144,6 +149,7 @@ class Node : public DomainComponent
     double getDispSensitivity(int dof, int gradNum);
     double getVelSensitivity(int dof, int gradNum);
     double getAccSensitivity(int dof, int gradNum);
+    void   zeroSensitivity(void);
     int setParameter(const char **argv, int argc, Parameter &param);
     int    updateParameter(int parameterID, Information &info);
     int    activateParameter(int parameterID);
@@ -190,6 +196,9 @@ class Node : public DomainComponent
     
     double *disp, *vel, *accel; // double arrays holding the displ, 
                                 // vel and accel values
+    int stateStride;            // distance between trial, commit, .. values
+    Domain *stateOwner;         // domain holding the arrays, 0 if node owns them
+    int stateSlot;              // the node's entry in the owner's list
 
     int dbTag1, dbTag2, dbTag3, dbTag4; // needed for database
     Matrix *R;                          // nodal participation matrix
@@ -449,6 +449,18 @@ LoadPattern::getLoadFactor(void)
     return 0.0;
 }
 
+double
+LoadPattern::getLoadFactor(double pseudoTime)
+{
+  if (theSeries == 0)
+    return 0.0;
+
+  if (isConstant != 0)
+    return theSeries->getFactor(pseudoTime) * scaleFactor;
+
+  return loadFactor;
+}
+
 int
 LoadPattern::sendSelf(int cTag, Channel &theChannel)
 {
@@ -86,6 +86,7 @@ class LoadPattern : public DomainComponent
     virtual void setLoadConstant(void);
 	virtual void unsetLoadConstant(void);
     virtual double getLoadFactor(void);
+    double getLoadFactor(double pseudoTime);   // without applying the loads
 
     // methods for o/p
     virtual int sendSelf(int commitTag, Channel &theChannel);
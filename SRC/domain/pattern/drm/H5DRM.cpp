@@ -30,6 +30,7 @@
 #include <iostream>
 #include <string>
 #include <sstream>
+#include <string.h>
 #include <math.h>
 #include <time.h>
 #include <hdf5.h>
@@ -47,6 +48,13 @@
 #include <mpi.h>
 #endif
 
+#ifndef _WIN32
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
 
 #include <limits>   //For std::numeric_limits<double>::epsilon()
 
@@ -113,27 +121,50 @@ void* OPS_H5DRM()
 	double T20 = 0.0; double T21 = 0.0; double T22 = 1.0;
 	double x00 = 0.0; double x01 = 0.0; double x02 = 0.0;
 
-	if (OPS_GetNumRemainingInputArgs() > 1)
+	// Options (-cacheSteps $n, -prefetch, -flatFile $name) follow the
+	// positional arguments; find where they start so the positional
+	// parsing below only sees the numbers.
+	int cache_steps = 0;
+	bool cache_prefetch = false;
+	std::string flat_filename;
+
+	int numOptionArgs = 0;
+	int numScanned = 0;
+	while (OPS_GetNumRemainingInputArgs() > 0)
+	{
+		const char* arg = OPS_GetString();
+		numScanned++;
+		if (arg == 0)
+			continue;
+		if (strcmp(arg, "-cacheSteps") == 0 || strcmp(arg, "-prefetch") == 0 || strcmp(arg, "-flatFile") == 0)
+		{
+			numOptionArgs = OPS_GetNumRemainingInputArgs() + 1;
+			break;
+		}
+	}
+	OPS_ResetCurrentInputArg(-numScanned);
+
+	if (OPS_GetNumRemainingInputArgs() - numOptionArgs > 1)
 	{
 		OPS_GetDoubleInput(&num, &crd_scale);
 		opserr << "crd_scale = " << crd_scale << endln;
 	}
 
-	if (OPS_GetNumRemainingInputArgs() > 1)
+	if (OPS_GetNumRemainingInputArgs() - numOptionArgs > 1)
 	{
 		OPS_GetDoubleInput(&num, &distance_tolerance);
 		opserr << "distance_tolerance = " << distance_tolerance << endln;
 	}
 
 	int int_do_coordinate_transformation;
-	if (OPS_GetNumRemainingInputArgs() > 1)
+	if (OPS_GetNumRemainingInputArgs() - numOptionArgs > 1)
 	{
 		OPS_GetIntInput(&num, &int_do_coordinate_transformation);
 		do_coordinate_transformation = int_do_coordinate_transformation;
 		opserr << "do_coordinate_transformation = " << do_coordinate_transformation << endln;
 	}
 
-	if (OPS_GetNumRemainingInputArgs() == 12)
+	if (OPS_GetNumRemainingInputArgs() - numOptionArgs == 12)
 	{
 		OPS_GetDoubleInput(&num, &T00);
 		OPS_GetDoubleInput(&num, &T01);
@@ -155,6 +186,33 @@ void* OPS_H5DRM()
 		opserr << "     " << x00 << " " << x01 << " " << x02 << endln;
 	}
 
+	while (OPS_GetNumRemainingInputArgs() > 0)
+	{
+		const char* opt = OPS_GetString();
+		if (opt == 0)
+			continue;
+		if (strcmp(opt, "-cacheSteps") == 0 && OPS_GetNumRemainingInputArgs() > 0)
+		{
+			if (OPS_GetIntInput(&num, &cache_steps) < 0)
+			{
+				opserr << "WARNING H5DRM - invalid -cacheSteps value\n";
+				return 0;
+			}
+		}
+		else if (strcmp(opt, "-prefetch") == 0)
+		{
+			cache_prefetch = true;
+		}
+		else if (strcmp(opt, "-flatFile") == 0 && OPS_GetNumRemainingInputArgs() > 0)
+		{
+			flat_filename = OPS_GetString();
+		}
+		else
+		{
+			opserr << "WARNING H5DRM - unknown option " << opt << endln;
+		}
+	}
+
 
 
 	thePattern = new H5DRM(tag, filename,
@@ -165,7 +223,10 @@ void* OPS_H5DRM()
 	                       T00, T01, T02,
 	                       T10, T11, T12,
 	                       T20, T21, T22,
-	                       x00, x01, x02);
+	                       x00, x01, x02,
+	                       cache_steps,
+	                       cache_prefetch,
+	                       flat_filename);
 
 
 
@@ -199,6 +260,17 @@ H5DRM::H5DRM()
 	  distance_tolerance(0),
 	  maxnodetag(0),
 	  station_id2data_pos(100),
+	  cache_steps(0),
+	  cache_prefetch(false),
+	  number_of_data_steps(0),
+	  cache_first(0), cache_len(0),
+	  next_first(0), next_len(0),
+	  prefetch_ok(false),
+	  motionU(0), motionA(0),
+	  row_stride(0), step_stride(0),
+	  step_offset(0),
+	  flat_map(0),
+	  flat_map_size(0),
 	  do_coordinate_transformation(true),
 	  T(3, 3),
 	  x0(3)
@@ -242,7 +314,10 @@ H5DRM::H5DRM(
     double T00, double T01, double T02,
     double T10, double T11, double T12,
     double T20, double T21, double T22,
-    double x00, double x01, double x02
+    double x00, double x01, double x02,
+    int cache_steps_,
+    bool cache_prefetch_,
+    std::string flat_filename_
 )
 	: LoadPattern(tag, PATTERN_TAG_H5DRM),
 	  HDF5filename(HDF5filename_),
@@ -254,6 +329,18 @@ H5DRM::H5DRM(
 	  distance_tolerance(distance_tolerance_),
 	  maxnodetag(0),
 	  station_id2data_pos(100),
+	  cache_steps(cache_steps_),
+	  cache_prefetch(cache_prefetch_),
+	  flat_filename(flat_filename_),
+	  number_of_data_steps(0),
+	  cache_first(0), cache_len(0),
+	  next_first(0), next_len(0),
+	  prefetch_ok(false),
+	  motionU(0), motionA(0),
+	  row_stride(0), step_stride(0),
+	  step_offset(0),
+	  flat_map(0),
+	  flat_map_size(0),
 	  do_coordinate_transformation(do_coordinate_transformation_),
 	  T(3, 3),
 	  x0(3)
@@ -722,6 +809,14 @@ void H5DRM::intitialize()
 
 	id_xfer_plist = H5Pcreate( H5P_DATASET_XFER);
 
+	if ((cache_steps > 1 || flat_filename.size() > 0) && !drm_setup_cache())
+	{
+		H5DRMwarning << "Could not set up the time-window cache, reading every time step.\n";
+		drm_release_cache();
+		cache_steps = 0;
+		flat_filename.clear();
+	}
+
 
 //===========================================================================
 // Set status to initialized and ready to compute loads
@@ -753,6 +848,7 @@ H5DRM::~H5DRM()
 
 void H5DRM::clean_all_data()
 {
+	drm_release_cache();
 
 	nodetag2station_id.clear();
 	nodetag2local_pos.clear();
@@ -1003,6 +1099,8 @@ bool H5DRM::ComputeDRMMotions(double next_integration_time)
 
 	if (have_displacement && have_acceleration)
 	{
+		if (!cache_rows.empty())
+			return drm_cached_read(next_integration_time);
 		return drm_direct_read(next_integration_time);
 	}
 
@@ -1181,6 +1279,433 @@ bool H5DRM::drm_direct_read(double t)
 }
 
 
+// Same interpolation as drm_direct_read() but served from the time-window
+// cache (or the memory-mapped flat file) set up by drm_setup_cache().
+bool H5DRM::drm_cached_read(double t)
+{
+
+	if (Nodes.Size() == 0)
+	{
+		H5DRMout << " This process has no DRM nodes. Nothing to be done by H5DRM" << endln;
+		return false;
+	}
+
+	DRMDisplacements.Zero();
+	DRMAccelerations.Zero();
+
+	if (t < tstart || t > tend)
+	{
+		H5DRMout << "t = " << t << " tstart = " << tstart << " tend = " << tend << " DRM Not computing forces (t < tstart or t > tend)"  << endln;
+		return true;
+	}
+
+	int i1 = (int) floor( (t - tstart) / dt);
+	int i2 = i1 + 1;
+	double t1 = i1 * dt + tstart;
+	double t2 = i2 * dt + tstart;
+	double dtau = (t - t1) / (t2 - t1);
+
+	if (i1 >= number_of_data_steps)
+		i1 = number_of_data_steps - 1;
+	if (i2 >= number_of_data_steps)
+		i2 = number_of_data_steps - 1;
+
+	if (!drm_fill_cache(i1, i2))
+	{
+		H5DRMerror << "H5DRM::drm_cached_read - Failed to read displacement or acceleration array!!\n" <<
+		           " i1 = " << i1 << endln <<
+		           " i2 = " << i2 << endln;
+		exit(-1);
+	}
+
+	double umax = -std::numeric_limits<double>::infinity();
+	double amax = -std::numeric_limits<double>::infinity();
+	double umin =  std::numeric_limits<double>::infinity();
+	double amin =  std::numeric_limits<double>::infinity();
+
+	size_t off1 = (i1 - step_offset) * step_stride;
+	size_t off2 = (i2 - step_offset) * step_stride;
+
+	for (int n = 0; n < Nodes.Size(); ++n)
+	{
+		int local_pos = node_local_pos[n];
+		size_t row = node_cache_row[n];
+
+		for (int i = 0; i < 3; ++i)
+		{
+			size_t r = (row + i) * row_stride;
+			double d1 = motionU[r + off1];
+			double d2 = motionU[r + off2];
+			double a1 = motionA[r + off1];
+			double a2 = motionA[r + off2];
+
+			if (isnan(d1) || isnan(a1) || isnan(d2) || isnan(a2))
+			{
+				H5DRMerror << "H5DRM::drm_cached_read - NaN found in displacement or acceleration array!!\n" <<
+				           " n = " << n << endln <<
+				           " nodeTag = " << Nodes(n) << endln <<
+				           " i1 = " << i1 << endln <<
+				           " local_pos = " << local_pos << endln;
+				exit(-1);
+			}
+
+			umax = std::max(umax, std::max(d1, d2));
+			amax = std::max(amax, std::max(a1, a2));
+			umin = std::min(umin, std::min(d1, d2));
+			amin = std::min(amin, std::min(a1, a2));
+
+			// z is flipped as in drm_direct_read
+			double sign = i == 2 ? -1.0 : 1.0;
+			DRMDisplacements(3 * local_pos + i) = sign * (d1 * (1 - dtau) + d2 * (dtau));
+			DRMAccelerations(3 * local_pos + i) = sign * (a1 * (1 - dtau) + a2 * (dtau));
+		}
+	}
+
+	H5DRMout << "t = " << t << " u = (" << umin << ", " << umax << ") a = (" << amin << ", " << amax << ")" << endln;
+
+	return true;
+}
+
+// Collect the dataset rows of the local DRM nodes and prepare either the
+// flat file or the first window. Called at the end of intitialize().
+bool H5DRM::drm_setup_cache()
+{
+	if (id_displacement <= 0 || id_acceleration <= 0 || Nodes.Size() == 0)
+	{
+		return false;
+	}
+
+	hid_t space = H5Dget_space(id_displacement);
+	hsize_t dims[2] = {0, 0};
+	int rank = H5Sget_simple_extent_dims(space, dims, NULL);
+	H5Sclose(space);
+	if (rank != 2 || dims[1] == 0)
+	{
+		return false;
+	}
+	number_of_data_steps = (int) dims[1];
+
+	cache_rows.clear();
+	for (int n = 0; n < Nodes.Size(); ++n)
+	{
+		int station_id = nodetag2station_id[Nodes(n)];
+		hsize_t data_pos = station_id2data_pos[station_id];
+		for (int i = 0; i < 3; ++i)
+			cache_rows.push_back(data_pos + i);
+	}
+	std::sort(cache_rows.begin(), cache_rows.end());
+	cache_rows.erase(std::unique(cache_rows.begin(), cache_rows.end()), cache_rows.end());
+
+	node_cache_row.resize(Nodes.Size());
+	node_local_pos.resize(Nodes.Size());
+	for (int n = 0; n < Nodes.Size(); ++n)
+	{
+		int nodeTag = Nodes(n);
+		hsize_t data_pos = station_id2data_pos[nodetag2station_id[nodeTag]];
+		node_cache_row[n] = (int) (std::lower_bound(cache_rows.begin(), cache_rows.end(), data_pos) - cache_rows.begin());
+		node_local_pos[n] = nodetag2local_pos[nodeTag];
+	}
+
+	if (flat_filename.size() > 0)
+	{
+		if (drm_open_flat_file())
+		{
+			return true;
+		}
+		H5DRMwarning << "Could not use flat file " << flat_filename << ", using the HDF5 window cache instead.\n";
+		if (cache_steps < 2)
+			cache_steps = H5DRM_NUM_OF_PRECOMPUTED_TIMESTEPS;
+	}
+
+	if (cache_prefetch)
+	{
+		hbool_t threadsafe = 0;
+		H5is_library_threadsafe(&threadsafe);
+		if (!threadsafe)
+		{
+			H5DRMwarning << "HDF5 library is not thread-safe, -prefetch ignored.\n";
+			cache_prefetch = false;
+		}
+	}
+
+	cache_first = cache_len = 0;
+	step_stride = 1;
+
+	if (myrank == 0)
+	{
+		H5DRMout << "Caching " << cache_rows.size() << " rows in windows of " << cache_steps << " time steps"
+		         << (cache_prefetch ? " (prefetching)" : "") << "\n";
+	}
+
+	return true;
+}
+
+// Read rows cache_rows of time steps [first, first+len) of both motion
+// datasets with one H5Dread each. Runs of consecutive rows are merged in
+// the file selection; HDF5 returns the selection in file order, i.e.
+// u[r*len + j] holds row cache_rows[r] at step first + j.
+bool H5DRM::drm_read_window(int first, int len, std::vector<double>& u, std::vector<double>& a)
+{
+	hsize_t nrows = cache_rows.size();
+	u.resize(nrows * len);
+	a.resize(nrows * len);
+
+	hid_t uspace = H5Dget_space(id_displacement);
+	hid_t aspace = H5Dget_space(id_acceleration);
+
+	H5S_seloper_t op = H5S_SELECT_SET;
+	hsize_t r = 0;
+	while (r < nrows)
+	{
+		hsize_t r2 = r + 1;
+		while (r2 < nrows && cache_rows[r2] == cache_rows[r2 - 1] + 1)
+			++r2;
+
+		hsize_t start[2] = {cache_rows[r], (hsize_t) first};
+		hsize_t count[2] = {r2 - r, (hsize_t) len};
+		H5Sselect_hyperslab(uspace, op, start, NULL, count, NULL);
+		H5Sselect_hyperslab(aspace, op, start, NULL, count, NULL);
+		op = H5S_SELECT_OR;
+		r = r2;
+	}
+
+	hsize_t mem_dims[2] = {nrows, (hsize_t) len};
+	hid_t memspace = H5Screate_simple(2, mem_dims, NULL);
+
+	herr_t errorflag1 = H5Dread(id_displacement, H5T_NATIVE_DOUBLE, memspace, uspace, id_xfer_plist, u.data());
+	herr_t errorflag2 = H5Dread(id_acceleration, H5T_NATIVE_DOUBLE, memspace, aspace, id_xfer_plist, a.data());
+
+	H5Sclose(memspace);
+	H5Sclose(uspace);
+	H5Sclose(aspace);
+
+	return errorflag1 >= 0 && errorflag2 >= 0;
+}
+
+// Make steps i1 and i2 available through motionU/motionA. A window starts
+// at the requested step; consecutive windows overlap by one step so that
+// the interpolation pair never straddles two windows.
+bool H5DRM::drm_fill_cache(int i1, int i2)
+{
+	if (flat_map != 0)
+	{
+		return true;
+	}
+
+	if (cache_len > 0 && i1 >= cache_first && i2 < cache_first + cache_len)
+	{
+		return true;
+	}
+
+	bool have_window = false;
+	if (prefetch_thread.joinable())
+	{
+		prefetch_thread.join();
+		if (prefetch_ok && i1 >= next_first && i2 < next_first + next_len)
+		{
+			cacheU.swap(nextU);
+			cacheA.swap(nextA);
+			cache_first = next_first;
+			cache_len = next_len;
+			have_window = true;
+		}
+	}
+
+	if (!have_window)
+	{
+		cache_first = i1;
+		cache_len = std::min(std::max(cache_steps, 2), number_of_data_steps - i1);
+		if (!drm_read_window(cache_first, cache_len, cacheU, cacheA))
+		{
+			cache_len = 0;
+			return false;
+		}
+	}
+
+	motionU = cacheU.data();
+	motionA = cacheA.data();
+	row_stride = cache_len;
+	step_offset = cache_first;
+
+	if (cache_prefetch && cache_first + cache_len < number_of_data_steps)
+	{
+		next_first = cache_first + cache_len - 1;
+		next_len = std::min(cache_steps, number_of_data_steps - next_first);
+		prefetch_thread = std::thread([this]() {
+			prefetch_ok = drm_read_window(next_first, next_len, nextU, nextA);
+		});
+	}
+
+	return true;
+}
+
+// The flat file holds, for this process, a header followed by the sorted
+// dataset rows and then, for every time step, the displacements and the
+// accelerations of those rows (time-major, so the data for one step is
+// contiguous). It is written on first use and memory-mapped afterwards.
+// The header records the name, size and modification time of the HDF5
+// file, so the flat file is written again when the source changes.
+#define H5DRM_FLAT_MAGIC "H5DRMFL2"
+
+bool H5DRM::drm_open_flat_file()
+{
+#ifdef _WIN32
+	H5DRMwarning << "-flatFile is not supported on this platform.\n";
+	return false;
+#else
+	std::string fname = flat_filename;
+#if defined(_PARALLEL_PROCESSING) || defined(_PARALLEL_INTERPRETERS)
+	std::stringstream ss;
+	ss << flat_filename << "." << myrank;
+	fname = ss.str();
+#endif
+
+	struct stat source_st;
+	if (stat(HDF5filename.c_str(), &source_st) != 0)
+	{
+		return false;
+	}
+	char source_name[H5DRM_MAX_FILENAME];
+	memset(source_name, 0, H5DRM_MAX_FILENAME);
+	strncpy(source_name, HDF5filename.c_str(), H5DRM_MAX_FILENAME - 1);
+	long long source[2] = {(long long) source_st.st_size, (long long) source_st.st_mtime};
+
+	long long nrows = cache_rows.size();
+	long long nsteps = number_of_data_steps;
+	size_t header_size = 8 + H5DRM_MAX_FILENAME + 4 * sizeof(long long) + 2 * sizeof(double);
+	size_t data_offset = header_size + nrows * sizeof(long long);
+	size_t file_size = data_offset + 2 * nrows * nsteps * sizeof(double);
+
+	// check whether an existing file matches this model and dataset
+	bool valid = false;
+	FILE *fp = fopen(fname.c_str(), "rb");
+	if (fp != 0)
+	{
+		char magic[8];
+		char name[H5DRM_MAX_FILENAME];
+		long long src[2];
+		long long n[2];
+		double times[2];
+		valid = fread(magic, 1, 8, fp) == 8 && memcmp(magic, H5DRM_FLAT_MAGIC, 8) == 0
+		        && fread(name, 1, H5DRM_MAX_FILENAME, fp) == H5DRM_MAX_FILENAME
+		        && memcmp(name, source_name, H5DRM_MAX_FILENAME) == 0
+		        && fread(src, sizeof(long long), 2, fp) == 2 && src[0] == source[0] && src[1] == source[1]
+		        && fread(n, sizeof(long long), 2, fp) == 2 && n[0] == nrows && n[1] == nsteps
+		        && fread(times, sizeof(double), 2, fp) == 2 && times[0] == tstart && times[1] == dt;
+		for (long long r = 0; valid && r < nrows; ++r)
+		{
+			long long row;
+			valid = fread(&row, sizeof(long long), 1, fp) == 1 && row == (long long) cache_rows[r];
+		}
+		fclose(fp);
+	}
+
+	if (!valid)
+	{
+		H5DRMout << "Writing flat DRM motions to " << fname << "\n";
+		fp = fopen(fname.c_str(), "wb");
+		if (fp == 0)
+		{
+			return false;
+		}
+		long long n[2] = {nrows, nsteps};
+		double times[2] = {tstart, dt};
+		fwrite(H5DRM_FLAT_MAGIC, 1, 8, fp);
+		fwrite(source_name, 1, H5DRM_MAX_FILENAME, fp);
+		fwrite(source, sizeof(long long), 2, fp);
+		fwrite(n, sizeof(long long), 2, fp);
+		fwrite(times, sizeof(double), 2, fp);
+		for (long long r = 0; r < nrows; ++r)
+		{
+			long long row = cache_rows[r];
+			fwrite(&row, sizeof(long long), 1, fp);
+		}
+
+		int block = std::max(cache_steps, H5DRM_NUM_OF_PRECOMPUTED_TIMESTEPS);
+		std::vector<double> u, a, step_data(2 * nrows);
+		bool ok = true;
+		for (int first = 0; ok && first < nsteps; first += block)
+		{
+			int len = std::min(block, (int) nsteps - first);
+			ok = drm_read_window(first, len, u, a);
+			for (int j = 0; ok && j < len; ++j)
+			{
+				for (long long r = 0; r < nrows; ++r)
+				{
+					step_data[r] = u[r * len + j];
+					step_data[nrows + r] = a[r * len + j];
+				}
+				ok = fwrite(step_data.data(), sizeof(double), 2 * nrows, fp) == (size_t) (2 * nrows);
+			}
+		}
+		fclose(fp);
+		if (!ok)
+		{
+			remove(fname.c_str());
+			return false;
+		}
+	}
+
+	int fd = open(fname.c_str(), O_RDONLY);
+	if (fd < 0)
+	{
+		return false;
+	}
+	struct stat st;
+	if (fstat(fd, &st) != 0 || (size_t) st.st_size != file_size)
+	{
+		close(fd);
+		return false;
+	}
+	void *map = mmap(0, file_size, PROT_READ, MAP_SHARED, fd, 0);
+	close(fd);
+	if (map == MAP_FAILED)
+	{
+		return false;
+	}
+
+	flat_map = map;
+	flat_map_size = file_size;
+	motionU = (const double*) ((const char*) map + data_offset);
+	motionA = motionU + nrows;
+	row_stride = 1;
+	step_stride = 2 * nrows;
+	step_offset = 0;
+
+	H5DRMout << "Using flat DRM motions from " << fname << "\n";
+
+	return true;
+#endif
+}
+
+void H5DRM::drm_release_cache()
+{
+	if (prefetch_thread.joinable())
+	{
+		prefetch_thread.join();
+	}
+
+#ifndef _WIN32
+	if (flat_map != 0)
+	{
+		munmap(flat_map, flat_map_size);
+	}
+#endif
+	flat_map = 0;
+	flat_map_size = 0;
+
+	motionU = motionA = 0;
+	cache_first = cache_len = 0;
+	cacheU.clear();
+	cacheA.clear();
+	nextU.clear();
+	nextA.clear();
+	cache_rows.clear();
+	node_cache_row.clear();
+	node_local_pos.clear();
+}
+
+
 bool H5DRM::drm_differentiate_displacements(double t)
 {
 
@@ -1840,10 +2365,12 @@ H5DRM::sendSelf(int commitTag, Channel & theChannel)
 
 	H5DRMout << "sending filename: " << HDF5filename << endl;
 
-	static Vector data(3);
+	static Vector data(5);
 	data(0) = cFactor;
 	data(1) = crd_scale;
 	data(2) = distance_tolerance;
+	data(3) = cache_steps;
+	data(4) = cache_prefetch;
 
 	char drmfilename[H5DRM_MAX_FILENAME];
 	strcpy(drmfilename, HDF5filename.c_str());
@@ -1861,6 +2388,16 @@ H5DRM::sendSelf(int commitTag, Channel & theChannel)
 		return -1;
 	}
 
+	char flatfilename[H5DRM_MAX_FILENAME];
+	strncpy(flatfilename, flat_filename.c_str(), H5DRM_MAX_FILENAME - 1);
+	flatfilename[H5DRM_MAX_FILENAME - 1] = '\0';
+	Message flat_msg(flatfilename, H5DRM_MAX_FILENAME);
+	if (theChannel.sendMsg(0, 0, flat_msg) < 0)
+	{
+		cerr << "H5DRM::sendSelf -- failed to send flat filename\n";
+		return -1;
+	}
+
 
 	return 0;
 }
@@ -1870,7 +2407,7 @@ H5DRM::recvSelf(int commitTag, Channel & theChannel,
                 FEM_ObjectBroker & theBroker)
 {
 	H5DRMout << "receiving...\n";
-	static Vector data(3);
+	static Vector data(5);
 	char drmfilename[H5DRM_MAX_FILENAME];
 	Message filename_msg(drmfilename, H5DRM_MAX_FILENAME);
 
@@ -1890,6 +2427,17 @@ H5DRM::recvSelf(int commitTag, Channel & theChannel,
 	cFactor = data(0);
 	crd_scale = data(1);
 	distance_tolerance = data(2);
+	cache_steps = (int) data(3);
+	cache_prefetch = data(4) != 0;
+
+	char flatfilename[H5DRM_MAX_FILENAME];
+	Message flat_msg(flatfilename, H5DRM_MAX_FILENAME);
+	if (theChannel.recvMsg(0, 0, flat_msg) < 0)
+	{
+		cerr << "H5DRM::receiveSelf -- failed to receive flat filename\n";
+		return -1;
+	}
+	flat_filename = flatfilename;
 
 	HDF5filename = drmfilename;
 	H5DRMout << "received filename is " <<  drmfilename << "\n";
@@ -1909,7 +2457,13 @@ H5DRM::Print(ostream & s, int flag)
 LoadPattern *
 H5DRM::getCopy(void)
 {
-	return new H5DRM(this->getTag(), HDF5filename);
+	return new H5DRM(this->getTag(), HDF5filename, cFactor, crd_scale, distance_tolerance,
+	                 do_coordinate_transformation,
+	                 T(0, 0), T(0, 1), T(0, 2),
+	                 T(1, 0), T(1, 1), T(1, 2),
+	                 T(2, 0), T(2, 1), T(2, 2),
+	                 x0(0), x0(1), x0(2),
+	                 cache_steps, cache_prefetch, flat_filename);
 }
 
 
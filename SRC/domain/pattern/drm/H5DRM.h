@@ -51,6 +51,12 @@
 //    current analysis timestep does not "fall" in any of the motion time 
 //    samples. This can be improved since a linear interpolation in 
 //    accelerations is a cubic interpolation in displacements.  
+//  + With -cacheSteps n (n > 1) motions are read in windows of n time
+//    steps for all local DRM nodes at once; by default every step is
+//    read on its own. With -prefetch the next window is read by a
+//    background thread (needs a thread-safe HDF5 build). -flatFile name
+//    converts the local rows to a flat binary file once and memory-maps
+//    it on later runs while the HDF5 file is unchanged.
 //  + Based on the original papers by Jacobo Bielak [1] and [2]. 
 //  + The previous remark means that velocities are not directly used. 
 //    This might be important if damping in the DRM layer is thought to be 
@@ -102,6 +108,7 @@
 #include <vector>
 #include <algorithm>  // For std::min and std::max functions
 #include <string>
+#include <thread>
 
 #define H5DRM_NUM_OF_PRECOMPUTED_TIMESTEPS 50
 #define H5DRM_MAX_RETURN_OPEN_OBJS 100
@@ -154,7 +161,10 @@ public:
         double T00 = 1.0, double T01 = 0.0, double T02 = 0.0,
         double T10 = 0.0, double T11 = 1.0, double T12 = 0.0,
         double T20 = 0.0, double T21 = 0.0, double T22 = 1.0,
-        double x00 = 0.0, double x01 = 0.0, double x02 = 0.0);
+        double x00 = 0.0, double x01 = 0.0, double x02 = 0.0,
+        int cache_steps_ = 0,
+        bool cache_prefetch_ = false,
+        std::string flat_filename_ = "");
     ~H5DRM();
     void clean_all_data(); // Called by destructor and if domain changes
 
@@ -177,6 +187,14 @@ protected:
     bool  drm_differentiate_displacements(double next_integration_time);
     bool  drm_integrate_velocity(double next_integration_time);
     bool  drm_direct_read(double next_integration_time);
+    bool  drm_cached_read(double next_integration_time);
+
+    // time-window cache of the DRM motions used by drm_cached_read()
+    bool  drm_setup_cache();
+    bool  drm_read_window(int first, int len, std::vector<double>& u, std::vector<double>& a);
+    bool  drm_fill_cache(int i1, int i2);
+    bool  drm_open_flat_file();
+    void  drm_release_cache();
     Vector *getNodalLoad(int node, double time);
 
     void intitialize();
@@ -234,6 +252,30 @@ private:
     hid_t id_one_node_memspace;
     hid_t id_xfer_plist;
 
+    // Time-window cache. Instead of two hyperslab reads per node and step,
+    // the rows of all local DRM nodes are read for cache_steps time steps
+    // at once; the next window can be prefetched by a background thread.
+    // Optionally the local rows are converted once into a flat binary
+    // file (time-major) which is memory-mapped and read without HDF5.
+    int cache_steps;                    // steps per block read (< 2 reads every step)
+    bool cache_prefetch;                // prefetch the next window in a thread
+    std::string flat_filename;          // flat copy of the local DRM motions
+    std::vector<hsize_t> cache_rows;    // sorted dataset rows used by this process
+    std::vector<int> node_cache_row;    // Nodes(n) -> position of its x row in cache_rows
+    std::vector<int> node_local_pos;    // Nodes(n) -> nodetag2local_pos
+    int number_of_data_steps;           // columns of the motion datasets
+    int cache_first, cache_len;         // window currently held in cacheU/cacheA
+    std::vector<double> cacheU, cacheA; // [row][step] blocks
+    int next_first, next_len;           // window being prefetched into nextU/nextA
+    std::vector<double> nextU, nextA;
+    std::thread prefetch_thread;
+    bool prefetch_ok;
+    const double *motionU, *motionA;    // U(row, step) = motionU[row*row_stride + (step - step_offset)*step_stride]
+    size_t row_stride, step_stride;
+    int step_offset;
+    void *flat_map;
+    size_t flat_map_size;
+
     int myrank;         // MPI Process-id (rank) in the case of parallel processing
 
     // std::vector<Plane*> planes;
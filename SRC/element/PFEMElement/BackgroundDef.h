@@ -36,6 +36,7 @@
 #include <iostream>
 #include <map>
 #include <set>
+#include <unordered_map>
 #include <vector>
 
 class Particle;
@@ -51,6 +52,24 @@ typedef std::vector<VDouble> VVDouble;
 typedef std::vector<Particle*> VParticle;
 typedef std::vector<VParticle> VVParticle;
 
+// hash of a grid index: the (at most 3) components are packed into
+// 21 bits each of one 64-bit integer, which is then mixed
+struct VIntHash {
+    std::size_t operator()(const VInt& index) const {
+        unsigned long long key = 0;
+        for (int i = 0; i < (int)index.size(); ++i) {
+            key = (key << 21) ^
+                  ((unsigned long long)(unsigned int)index[i] & 0x1fffffULL);
+        }
+        key ^= key >> 33;
+        key *= 0xff51afd7ed558ccdULL;
+        key ^= key >> 33;
+        key *= 0xc4ceb9fe1a85ec53ULL;
+        key ^= key >> 33;
+        return (std::size_t)key;
+    }
+};
+
 // functions for VDouble
 const VDouble& operator+=(VDouble& v1, const VDouble& v2);
 const VDouble& operator-=(VDouble& v1, const VDouble& v2);
@@ -66,6 +66,23 @@
 
 static BackgroundMesh bgmesh;
 
+// the cells and nodes are kept in hash maps; the objects created from
+// them are visited in the order of the grid index, so that the tags and
+// the order of creation do not depend on the bucket state of the maps
+template <class Map>
+static void sortedIters(Map& map, std::vector<typename Map::iterator>& iters) {
+    iters.clear();
+    iters.reserve(map.size());
+    for (typename Map::iterator it = map.begin(); it != map.end(); ++it) {
+        iters.push_back(it);
+    }
+    std::sort(iters.begin(), iters.end(),
+              [](const typename Map::iterator& a,
+                 const typename Map::iterator& b) {
+                  return a->first < b->first;
+              });
+}
+
 BackgroundMesh& OPS_getBgMesh() { return bgmesh; }
 
 // OPS_BgMesh
@@ -293,6 +310,9 @@ int OPS_BgMesh() {
 
         } else if (strcmp(opt, "-dispOn") == 0) {
             bgmesh.setDispOn(true);
+
+        } else if (strcmp(opt, "-incremental") == 0) {
+            bgmesh.setIncremental(true);
         }
     }
 
@@ -323,7 +343,11 @@ BackgroundMesh::BackgroundMesh()
       contactData(),
       contactEles(),
       dispon(true),
-      alphaS(0.0) {}
+      alphaS(0.0),
+      incremental(false),
+      gridChanged(true),
+      lastStructure(),
+      lastNumParticles(-1) {}
 
 BackgroundMesh::~BackgroundMesh() {
     for (int i = 0; i < (int)recorders.size(); ++i) {
@@ -501,7 +525,7 @@ void BackgroundMesh::gatherParticles(const VInt& minind,
             index[0] = i;
             for (int j = minind[1]; j < maxind[1]; ++j) {
                 index[1] = j;
-                std::map<VInt, BCell>::iterator it =
+                BCellMap::iterator it =
                     bcells.find(index);
                 if (it != bcells.end()) {
                     BCell& cell = it->second;
@@ -521,7 +545,7 @@ void BackgroundMesh::gatherParticles(const VInt& minind,
                 index[1] = j;
                 for (int k = minind[2]; k < maxind[2]; ++k) {
                     index[2] = k;
-                    std::map<VInt, BCell>::iterator it =
+                    BCellMap::iterator it =
                         bcells.find(index);
                     if (it != bcells.end()) {
                         BCell& cell = it->second;
@@ -755,6 +779,10 @@ void BackgroundMesh::clearAll() {
     contactEles.clear();
     dispon = true;
     alphaS = 0.0;
+    incremental = false;
+    gridChanged = true;
+    lastStructure.clear();
+    lastNumParticles = -1;
 }
 
 int BackgroundMesh::clearBackground() {
@@ -787,7 +815,7 @@ void BackgroundMesh::clearGrid() {
     if (domain == 0) return;
 
     // remove cells
-    for (std::map<VInt, BNode>::iterator it = bnodes.begin();
+    for (BNodeMap::iterator it = bnodes.begin();
          it != bnodes.end(); ++it) {
         BNode& bnode = it->second;
         const VInt& tags = bnode.getTags();
@@ -916,6 +944,30 @@ int BackgroundMesh::remesh(bool init) {
     timer.start();
 #endif
 
+    // keep the grid nodes and elements if the grid is unchanged,
+    // so the domain does not change; only the nodal states are reset
+    // from the particles
+    if (incremental && !init && sameGrid()) {
+        if (updateGridNodes() < 0) {
+            opserr << "WARNING: failed to update grid nodes\n";
+            return -1;
+        }
+
+#ifdef _LINUX
+        timer.pause();
+        opserr << "time for update grid nodes = " << timer.getReal()
+               << "\n";
+        timer.start();
+#endif
+
+        if (record(init) < 0) {
+            opserr << "WARNING: failed to record\n";
+            return -1;
+        }
+
+        return 0;
+    }
+
     // clear background
     clearBackground();
 
@@ -991,6 +1043,12 @@ int BackgroundMesh::remesh(bool init) {
     timer.start();
 #endif
 
+    // grid state for the next incremental remesh
+    if (incremental) {
+        structureData(lastStructure);
+        lastNumParticles = countParticles();
+    }
+
     if (record(init) < 0) {
         opserr << "WARNING: failed to record\n";
         return -1;
@@ -1263,32 +1321,160 @@ int BackgroundMesh::addParticles() {
     return 0;
 }
 
-int BackgroundMesh::gridNodes() {
-    // get domain
+// kernel average of the particle states around a grid node
+void BackgroundMesh::gridAverage(const VInt& index, const VDouble& crds,
+                                 double& wt, double& pre, double& pdot,
+                                 VDouble& vel, VDouble& accel) {
+    int ndm = OPS_GetNDM();
+
+    // get particles
+    VParticle pts;
+    VInt minind = index;
+    VInt maxind = index;
+    minind -= numave;
+    maxind += numave;
+    gatherParticles(minind, maxind, pts);
+
+    // get information
+    wt = 0.0;
+    pre = 0.0;
+    pdot = 0.0;
+    vel.assign(ndm, 0.0);
+    accel.assign(ndm, 0.0);
+    for (int i = 0; i < (int)pts.size(); ++i) {
+        // get particle
+        if (pts[i] == 0) {
+            continue;
+        }
+
+        // particle coordinates
+        const VDouble& pcrds = pts[i]->getCrds();
+
+        // distance from particle to current location
+        VDouble dist = pcrds;
+        dist -= crds;
+        double q = normVDouble(dist) / (bsize * numave);
+
+        // weight for the particle
+        double w = QuinticKernel(q, bsize * numave, ndm);
+
+        // check velocity
+        const VDouble& pvel = pts[i]->getVel();
+
+        // add pressure
+        pre += pts[i]->getPressure() * w;
+        pdot += pts[i]->getPdot() * w;
+
+        // add velocity
+        for (int k = 0; k < ndm; k++) {
+            vel[k] += w * pvel[k];
+        }
+
+        // add acceleration
+        const VDouble& paccel = pts[i]->getAccel();
+        for (int k = 0; k < ndm; k++) {
+            accel[k] += w * paccel[k];
+        }
+
+        wt += w;
+    }
+
+    // get nodal states
+    if (wt > 0) {
+        pre /= wt;
+        pdot /= wt;
+        vel /= wt;
+        accel /= wt;
+    }
+}
+
+// the grid can be kept if no particle has left its cell, no
+// particle has been added or removed, and every structural node
+// is still nearest to the same grid node
+bool BackgroundMesh::sameGrid() {
+    if (gridChanged || bnodes.empty()) {
+        return false;
+    }
+    if (countParticles() != lastNumParticles) {
+        return false;
+    }
+    VInt structure;
+    structureData(structure);
+    return structure == lastStructure;
+}
+
+// the (sid, tag, nearIndex) of all structural nodes, which are
+// compared as a whole so that a changed structure is never taken
+// for the same one
+void BackgroundMesh::structureData(VInt& data) {
+    data.clear();
     int ndm = OPS_GetNDM();
     Domain* domain = OPS_GetDomain();
+    if (domain == 0) return;
+
+    VDouble crdsn(ndm);
+    VInt index;
+    for (auto it = structuralNodes.begin(); it != structuralNodes.end();
+         ++it) {
+        const VInt& snodes = it->second;
+        for (int k = 0; k < (int)snodes.size(); ++k) {
+            Node* nd = domain->getNode(snodes[k]);
+            if (nd == 0) continue;
+
+            const Vector& crds = nd->getCrds();
+            const Vector& disp = nd->getTrialDisp();
+            if (crds.Size() != ndm || disp.Size() < ndm) {
+                continue;
+            }
+            for (int i = 0; i < ndm; ++i) {
+                crdsn[i] = crds(i) + disp(i);
+            }
+            nearIndex(crdsn, index);
+
+            data.push_back(it->first);
+            data.push_back(snodes[k]);
+            for (int i = 0; i < ndm; ++i) {
+                data.push_back(index[i]);
+            }
+        }
+    }
+}
+
+int BackgroundMesh::countParticles() {
+    int num = 0;
+    TaggedObjectIter& meshes = OPS_getAllMesh();
+    Mesh* mesh = 0;
+    while ((mesh = dynamic_cast<Mesh*>(meshes())) != 0) {
+        ParticleGroup* group = dynamic_cast<ParticleGroup*>(mesh);
+        if (group == 0) {
+            continue;
+        }
+        num += group->numParticles();
+    }
+    return num;
+}
+
+// reset the grid nodes of an unchanged grid to the particle states,
+// as gridNodes does for new nodes
+int BackgroundMesh::updateGridNodes() {
+    // get domain
+    Domain* domain = OPS_GetDomain();
     if (domain == 0) return 0;
 
     // vector of iterators
-    std::vector<std::map<VInt, BNode>::iterator> iters;
+    std::vector<BNodeMap::iterator> iters;
     iters.reserve(bnodes.size());
-    for (std::map<VInt, BNode>::iterator it = bnodes.begin();
-         it != bnodes.end(); ++it) {
+    for (BNodeMap::iterator it = bnodes.begin(); it != bnodes.end();
+         ++it) {
         iters.push_back(it);
     }
 
-    // vector of new objects
-    int ndtag = Mesh::nextNodeTag();
-    std::vector<Node*> newnodes(iters.size(), 0),
-        newpnodes(iters.size(), 0);
-    std::vector<Pressure_Constraint*> newpcs(iters.size(), 0);
-
     int res = 0;
 
 #pragma omp parallel for
     for (int j = 0; j < (int)iters.size(); ++j) {
         // get iterator
-        std::map<VInt, BNode>::iterator it = iters[j];
+        BNodeMap::iterator it = iters[j];
 
         // get cell
         const VInt& index = it->first;
@@ -1301,63 +1487,135 @@ int BackgroundMesh::gridNodes() {
         VDouble crds;
         getCrds(index, crds);
 
-        // get particles
-        VParticle pts;
-        VInt minind = index;
-        VInt maxind = index;
-        minind -= numave;
-        maxind += numave;
-        gatherParticles(minind, maxind, pts);
-
-        // get information
+        // get nodal states from particles
         double wt = 0.0, pre = 0.0, pdot = 0.0;
-        VDouble vel(ndm), accel(ndm);
-        for (int i = 0; i < (int)pts.size(); ++i) {
-            // get particle
-            if (pts[i] == 0) {
-                continue;
+        VDouble vel, accel;
+        gridAverage(index, crds, wt, pre, pdot, vel, accel);
+
+        // update pressure for structural nodes
+        auto& tags = bnode.getTags();
+        if (bnode.getType() == BACKGROUND_STRUCTURE) {
+            for (int i = 0; i < (int)bnode.size(); ++i) {
+                Pressure_Constraint* pc =
+                    domain->getPressure_Constraint(tags[i]);
+                if (pc == 0) {
+                    opserr << "WARNING: structural node " << tags[i];
+                    opserr << " has not pc associated\n";
+                    continue;
+                }
+                pc->setPressure(pre);
+                pc->setPdot(pdot);
             }
 
-            // particle coordinates
-            const VDouble& pcrds = pts[i]->getCrds();
+            continue;
+        }
 
-            // distance from particle to current location
-            VDouble dist = pcrds;
-            dist -= crds;
-            double q = normVDouble(dist) / (bsize * numave);
+        // fluid node: tags[0] = f, or tags[0] = s, tags[1] = f
+        int ftag = -1;
+        if (bnode.getType() == BACKGROUND_FLUID_STRUCTURE) {
+            if (tags.size() > 1) ftag = tags[1];
+        } else if (!tags.empty()) {
+            ftag = tags[0];
+        }
+        Node* node = domain->getNode(ftag);
+        Pressure_Constraint* thePC = domain->getPressure_Constraint(ftag);
+        Node* pnode = 0;
+        if (thePC != 0) {
+            pnode = thePC->getPressureNode();
+        }
+        if (node == 0 || pnode == 0) {
+            opserr << "WARNING: grid node " << ftag << " not found -- ";
+            opserr << "BgMesh::updateGridNodes\n";
+            res = -1;
+            continue;
+        }
 
-            // weight for the particle
-            double w = QuinticKernel(q, bsize * numave, ndm);
+        // back to the grid location, with the particle states
+        node->revertToStart();
+        pnode->revertToStart();
+        if (wt > 0) {
+            Vector vec;
+            toVector(vel, vec);
+            node->setTrialVel(vec);
+            toVector(accel, vec);
+            node->setTrialAccel(vec);
 
-            // check velocity
-            const VDouble& pvel = pts[i]->getVel();
+            Vector newvel = pnode->getVel();
+            newvel.Zero();
+            newvel(0) = pre;
+            Vector newaccel = pnode->getAccel();
+            newaccel.Zero();
+            newaccel(0) = pdot;
+            pnode->setTrialVel(newvel);
+            pnode->setTrialAccel(newaccel);
+        }
+        node->commitState();
+        pnode->commitState();
+    }
 
-            // add pressure
-            pre += pts[i]->getPressure() * w;
-            pdot += pts[i]->getPdot() * w;
+    if (res < 0) {
+        return -1;
+    }
 
-            // add velocity
-            for (int k = 0; k < ndm; k++) {
-                vel[k] += w * pvel[k];
+    // elements start again from the grid location
+    TaggedObjectIter& meshes = OPS_getAllMesh();
+    Mesh* mesh = 0;
+    while ((mesh = dynamic_cast<Mesh*>(meshes())) != 0) {
+        ParticleGroup* group = dynamic_cast<ParticleGroup*>(mesh);
+        if (group == 0) {
+            continue;
+        }
+        const ID& eletags = group->getEleTags();
+        for (int i = 0; i < eletags.Size(); ++i) {
+            Element* ele = domain->getElement(eletags(i));
+            if (ele != 0) {
+                ele->revertToStart();
             }
+        }
+    }
 
-            // add acceleration
-            const VDouble& paccel = pts[i]->getAccel();
-            for (int k = 0; k < ndm; k++) {
-                accel[k] += w * paccel[k];
-            }
+    return 0;
+}
 
-            wt += w;
-        }
+int BackgroundMesh::gridNodes() {
+    // get domain
+    int ndm = OPS_GetNDM();
+    Domain* domain = OPS_GetDomain();
+    if (domain == 0) return 0;
 
-        // get nodal states
-        if (wt > 0) {
-            pre /= wt;
-            pdot /= wt;
-            vel /= wt;
-            accel /= wt;
+    // vector of iterators
+    std::vector<BNodeMap::iterator> iters;
+    sortedIters(bnodes, iters);
+
+    // vector of new objects
+    int ndtag = Mesh::nextNodeTag();
+    std::vector<Node*> newnodes(iters.size(), 0),
+        newpnodes(iters.size(), 0);
+    std::vector<Pressure_Constraint*> newpcs(iters.size(), 0);
+
+    int res = 0;
+
+#pragma omp parallel for
+    for (int j = 0; j < (int)iters.size(); ++j) {
+        // get iterator
+        BNodeMap::iterator it = iters[j];
+
+        // get cell
+        const VInt& index = it->first;
+        BNode& bnode = it->second;
+        if (bnode.getType() == BACKGROUND_FIXED) {
+            continue;
         }
 
+        // coordinates
+        VDouble crds;
+        getCrds(index, crds);
+
+        // get nodal states from particles
+        double wt = 0.0, pre = 0.0, pdot = 0.0;
+        VDouble vel, accel;
+        gridAverage(index, crds, wt, pre, pdot, vel, accel);
+
         // update pressure for structural nodes
         if (bnode.getType() == BACKGROUND_STRUCTURE) {
             auto& tags = bnode.getTags();
@@ -1511,11 +1769,22 @@ int BackgroundMesh::gridNodes() {
 int BackgroundMesh::moveFixedParticles() {
     int ndm = OPS_GetNDM();
 
-    // check each cell
-    for (auto it = bcells.begin(); it != bcells.end(); ++it) {
+    // check each cell in grid order; cells may be added below, which can
+    // rehash bcells, so loop over the entries as they are now
+    std::vector<BCellMap::value_type*> entries;
+    entries.reserve(bcells.size());
+    for (auto& item : bcells) {
+        entries.push_back(&item);
+    }
+    std::sort(entries.begin(), entries.end(),
+              [](const BCellMap::value_type* a,
+                 const BCellMap::value_type* b) {
+                  return a->first < b->first;
+              });
+    for (int j = 0; j < (int)entries.size(); ++j) {
         // get cell
-        const VInt& index = it->first;
-        BCell& cell = it->second;
+        const VInt& index = entries[j]->first;
+        BCell& cell = entries[j]->second;
 
         // empty cell
         if (cell.getPts().empty()) {
@@ -1691,13 +1960,19 @@ int BackgroundMesh::moveFixedParticles() {
             }
         }
 
-        // find any cell with particles
+        // find any cell with particles, the one with the lowest
+        // index, or else the highest index as in grid order
         if (high < 0 || ind == index) {
+            bool found = false;
+            VInt last;
             for (auto it2 = bcells.begin(); it2 != bcells.end();
                  ++it2) {
                 // get cell
-                ind = it2->first;
+                const VInt& ind2 = it2->first;
                 BCell& cell2 = it2->second;
+                if (last.empty() || last < ind2) {
+                    last = ind2;
+                }
 
                 // empty cell
                 if (cell2.getPts().empty()) {
@@ -1710,7 +1985,13 @@ int BackgroundMesh::moveFixedParticles() {
                 }
 
                 // find the cell
-                break;
+                if (!found || ind2 < ind) {
+                    ind = ind2;
+                    found = true;
+                }
+            }
+            if (!found && !last.empty()) {
+                ind = last;
             }
         }
 
@@ -1786,14 +2067,15 @@ int BackgroundMesh::gridFluid() {
     int ndm = OPS_GetNDM();
 
     // store cells in a vector
+    std::vector<BCellMap::iterator> iters;
+    sortedIters(bcells, iters);
     std::vector<BCell*> cells;
     VVInt indices;
-    cells.reserve(bcells.size());
-    indices.reserve(bcells.size());
-    for (std::map<VInt, BCell>::iterator it = bcells.begin();
-         it != bcells.end(); ++it) {
-        indices.push_back(it->first);
-        cells.push_back(&(it->second));
+    cells.reserve(iters.size());
+    indices.reserve(iters.size());
+    for (int j = 0; j < (int)iters.size(); ++j) {
+        indices.push_back(iters[j]->first);
+        cells.push_back(&(iters[j]->second));
     }
 
     // create elements in each cell
@@ -1937,9 +2219,11 @@ int BackgroundMesh::gridFSInoDT() {
     int ndm = OPS_GetNDM();
 
     // store cells in a vector
+    std::vector<BCellMap::iterator> iters;
+    sortedIters(bcells, iters);
     std::vector<BCell*> cells;
-    for (auto& item : bcells) {
-        auto& cell = item.second;
+    for (int j = 0; j < (int)iters.size(); ++j) {
+        auto& cell = iters[j]->second;
         if (cell.getType() == BACKGROUND_STRUCTURE) {
             cells.push_back(&cell);
         }
@@ -2506,7 +2790,7 @@ int BackgroundMesh::gridFSI() {
 
     // gather bnodes
     std::map<VInt, BNode*> fsibnodes;
-    for (std::map<VInt, BCell>::iterator it = bcells.begin();
+    for (BCellMap::iterator it = bcells.begin();
          it != bcells.end(); ++it) {
         // only for structural cells
         BCell& bcell = it->second;
@@ -2703,7 +2987,7 @@ int BackgroundMesh::gridFSI() {
                     for (int k = minind[1]; k < maxind[1]; ++k) {
                         currind[0] = j;
                         currind[1] = k;
-                        std::map<VInt, BCell>::iterator it =
+                        BCellMap::iterator it =
                             bcells.find(currind);
                         if (it == bcells.end()) {
                             outside = true;
@@ -2725,7 +3009,7 @@ int BackgroundMesh::gridFSI() {
                             currind[0] = j;
                             currind[1] = k;
                             currind[2] = l;
-                            std::map<VInt, BCell>::iterator it =
+                            BCellMap::iterator it =
                                 bcells.find(currind);
                             if (it == bcells.end()) {
                                 outside = true;
@@ -2767,7 +3051,7 @@ int BackgroundMesh::gridFSI() {
             VVInt indices;
             getCorners(ind, 1, indices);
             for (int k = 0; k < (int)indices.size(); ++k) {
-                std::map<VInt, BCell>::iterator cellit =
+                BCellMap::iterator cellit =
                     bcells.find(indices[k]);
                 if (cellit == bcells.end()) continue;
                 if (cellit->second.getType() == BACKGROUND_STRUCTURE)
@@ -3110,7 +3394,7 @@ int BackgroundMesh::moveParticles() {
     double dt = domain->getCurrentTime() - currentTime;
 
     // get current disp and velocity
-    for (std::map<VInt, BNode>::iterator it = bnodes.begin();
+    for (BNodeMap::iterator it = bnodes.begin();
          it != bnodes.end(); ++it) {
         BNode& bnode = it->second;
         VInt& tags = bnode.getTags();
@@ -3144,7 +3428,7 @@ int BackgroundMesh::moveParticles() {
     VVInt indices;
     cells.reserve(bcells.size());
     indices.reserve(bcells.size());
-    for (std::map<VInt, BCell>::iterator it = bcells.begin();
+    for (BCellMap::iterator it = bcells.begin();
          it != bcells.end(); ++it) {
         indices.push_back(it->first);
         cells.push_back(&(it->second));
@@ -3152,11 +3436,25 @@ int BackgroundMesh::moveParticles() {
 
     // move particles in each cell
     int res = 0;
-#pragma omp parallel for
+    int numLeft = 0;
+#pragma omp parallel for reduction(+ : numLeft)
     for (int j = 0; j < (int)cells.size(); ++j) {
         // get particles in cell
         const VParticle& pts = cells[j]->getPts();
 
+        // particles in structure cells will be moved out
+        if (!pts.empty() &&
+            cells[j]->getType() == BACKGROUND_STRUCTURE) {
+            ++numLeft;
+        }
+
+        // corners of this cell, shared by its particles
+        ConvectCell cell;
+        if (!pts.empty() && setConvectCell(indices[j], cell) < 0) {
+            res = -1;
+            continue;
+        }
+
         // move the particle
         for (int i = 0; i < (int)pts.size(); ++i) {
             // set update state
@@ -3164,40 +3462,125 @@ int BackgroundMesh::moveParticles() {
             pts[i]->needUpdate(dt);
 
             // convect the particle
-            if (convectParticle(pts[i], indices[j], numsub) < 0) {
+            if (convectParticle(pts[i], numsub, cell) < 0) {
                 opserr << "WARNING: failed to convect particle";
                 opserr << " -- BgMesh::moveParticles\n";
                 res = -1;
                 continue;
             }
+
+            // check if the particle left the cell
+            lowerIndex(pts[i]->getCrds(), cell.newIndex);
+            if (cell.newIndex != indices[j]) {
+                ++numLeft;
+            }
         }
     }
 
     if (res < 0) return -1;
 
+    gridChanged = (numLeft > 0);
+
+    return 0;
+}
+
+int BackgroundMesh::setConvectCell(const VInt& index,
+                                   ConvectCell& cell) {
+    int ndm = OPS_GetNDM();
+
+    cell.index = index;
+
+    VVInt temp;
+    getCorners(index, 1, temp);
+    cell.indices = temp;
+    cell.indices[2] = temp[3];
+    cell.indices[3] = temp[2];
+    if (ndm == 3) {
+        cell.indices[6] = temp[7];
+        cell.indices[7] = temp[6];
+    }
+
+    // get corner coordinates, types, and velocities
+    // pressures for structural damping
+    int numCorners = (int)cell.indices.size();
+    cell.ndtags.assign(numCorners, VInt());
+    cell.crds.assign(numCorners, VDouble());
+    cell.types.assign(numCorners, BACKGROUND_FIXED);
+    cell.vels.assign(numCorners, VDouble());
+    cell.dvns.assign(numCorners, VDouble());
+    cell.pns.assign(numCorners, 0.0);
+    cell.dpns.assign(numCorners, 0.0);
+    cell.nearStructure.assign(numCorners, false);
+
+    for (int i = 0; i < numCorners; ++i) {
+        // get crds
+        getCrds(cell.indices[i], cell.crds[i]);
+
+        // check bnode
+        auto it = bnodes.find(cell.indices[i]);
+        if (it == bnodes.end()) continue;
+
+        // get bnode
+        BNode& bnode = it->second;
+        cell.types[i] = bnode.getType();
+        if (cell.types[i] == BACKGROUND_FIXED) continue;
+
+        // get node tags
+        cell.ndtags[i] = bnode.getTags();
+
+        // get vn and dvn
+        if (bnode.getTags().size() < 1) {
+            opserr << "WARNING: fluid bnode tags.size() < 1 ";
+            opserr << "-- BgMesh::convectParticle\n";
+            return -1;
+        }
+        auto& vn = bnode.getVel();
+        auto& dvn = bnode.getAccel();
+        auto& pn = bnode.getPressure();
+        auto& dpn = bnode.getPdot();
+        if (cell.types[i] == BACKGROUND_FLUID_STRUCTURE) {
+            cell.vels[i] = vn[1];
+            cell.dvns[i] = dvn[1];
+            cell.pns[i] = pn[1];
+            cell.dpns[i] = dpn[1];
+        } else {
+            cell.vels[i] = vn[0];
+            cell.dvns[i] = dvn[0];
+            cell.pns[i] = pn[0];
+            cell.dpns[i] = dpn[0];
+        }
+
+        // check surrounding cells of fluid corners
+        if (cell.types[i] == BACKGROUND_FLUID) {
+            VInt ind = cell.indices[i];
+            VVInt around;
+            ind -= 1;
+            getCorners(ind, 1, around);
+            for (int k = 0; k < (int)around.size(); ++k) {
+                auto cellit = bcells.find(around[k]);
+                if (cellit != bcells.end() &&
+                    cellit->second.getType() == BACKGROUND_STRUCTURE) {
+                    cell.nearStructure[i] = true;
+                    break;
+                }
+            }
+        }
+    }
+
     return 0;
 }
 
-int BackgroundMesh::convectParticle(Particle* pt, VInt index,
-                                    int nums) {
+int BackgroundMesh::convectParticle(Particle* pt, int nums,
+                                    ConvectCell& cell) {
     Domain* domain = OPS_GetDomain();
     if (domain == 0) return 0;
 
-    int ndm = OPS_GetNDM();
-
     // check dt
     double dt = pt->getDt();
     if (dt <= 0) {
         return 0;
     }
 
-    // get corners
-    VVInt indices, ndtags;
-    VVDouble crds;
-    std::vector<BackgroundType> types;
-    VVDouble vels, dvns;
-    VDouble pns, dpns;
-
     // convect in a cell
     while (pt->getDt() > 0) {
         // get subdt
@@ -3209,77 +3592,16 @@ int BackgroundMesh::convectParticle(Particle* pt, VInt index,
         // particle crds
         const VDouble& pcrds = pt->getCrds();
 
-        // new index
-        VInt newIndex;
-        lowerIndex(pcrds, newIndex);
-
-        // update corners
-        if (indices.empty() || newIndex != index) {
-            index = newIndex;
-
-            VVInt temp;
-            getCorners(index, 1, temp);
-            indices = temp;
-            indices[2] = temp[3];
-            indices[3] = temp[2];
-            if (ndm == 3) {
-                indices[6] = temp[7];
-                indices[7] = temp[6];
-            }
-
-            // get corner coordinates, types, and velocities
-            // pressures for structural damping
-            ndtags.assign(indices.size(), VInt());
-            crds.assign(indices.size(), VDouble());
-            types.assign(indices.size(), BACKGROUND_FIXED);
-            vels.assign(indices.size(), VDouble());
-            dvns.assign(indices.size(), VDouble());
-            pns.assign(indices.size(), 0.0);
-            dpns.assign(indices.size(), 0.0);
-
-            for (int i = 0; i < (int)indices.size(); ++i) {
-                // get crds
-                getCrds(indices[i], crds[i]);
-
-                // check bnode
-                auto it = bnodes.find(indices[i]);
-                if (it == bnodes.end()) continue;
-
-                // get bnode
-                BNode& bnode = it->second;
-                types[i] = bnode.getType();
-                if (types[i] == BACKGROUND_FIXED) continue;
-
-                // get node tags
-                ndtags[i] = bnode.getTags();
-
-                // get vn and dvn
-                if (bnode.getTags().size() < 1) {
-                    opserr << "WARNING: fluid bnode tags.size() < 1 ";
-                    opserr << "-- BgMesh::convectParticle\n";
-                    return -1;
-                }
-                auto& vn = bnode.getVel();
-                auto& dvn = bnode.getAccel();
-                auto& pn = bnode.getPressure();
-                auto& dpn = bnode.getPdot();
-                if (types[i] == BACKGROUND_FLUID_STRUCTURE) {
-                    vels[i] = vn[1];
-                    dvns[i] = dvn[1];
-                    pns[i] = pn[1];
-                    dpns[i] = dpn[1];
-                } else {
-                    vels[i] = vn[0];
-                    dvns[i] = dvn[0];
-                    pns[i] = pn[0];
-                    dpns[i] = dpn[0];
-                }
+        // update corners if the particle is in another cell
+        lowerIndex(pcrds, cell.newIndex);
+        if (cell.indices.empty() || cell.newIndex != cell.index) {
+            if (setConvectCell(cell.newIndex, cell) < 0) {
+                return -1;
             }
         }
 
         // get particle velocity and move
-        if (interpolate(pt, indices, vels, dvns, pns, dpns, crds,
-                        types, ndtags, subdt) < 0) {
+        if (interpolate(pt, cell, subdt) < 0) {
             opserr << "WARNING: failed to interpolate particle "
                       "velocity";
             opserr << "-- BgMesh::convectParticle\n";
@@ -3290,25 +3612,29 @@ int BackgroundMesh::convectParticle(Particle* pt, VInt index,
     return 0;
 }
 
-int BackgroundMesh::interpolate(
-    Particle* pt, const VVInt& index, const VVDouble& vels,
-    const VVDouble& dvns, const VDouble& pns, const VDouble& dpns,
-    const VVDouble& crds, const std::vector<BackgroundType>& types,
-    const VVInt& ndtags, double dt) {
+int BackgroundMesh::interpolate(Particle* pt, ConvectCell& cell,
+                                double dt) {
     int ndm = OPS_GetNDM();
     Domain* domain = OPS_GetDomain();
     if (domain == 0) return 0;
 
+    const VVDouble& vels = cell.vels;
+    const VVDouble& dvns = cell.dvns;
+    const VDouble& pns = cell.pns;
+    const VDouble& dpns = cell.dpns;
+    const VVDouble& crds = cell.crds;
+    const std::vector<BackgroundType>& types = cell.types;
+
     // check
     if (ndm == 2) {
-        if (index.size() != 4) return 0;
+        if (cell.indices.size() != 4) return 0;
         if (vels.size() != 4) return 0;
         if (pns.size() != 4) return 0;
         if (dpns.size() != 4) return 0;
         if (crds.size() != 4) return 0;
         if (types.size() != 4) return 0;
     } else if (ndm == 3) {
-        if (index.size() != 8) return 0;
+        if (cell.indices.size() != 8) return 0;
         if (vels.size() != 8) return 0;
         if (pns.size() != 8) return 0;
         if (dpns.size() != 8) return 0;
@@ -3324,7 +3650,7 @@ int BackgroundMesh::interpolate(
     }
 
     // get shape functions for pt
-    VDouble N;
+    VDouble& N = cell.N;
     if (ndm == 2) {
         double hx = (crds[1][0] + crds[2][0]) / 2.0 - crds[0][0];
         double hy = (crds[2][1] + crds[3][1]) / 2.0 - crds[0][1];
@@ -3342,8 +3668,10 @@ int BackgroundMesh::interpolate(
     }
 
     // particle velocity
-    VDouble pvel(ndm);
-    VDouble pdvn(ndm);
+    VDouble& pvel = cell.pvel;
+    VDouble& pdvn = cell.pdvn;
+    pvel.assign(ndm, 0.0);
+    pdvn.assign(ndm, 0.0);
     double ppre = 0.0, pdp = 0.0;
     double Nvsum = 0.0, Npsum = 0.0;
     for (int j = 0; j < (int)vels.size(); ++j) {
@@ -3353,20 +3681,8 @@ int BackgroundMesh::interpolate(
         // interpolate
         if (types[j] == BACKGROUND_FLUID) {
 
-            // check surrounding cells
-            VInt ind = index[j];
-            VVInt indices;
-            ind -= 1;
-            getCorners(ind, 1, indices);
-            bool closeToStructure = false;
-            for (int k = 0; k < (int)indices.size(); ++k) {
-                auto it = bcells.find(indices[k]);
-                if (it != bcells.end() &&
-                    it->second.getType() == BACKGROUND_STRUCTURE) {
-                        closeToStructure = true;
-                        break;
-                }
-            }
+            // surrounding cells are checked in setConvectCell
+            bool closeToStructure = cell.nearStructure[j];
 
             // interpolate
             for (int k = 0; k < ndm; ++k) {
@@ -3406,7 +3722,8 @@ int BackgroundMesh::interpolate(
 
     // particle displacement
     // cannot travel more than one cell
-    VDouble newpcrds;
+    VDouble& newpcrds = cell.newpcrds;
+    newpcrds.clear();
     bool travel_cell = false;
     while (newpcrds.empty() || travel_cell) {
         newpcrds = pvel;
@@ -3424,32 +3741,6 @@ int BackgroundMesh::interpolate(
     // new particle coordinates
     newpcrds += pcrds;
 
-    // // find new cell
-    // VInt newindex;
-    // lowerIndex(newpcrds, newindex);
-    // auto it = bnodes.find(newindex);
-
-    // // if new cell is structure
-    // if (it != bnodes.end()) {
-    //     if (it->second.getType() == BACKGROUND_STRUCTURE) {
-    //         // check each direction
-    //         for (int i = 0; i < ndm; ++i) {
-    //             int diff = newindex[i] - index[0][i];
-    //             if (diff == 0) continue;
-    //             double out_disp = 0.0;
-    //             if (diff > 0) {
-    //                 out_disp = newpcrds[i] - crds[0][i] - bsize;
-    //                 newpcrds[i] = crds[0][i] + bsize - out_disp;
-    //                 pvel[i] = -pvel[i];
-    //             } else {
-    //                 out_disp = crds[0][i] - newpcrds[i];
-    //                 newpcrds[i] = crds[0][i] + out_disp;
-    //                 pvel[i] = -pvel[i];
-    //             }
-    //         }
-    //     }
-    // }
-
     // update particle
     if (pt->isUpdated() == false) {
         pt->setVel(pvel);
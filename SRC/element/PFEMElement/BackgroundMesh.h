@@ -42,8 +42,27 @@
 #include "BNode.h"
 #include "BackgroundDef.h"
 
+// grid cells and nodes, hashed by index; the references stay valid
+// when other entries are added
+typedef std::unordered_map<VInt, BCell, VIntHash> BCellMap;
+typedef std::unordered_map<VInt, BNode, VIntHash> BNodeMap;
+
 class BackgroundMesh {
    public:
+    // corner data of the cell a particle is convected in; shared by
+    // the particles of a cell so that it is gathered once per cell
+    // instead of once per particle, plus scratch space for interpolate
+    struct ConvectCell {
+        VInt index, newIndex;
+        VVInt indices, ndtags;
+        VVDouble crds;
+        std::vector<BackgroundType> types;
+        VVDouble vels, dvns;
+        VDouble pns, dpns;
+        VBool nearStructure;
+        VDouble N, pvel, pdvn, newpcrds;
+    };
+
     BackgroundMesh();
     virtual ~BackgroundMesh();
 
@@ -66,6 +85,7 @@ class BackgroundMesh {
     void setDispOn(bool on);
     void setRecordRange(double range) { recordRange = range; }
     void setNumAve(int num) { numave = num; }
+    void setIncremental(bool on) { incremental = on; }
 
     // remesh all
     int remesh(bool init = false);
@@ -85,12 +105,20 @@ class BackgroundMesh {
     void gatherParticles(const VInt& minindex, const VInt& maxindex,
                          VParticle& pts, bool checkfsi = false);
     int moveParticles();
-    int convectParticle(Particle* pt, VInt index, int nums);
+    int convectParticle(Particle* pt, int nums, ConvectCell& cell);
+    int setConvectCell(const VInt& index, ConvectCell& cell);
     int moveFixedParticles();
 
     // create grid nodes and elements
     int addStructure();
     int gridNodes();
+    int updateGridNodes();
+    void gridAverage(const VInt& index, const VDouble& crds, double& wt,
+                     double& pre, double& pdot, VDouble& vel,
+                     VDouble& accel);
+    bool sameGrid();
+    void structureData(VInt& data);
+    int countParticles();
     int gridFluid();
     int gridFSI();
     int gridFSInoDT();
@@ -138,11 +166,7 @@ class BackgroundMesh {
     void clearGrid();
 
     // interpolate in a cell
-    int interpolate(Particle* pt, const VVInt& index, const VVDouble& vels,
-                    const VVDouble& dvns, const VDouble& pns,
-                    const VDouble& dpns, const VVDouble& crds,
-                    const std::vector<BackgroundType>& types,
-                    const VVInt& ndtags, double dt);
+    int interpolate(Particle* pt, ConvectCell& cell, double dt);
     static int interpolate(const VVDouble& values, const VDouble& N,
                            VDouble& newvalue);
     static int interpolate(const VDouble& values, const VDouble& N,
@@ -153,8 +177,8 @@ class BackgroundMesh {
 
    private:
     VInt lower, upper;
-    std::map<VInt, BCell> bcells;
-    std::map<VInt, BNode> bnodes;
+    BCellMap bcells;
+    BNodeMap bnodes;
     double tol;
     double bsize;
     int numave, numsub;
@@ -170,6 +194,13 @@ class BackgroundMesh {
     bool dispon;
     double alphaS;  // alphaS for all structure
 
+    // incremental remesh: the grid nodes and elements are kept if no
+    // particle left its cell and the structure stayed in its cells
+    bool incremental;
+    bool gridChanged;
+    VInt lastStructure;
+    int lastNumParticles;
+
     static const int contact_tag = -13746;
 };
 
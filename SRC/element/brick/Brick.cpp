@@ -125,14 +125,12 @@ const double  Brick::wg[] = { 1.0, 1.0, 1.0, 1.0,
                               1.0, 1.0, 1.0, 1.0  } ;
 
   
-static Matrix B(6,3) ;
 
 //null constructor
 Brick::Brick( ) 
 :Element( 0, ELE_TAG_Brick ),
  connectedExternalNodes(8), applyLoad(0), load(0), Ki(0)
 {
-  B.Zero();
 
   for (int i=0; i<8; i++ ) {
     materialPointers[i] = 0;
@@ -165,8 +163,6 @@ Brick::Brick(int tag,
   :Element(tag, ELE_TAG_Brick),
    connectedExternalNodes(8), applyLoad(0), load(0), Ki(0)
 {
-  B.Zero();
-
   connectedExternalNodes(0) = node1 ;
   connectedExternalNodes(1) = node2 ;
   connectedExternalNodes(2) = node3 ;
@@ -495,19 +491,17 @@ const Matrix&  Brick::getInitialStiff( )
   static Vector strain(nstress) ;  //strain
   static double shp[nShape][numberNodes] ;  //shape functions at a gauss point
   static double Shape[nShape][numberNodes][numberGauss] ; //all the shape functions
-  static Matrix stiffJK(ndf,ndf) ; //nodeJK stiffness 
-  static Matrix dd(nstress,nstress) ;  //material tangent
+  static MatrixND<ndf,ndf> stiffJK ; //nodeJK stiffness 
+  static MatrixND<nstress,nstress> dd ;  //material tangent
 
 
   //---------B-matrices------------------------------------
 
-    static Matrix BJ(nstress,ndf) ;      // B matrix node J
+    static MatrixND<nstress,ndf> BJ ;      // B matrix node J
 
-    static Matrix BJtran(ndf,nstress) ;
-
-    static Matrix BK(nstress,ndf) ;      // B matrix node k
+    static MatrixND<nstress,ndf> BK ;      // B matrix node k
 
-    static Matrix BJtranD(ndf,nstress) ;
+    static MatrixND<ndf,nstress> BJtranD ;
 
   //-------------------------------------------------------
 
@@ -564,28 +558,21 @@ const Matrix&  Brick::getInitialStiff( )
 
 
     dd = materialPointers[i]->getInitialTangent( ) ;
-    if(theDamping[i]) dd *= theDamping[i]->getStiffnessMultiplier();
-    dd *= dvol[i] ;
+    double ddFact = dvol[i] ;
+    if(theDamping[i]) ddFact *= theDamping[i]->getStiffnessMultiplier();
     
     jj = 0;
     for ( j = 0; j < numberNodes; j++ ) {
 
-      BJ = computeB( j, shp ) ;
-   
-      //transpose 
-      //BJtran = transpose( nstress, ndf, BJ ) ;
-      for (p=0; p<ndf; p++) {
-	for (q=0; q<nstress; q++) 
-	  BJtran(p,q) = BJ(q,p) ;
-      }//end for p
-
-      //BJtranD = BJtran * dd ;
-      BJtranD.addMatrixProduct(0.0,  BJtran, dd, 1.0) ;
+      computeB( j, shp, BJ ) ;
+
+      //BJtranD = BJtran * dd * dvol ;
+      BJtranD.addMatrixTransposeProduct(0.0,  BJ, dd, ddFact) ;
       
       kk = 0 ;
       for ( k = 0; k < numberNodes; k++ ) {
 	
-	BK = computeB( k, shp ) ;
+	computeB( k, shp, BK ) ;
 	
 	
 	//stiffJK =  BJtranD * BK  ;
@@ -1090,24 +1077,22 @@ void  Brick::formResidAndTangent( int tang_flag )
 
   static Vector residJ(ndf) ; //nodeJ residual 
 
-  static Matrix stiffJK(ndf,ndf) ; //nodeJK stiffness 
+  static MatrixND<ndf,ndf> stiffJK ; //nodeJK stiffness 
 
   static Vector stress(nstress) ;  //stress
 
   static Vector dampingStress(nstress) ;  //damping stress
 
-  static Matrix dd(nstress,nstress) ;  //material tangent
+  static MatrixND<nstress,nstress> dd ;  //material tangent
 
 
   //---------B-matrices------------------------------------
 
-    static Matrix BJ(nstress,ndf) ;      // B matrix node J
+    static MatrixND<nstress,ndf> BJ ;      // B matrix node J
 
-    static Matrix BJtran(ndf,nstress) ;
+    static MatrixND<nstress,ndf> BK ;      // B matrix node k
 
-    static Matrix BK(nstress,ndf) ;      // B matrix node k
-
-    static Matrix BJtranD(ndf,nstress) ;
+    static MatrixND<ndf,nstress> BJtranD ;
 
   //-------------------------------------------------------
 
@@ -1177,10 +1162,10 @@ void  Brick::formResidAndTangent( int tang_flag )
     //multiply by volume element
     stress  *= dvol[i] ;
 
+    double ddFact = dvol[i] ;
     if ( tang_flag == 1 ) {
       dd = materialPointers[i]->getTangent( ) ;
-      if(theDamping[i]) dd *= theDamping[i]->getStiffnessMultiplier();
-      dd *= dvol[i] ;
+      if(theDamping[i]) ddFact *= theDamping[i]->getStiffnessMultiplier();
     } //end if tang_flag
 
 
@@ -1234,16 +1219,6 @@ void  Brick::formResidAndTangent( int tang_flag )
       residJ(1) += b11 * dampingStress[1] + b31 * dampingStress[3] + b41 * dampingStress[4];
       residJ(2) += b22 * dampingStress[2] + b42 * dampingStress[4] + b52 * dampingStress[5];
       
-      BJ = computeB( j, shp ) ;
-   
-      //transpose 
-      //BJtran = transpose( nstress, ndf, BJ ) ;
-      for (p=0; p<ndf; p++) {
-	for (q=0; q<nstress; q++) 
-	  BJtran(p,q) = BJ(q,p) ;
-      }//end for p
-
-
       //residual 
       for ( p = 0; p < ndf; p++ ) {
         resid( jj + p ) += residJ(p)  ;
@@ -1255,13 +1230,15 @@ void  Brick::formResidAndTangent( int tang_flag )
 
       if ( tang_flag == 1 ) {
 
-	//BJtranD = BJtran * dd ;
-	BJtranD.addMatrixProduct(0.0,  BJtran,dd,1.0) ;
+	computeB( j, shp, BJ ) ;
+
+	//BJtranD = BJtran * dd * dvol ;
+	BJtranD.addMatrixTransposeProduct(0.0,  BJ, dd, ddFact) ;
 
 	int kk = 0 ;
          for ( k = 0; k < numberNodes; k++ ) {
 
-            BK = computeB( k, shp ) ;
+            computeB( k, shp, BK ) ;
   
  
             //stiffJK =  BJtranD * BK  ;
@@ -1312,8 +1289,8 @@ void   Brick::computeBasis( )
 //*************************************************************************
 //compute B
 
-const Matrix&   
-Brick::computeB( int node, const double shp[4][8] )
+void
+Brick::computeB( int node, const double shp[4][8], MatrixND<6,3> &B )
 {
 
 //---B Matrix in standard {1,2,3} mechanics notation---------
@@ -1329,6 +1306,8 @@ Brick::computeB( int node, const double shp[4][8] )
 //
 //-------------------------------------------------------------------
 
+  B.Zero( ) ;
+
   B(0,0) = shp[0][node] ;
   B(1,1) = shp[1][node] ;
   B(2,2) = shp[2][node] ;
@@ -1342,8 +1321,6 @@ Brick::computeB( int node, const double shp[4][8] )
   B(5,0) = shp[2][node] ;
   B(5,2) = shp[0][node] ;
 
-  return B ;
-
 }
 
 //***********************************************************************
@@ -38,6 +38,7 @@
 #include <ID.h> 
 #include <Vector.h>
 #include <Matrix.h>
+#include <MatrixND.h>
 #include <Element.h>
 #include <Node.h>
 #include <NDMaterial.h>
@@ -179,7 +180,7 @@ class Brick : public Element {
     void computeBasis( ) ;
 
     //compute B matrix
-    const Matrix& computeB( int node, const double shp[4][8] ) ;
+    void computeB( int node, const double shp[4][8], MatrixND<6,3> &B ) ;
   
     //Matrix transpose
     Matrix transpose( int dim1, int dim2, const Matrix &M ) ;
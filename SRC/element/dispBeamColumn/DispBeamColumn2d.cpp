@@ -381,7 +381,8 @@ DispBeamColumn2d::DispBeamColumn2d(int tag, int nd1, int nd2,
 :Element (tag, ELE_TAG_DispBeamColumn2d), 
  numSections(numSec), theSections(0), crdTransf(0), beamInt(0),
   connectedExternalNodes(2),
-  Q(6), q(3), rho(r), cMass(cm), parameterID(0), theDamping(0)
+  Q(6), q(3), rho(r), cMass(cm), parameterID(0), theDamping(0),
+  integrL(-1.0), integrVarying(false)
 {
   // Allocate arrays of pointers to SectionForceDeformations
   theSections = new SectionForceDeformation *[numSections];
@@ -448,7 +449,8 @@ DispBeamColumn2d::DispBeamColumn2d()
  numSections(0), theSections(0), crdTransf(0), beamInt(0),
  connectedExternalNodes(2),
   Q(6), q(3), rho(0.0), cMass(0), parameterID(0),
-  theDamping(0)
+  theDamping(0),
+  integrL(-1.0), integrVarying(false)
 {
     q0[0] = 0.0;
     q0[1] = 0.0;
@@ -648,8 +650,8 @@ DispBeamColumn2d::update(void)
   double oneOverL = 1.0/L;
 
   //const Matrix &pts = quadRule.getIntegrPointCoords(numSections);
-  double xi[maxNumSections];
-  beamInt->getSectionLocations(numSections, L, xi);
+  this->formIntegration(L);
+  const double *xi = integrXi;
   
   // Loop over the integration points
   for (int i = 0; i < numSections; i++) {
@@ -695,10 +697,9 @@ DispBeamColumn2d::getBasicStiff(Matrix &kb, int initial)
   double L = crdTransf->getInitialLength();
   double oneOverL = 1.0/L;
   
-  double xi[maxNumSections];
-  beamInt->getSectionLocations(numSections, L, xi);
-  double wt[maxNumSections];
-  beamInt->getSectionWeights(numSections, L, wt);
+  this->formIntegration(L);
+  const double *xi = integrXi;
+  const double *wt = integrWt;
 
   // Loop over the integration points
   for (int i = 0; i < numSections; i++) {
@@ -771,10 +772,9 @@ DispBeamColumn2d::getTangentStiff()
   
   //const Matrix &pts = quadRule.getIntegrPointCoords(numSections);
   //const Vector &wts = quadRule.getIntegrPointWeights(numSections);
-  double xi[maxNumSections];
-  beamInt->getSectionLocations(numSections, L, xi);
-  double wt[maxNumSections];
-  beamInt->getSectionWeights(numSections, L, wt);
+  this->formIntegration(L);
+  const double *xi = integrXi;
+  const double *wt = integrWt;
 
   // Loop over the integration points
   for (int i = 0; i < numSections; i++) {
@@ -994,10 +994,9 @@ DispBeamColumn2d::getResistingForce()
   
   //const Matrix &pts = quadRule.getIntegrPointCoords(numSections);
   //const Vector &wts = quadRule.getIntegrPointWeights(numSections);  
-  double xi[maxNumSections];
-  beamInt->getSectionLocations(numSections, L, xi);
-  double wt[maxNumSections];
-  beamInt->getSectionWeights(numSections, L, wt);
+  this->formIntegration(L);
+  const double *xi = integrXi;
+  const double *wt = integrWt;
 
   // Zero for integration
   q.Zero();
@@ -1219,6 +1218,8 @@ int
 DispBeamColumn2d::recvSelf(int commitTag, Channel &theChannel,
 			   FEM_ObjectBroker &theBroker)
 {
+  integrL = -1.0;
+
   //
   // receive the integer data containing tag, numSections and coord transformation info
   //
@@ -1605,9 +1606,9 @@ DispBeamColumn2d::setResponse(const char **argv, int argc,
     if (argc > 2) {
       float sectionLoc = atof(argv[1]);
 
-      double xi[maxNumSections];
       double L = crdTransf->getInitialLength();
-      beamInt->getSectionLocations(numSections, L, xi);
+      this->formIntegration(L);
+      const double *xi = integrXi;
       
       sectionLoc /= L;
 
@@ -1637,9 +1638,9 @@ DispBeamColumn2d::setResponse(const char **argv, int argc,
 
 	output.tag("GaussPointOutput");
 	output.attr("number",sectionNum);
-	double xi[maxNumSections];
 	double L = crdTransf->getInitialLength();
-	beamInt->getSectionLocations(numSections, L, xi);
+	this->formIntegration(L);
+	const double *xi = integrXi;
 	output.attr("eta",xi[sectionNum-1]*L);
 
 	if (strcmp(argv[2],"dsdh") != 0) {
@@ -1657,9 +1658,9 @@ DispBeamColumn2d::setResponse(const char **argv, int argc,
 	
 	CompositeResponse *theCResponse = new CompositeResponse();
 	int numResponse = 0;
-	double xi[maxNumSections];
 	double L = crdTransf->getInitialLength();
-	beamInt->getSectionLocations(numSections, L, xi);
+	this->formIntegration(L);
+	const double *xi = integrXi;
 	
 	for (int i=0; i<numSections; i++) {
 	  
@@ -1838,8 +1839,8 @@ DispBeamColumn2d::getResponse(int responseID, Information &eleInfo)
 
   else if (responseID == 7) {
     //const Matrix &pts = quadRule.getIntegrPointCoords(numSections);
-    double xi[maxNumSections];
-    beamInt->getSectionLocations(numSections, L, xi);
+    this->formIntegration(L);
+    const double *xi = integrXi;
     Vector locs(numSections);
     for (int i = 0; i < numSections; i++)
       locs(i) = xi[i]*L;
@@ -1848,8 +1849,8 @@ DispBeamColumn2d::getResponse(int responseID, Information &eleInfo)
 
   else if (responseID == 8) {
     //const Vector &wts = quadRule.getIntegrPointWeights(numSections);
-    double wt[maxNumSections];
-    beamInt->getSectionWeights(numSections, L, wt);
+    this->formIntegration(L);
+    const double *wt = integrWt;
     Vector weights(numSections);
     for (int i = 0; i < numSections; i++)
       weights(i) = wt[i]*L;
@@ -1865,9 +1866,9 @@ DispBeamColumn2d::getResponse(int responseID, Information &eleInfo)
   
   //by SAJalali
   else if (responseID == 10) {
-	  double xi[maxNumSections];
 	  double L = crdTransf->getInitialLength();
-	  beamInt->getSectionWeights(numSections, L, xi);
+	  this->formIntegration(L);
+	  const double *xi = integrWt;
 	  double energy = 0;
 	  for (int i = 0; i < numSections; i++) {
 		  energy += theSections[i]->getEnergy()*xi[i] * L;
@@ -1919,8 +1920,8 @@ DispBeamColumn2d::getResponseSensitivity(int responseID, int gradNumber,
     Vector dedh(order);
 
     //const Matrix &pts = quadRule.getIntegrPointCoords(numSections);
-    double xi[maxNumSections];
-    beamInt->getSectionLocations(numSections, L, xi);
+    this->formIntegration(L);
+    const double *xi = integrXi;
 
     double x = xi[sectionNum-1];
 
@@ -1966,9 +1967,9 @@ DispBeamColumn2d::setParameter(const char **argv, int argc, Parameter &param)
       
 	float sectionLoc = atof(argv[1]);
 
-      double xi[maxNumSections];
       double L = crdTransf->getInitialLength();
-      beamInt->getSectionLocations(numSections, L, xi);
+      this->formIntegration(L);
+      const double *xi = integrXi;
       
       sectionLoc /= L;
 
@@ -2003,7 +2004,10 @@ DispBeamColumn2d::setParameter(const char **argv, int argc, Parameter &param)
     if (argc < 2)
       return -1;
 
-    return beamInt->setParameter(&argv[1], argc-1, param);
+    int ok = beamInt->setParameter(&argv[1], argc-1, param);
+    if (ok != -1)
+      integrVarying = true;
+    return ok;
   }
   
   int result =-1;
@@ -2015,8 +2019,10 @@ DispBeamColumn2d::setParameter(const char **argv, int argc, Parameter &param)
       result = ok;
   }
   ok = beamInt->setParameter(argv, argc, param);
-  if (ok != -1)
+  if (ok != -1) {
     result = ok;
+    integrVarying = true;
+  }
   return result;
 }
 
@@ -2055,10 +2061,9 @@ DispBeamColumn2d::getInitialStiffSensitivity(int gradNumber)
   double L = crdTransf->getInitialLength();
   double oneOverL = 1.0/L;
   
-  double xi[maxNumSections];
-  beamInt->getSectionLocations(numSections, L, xi);
-  double wt[maxNumSections];
-  beamInt->getSectionWeights(numSections, L, wt);
+  this->formIntegration(L);
+  const double *xi = integrXi;
+  const double *wt = integrWt;
 
   // Loop over the integration points
   for (int i = 0; i < numSections; i++) {
@@ -2170,10 +2175,9 @@ DispBeamColumn2d::getResistingForceSensitivity(int gradNumber)
   
   //const Matrix &pts = quadRule.getIntegrPointCoords(numSections);
   //const Vector &wts = quadRule.getIntegrPointWeights(numSections);
-  double xi[maxNumSections];
-  beamInt->getSectionLocations(numSections, L, xi);
-  double wt[maxNumSections];
-  beamInt->getSectionWeights(numSections, L, wt);
+  this->formIntegration(L);
+  const double *xi = integrXi;
+  const double *wt = integrWt;
 
   double dLdh = crdTransf->getdLdh();
   double d1oLdh = crdTransf->getd1overLdh();
@@ -2358,8 +2362,8 @@ DispBeamColumn2d::commitSensitivity(int gradNumber, int numGrads)
   double L = crdTransf->getInitialLength();
   double oneOverL = 1.0/L;
   //const Matrix &pts = quadRule.getIntegrPointCoords(numSections);
-  double xi[maxNumSections];
-  beamInt->getSectionLocations(numSections, L, xi);
+  this->formIntegration(L);
+  const double *xi = integrXi;
 
   // Some extra declarations
   double d1oLdh = crdTransf->getd1overLdh();
@@ -2401,3 +2405,13 @@ DispBeamColumn2d::commitSensitivity(int gradNumber, int numGrads)
 
 // AddingSensitivity:END /////////////////////////////////////////////
 
+void
+DispBeamColumn2d::formIntegration(double L)
+{
+  if (L == integrL && integrVarying == false)
+    return;
+
+  beamInt->getSectionLocations(numSections, L, integrXi);
+  beamInt->getSectionWeights(numSections, L, integrWt);
+  integrL = L;
+}
@@ -144,6 +144,14 @@ class DispBeamColumn2d : public Element
     // AddingSensitivity:BEGIN //////////////////////////////////////////
     int parameterID;
     // AddingSensitivity:END ///////////////////////////////////////////
+
+    // section locations & weights, kept for the length they were formed
+    // at; formed every time once an integration parameter is set
+    void formIntegration(double L);
+    double integrXi[maxNumSections];
+    double integrWt[maxNumSections];
+    double integrL;
+    bool integrVarying;
 };
 
 #endif
@@ -292,7 +292,8 @@ DispBeamColumn3d::DispBeamColumn3d(int tag, int nd1, int nd2,
 :Element (tag, ELE_TAG_DispBeamColumn3d),
 numSections(numSec), theSections(0), crdTransf(0), beamInt(0),
 connectedExternalNodes(2), 
-Q(12), q(6), rho(r), cMass(cm), parameterID(0), theDamping(0)
+Q(12), q(6), rho(r), cMass(cm), parameterID(0), theDamping(0),
+integrL(-1.0), integrVarying(false)
 {
   // Allocate arrays of pointers to SectionForceDeformations
   theSections = new SectionForceDeformation *[numSections];
@@ -364,7 +365,8 @@ DispBeamColumn3d::DispBeamColumn3d()
 numSections(0), theSections(0), crdTransf(0), beamInt(0),
 connectedExternalNodes(2), 
 Q(12), q(6), rho(0.0), cMass(0), parameterID(0),
-theDamping(0)
+theDamping(0),
+integrL(-1.0), integrVarying(false)
 {
   q0[0] = 0.0;
   q0[1] = 0.0;
@@ -571,8 +573,8 @@ DispBeamColumn3d::update(void)
   double oneOverL = 1.0/L;
   
   //const Matrix &pts = quadRule.getIntegrPointCoords(numSections);
-  double xi[maxNumSections];
-  beamInt->getSectionLocations(numSections, L, xi);
+  this->formIntegration(L);
+  const double *xi = integrXi;
 
   // Loop over the integration points
   for (int i = 0; i < numSections; i++) {
@@ -630,10 +632,9 @@ DispBeamColumn3d::getTangentStiff()
 
   //const Matrix &pts = quadRule.getIntegrPointCoords(numSections);
   //const Vector &wts = quadRule.getIntegrPointWeights(numSections);
-  double xi[maxNumSections];
-  beamInt->getSectionLocations(numSections, L, xi);
-  double wt[maxNumSections];
-  beamInt->getSectionWeights(numSections, L, wt);
+  this->formIntegration(L);
+  const double *xi = integrXi;
+  const double *wt = integrWt;
 
   // Loop over the integration points
   for (int i = 0; i < numSections; i++) {
@@ -759,10 +760,9 @@ DispBeamColumn3d::getBasicStiff(Matrix &kb, int initial)
 
   //const Matrix &pts = quadRule.getIntegrPointCoords(numSections);
   //const Vector &wts = quadRule.getIntegrPointWeights(numSections);
-  double xi[maxNumSections];
-  beamInt->getSectionLocations(numSections, L, xi);
-  double wt[maxNumSections];
-  beamInt->getSectionWeights(numSections, L, wt);
+  this->formIntegration(L);
+  const double *xi = integrXi;
+  const double *wt = integrWt;
   
   // Loop over the integration points
   for (int i = 0; i < numSections; i++) {
@@ -1055,10 +1055,9 @@ DispBeamColumn3d::getResistingForce()
 
   //const Matrix &pts = quadRule.getIntegrPointCoords(numSections);
   //const Vector &wts = quadRule.getIntegrPointWeights(numSections);
-  double xi[maxNumSections];
-  beamInt->getSectionLocations(numSections, L, xi);
-  double wt[maxNumSections];
-  beamInt->getSectionWeights(numSections, L, wt);
+  this->formIntegration(L);
+  const double *xi = integrXi;
+  const double *wt = integrWt;
 
   // Zero for integration
   q.Zero();
@@ -1289,6 +1288,8 @@ int
 DispBeamColumn3d::recvSelf(int commitTag, Channel &theChannel,
 						FEM_ObjectBroker &theBroker)
 {
+  integrL = -1.0;
+
   //
   // receive the integer data containing tag, numSections and coord transformation info
   //
@@ -1727,9 +1728,9 @@ DispBeamColumn3d::setResponse(const char **argv, int argc, OPS_Stream &output)
       if (argc > 2) {
 	float sectionLoc = atof(argv[1]);
 	
-	double xi[maxNumSections];
 	double L = crdTransf->getInitialLength();
-	beamInt->getSectionLocations(numSections, L, xi);
+	this->formIntegration(L);
+	const double *xi = integrXi;
 	
 	sectionLoc /= L;
 	
@@ -1757,9 +1758,9 @@ DispBeamColumn3d::setResponse(const char **argv, int argc, OPS_Stream &output)
 
 	if (sectionNum > 0 && sectionNum <= numSections && argc > 2) {
 	  
-	  double xi[maxNumSections];
 	  double L = crdTransf->getInitialLength();
-	  beamInt->getSectionLocations(numSections, L, xi);
+	  this->formIntegration(L);
+	  const double *xi = integrXi;
 	  
 	  output.tag("GaussPointOutput");
 	  output.attr("number",sectionNum);
@@ -1772,9 +1773,9 @@ DispBeamColumn3d::setResponse(const char **argv, int argc, OPS_Stream &output)
 	
 	  CompositeResponse *theCResponse = new CompositeResponse();
 	  int numResponse = 0;
-	  double xi[maxNumSections];
 	  double L = crdTransf->getInitialLength();
-	  beamInt->getSectionLocations(numSections, L, xi);
+	  this->formIntegration(L);
+	  const double *xi = integrXi;
 	  
 	  for (int i=0; i<numSections; i++) {
 	    
@@ -1921,8 +1922,8 @@ DispBeamColumn3d::getResponse(int responseID, Information &eleInfo)
 
   else if (responseID == 10) {
     double L = crdTransf->getInitialLength();
-    double pts[maxNumSections];
-    beamInt->getSectionLocations(numSections, L, pts);
+    this->formIntegration(L);
+    const double *pts = integrXi;
     Vector locs(numSections);
     for (int i = 0; i < numSections; i++)
       locs(i) = pts[i]*L;
@@ -1931,8 +1932,8 @@ DispBeamColumn3d::getResponse(int responseID, Information &eleInfo)
 
   else if (responseID == 11) {
     double L = crdTransf->getInitialLength();
-    double wts[maxNumSections];
-    beamInt->getSectionWeights(numSections, L, wts);
+    this->formIntegration(L);
+    const double *wts = integrWt;
     Vector weights(numSections);
     for (int i = 0; i < numSections; i++)
       weights(i) = wts[i]*L;
@@ -1948,9 +1949,9 @@ DispBeamColumn3d::getResponse(int responseID, Information &eleInfo)
   
   //by SAJalali
   else if (responseID == 13) {
-	  double xi[maxNumSections];
 	  double L = crdTransf->getInitialLength();
-	  beamInt->getSectionWeights(numSections, L, xi);
+	  this->formIntegration(L);
+	  const double *xi = integrWt;
 	  double energy = 0;
 	  for (int i = 0; i < numSections; i++) {
 		  energy += theSections[i]->getEnergy()*xi[i] * L;
@@ -1986,9 +1987,9 @@ DispBeamColumn3d::setParameter(const char **argv, int argc, Parameter &param)
       
 	float sectionLoc = atof(argv[1]);
 
-      double xi[maxNumSections];
       double L = crdTransf->getInitialLength();
-      beamInt->getSectionLocations(numSections, L, xi);
+      this->formIntegration(L);
+      const double *xi = integrXi;
       
       sectionLoc /= L;
 
@@ -2022,7 +2023,10 @@ DispBeamColumn3d::setParameter(const char **argv, int argc, Parameter &param)
     if (argc < 2)
       return -1;
 
-    return beamInt->setParameter(&argv[1], argc-1, param);
+    int ok = beamInt->setParameter(&argv[1], argc-1, param);
+    if (ok != -1)
+      integrVarying = true;
+    return ok;
   }
 
   // Default, send to every object
@@ -2036,8 +2040,10 @@ DispBeamColumn3d::setParameter(const char **argv, int argc, Parameter &param)
   }
   
   ok = beamInt->setParameter(argv, argc, param);
-  if (ok != -1)
+  if (ok != -1) {
     result = ok;
+    integrVarying = true;
+  }
 
   return result;
 }
@@ -2130,10 +2136,9 @@ DispBeamColumn3d::getResistingForceSensitivity(int gradNumber)
   
   //const Matrix &pts = quadRule.getIntegrPointCoords(numSections);
   //const Vector &wts = quadRule.getIntegrPointWeights(numSections);
-  double xi[maxNumSections];
-  beamInt->getSectionLocations(numSections, L, xi);
-  double wt[maxNumSections];
-  beamInt->getSectionWeights(numSections, L, wt);
+  this->formIntegration(L);
+  const double *xi = integrXi;
+  const double *wt = integrWt;
 
   // Zero for integration
   static Vector dqdh(6);
@@ -2318,8 +2323,8 @@ DispBeamColumn3d::commitSensitivity(int gradNumber, int numGrads)
   double L = crdTransf->getInitialLength();
   double oneOverL = 1.0/L;
   //const Matrix &pts = quadRule.getIntegrPointCoords(numSections);
-  double xi[maxNumSections];
-  beamInt->getSectionLocations(numSections, L, xi);
+  this->formIntegration(L);
+  const double *xi = integrXi;
 
   // Some extra declarations
   double d1oLdh = crdTransf->getd1overLdh();
@@ -2369,3 +2374,13 @@ DispBeamColumn3d::commitSensitivity(int gradNumber, int numGrads)
 
 // AddingSensitivity:END /////////////////////////////////////////////
 
+void
+DispBeamColumn3d::formIntegration(double L)
+{
+  if (L == integrL && integrVarying == false)
+    return;
+
+  beamInt->getSectionLocations(numSections, L, integrXi);
+  beamInt->getSectionWeights(numSections, L, integrWt);
+  integrL = L;
+}
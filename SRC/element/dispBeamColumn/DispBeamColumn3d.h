@@ -140,6 +140,14 @@ class DispBeamColumn3d : public Element
     enum {maxNumSections = 20};
 
     static double workArea[];
+
+    // section locations & weights, kept for the length they were formed
+    // at; formed every time once an integration parameter is set
+    void formIntegration(double L);
+    double integrXi[maxNumSections];
+    double integrWt[maxNumSections];
+    double integrL;
+    bool integrVarying;
 };
 
 #endif
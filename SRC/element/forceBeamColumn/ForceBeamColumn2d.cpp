@@ -684,7 +684,8 @@ ForceBeamColumn2d::ForceBeamColumn2d():
   fs(0), vs(0), Ssr(0), vscommit(0), 
   numEleLoads(0), sizeEleLoads(0), eleLoads(0), eleLoadFactors(0), load(6),
   Ki(0), maxSubdivisions(1), subdivideFactor(1.0), parameterID(0),
-  theDamping(0)
+  theDamping(0),
+  integrL(-1.0), integrVarying(false)
 {
   load.Zero();
 
@@ -711,7 +712,8 @@ ForceBeamColumn2d::ForceBeamColumn2d (int tag, int nodeI, int nodeJ,
   fs(0), vs(0),Ssr(0), vscommit(0), 
   numEleLoads(0), sizeEleLoads(0), eleLoads(0), eleLoadFactors(0), load(6),
   Ki(0), maxSubdivisions(maxNumSub), subdivideFactor(subFac), parameterID(0),
-  theDamping(0)
+  theDamping(0),
+  integrL(-1.0), integrVarying(false)
 {
   if (maxSubdivisions < 1)
     maxSubdivisions = 1;
@@ -1253,11 +1255,10 @@ ForceBeamColumn2d::update()
   double L = crdTransf->getInitialLength();
   double oneOverL  = 1.0/L;  
 
-  double xi[maxNumSections];
-  beamIntegr->getSectionLocations(numSections, L, xi);
+  this->formIntegration(L);
+  const double *xi = integrXi;
   
-  double wt[maxNumSections];
-  beamIntegr->getSectionWeights(numSections, L, wt);
+  const double *wt = integrWt;
 
   static Vector vr(NEBD);       // element residual displacements
   static Matrix f(NEBD,NEBD);   // element flexibility matrix
@@ -1702,8 +1703,8 @@ ForceBeamColumn2d::computeSectionForces(Vector &sp, int isec)
 
   double L = crdTransf->getInitialLength();
 
-  double xi[maxNumSections];
-  beamIntegr->getSectionLocations(numSections, L, xi);
+  this->formIntegration(L);
+  const double *xi = integrXi;
   double x = xi[isec]*L;
 
   int order = sections[isec]->getOrder();
@@ -1863,8 +1864,8 @@ ForceBeamColumn2d::computeSectionForceSensitivity(Vector &dspdh, int isec,
   double L = crdTransf->getInitialLength();
   double dLdh = crdTransf->getdLdh();
 
-  double xi[maxNumSections];
-  beamIntegr->getSectionLocations(numSections, L, xi);
+  this->formIntegration(L);
+  const double *xi = integrXi;
 
   double dxidh[maxNumSections];
   beamIntegr->getLocationsDeriv(numSections, L, dLdh, dxidh);
@@ -2190,6 +2191,8 @@ ForceBeamColumn2d::sendSelf(int commitTag, Channel &theChannel)
 int
 ForceBeamColumn2d::recvSelf(int commitTag, Channel &theChannel, FEM_ObjectBroker &theBroker)
 {
+  integrL = -1.0;
+
   //
   // receive the integer data containing tag, numSections and coord transformation info
   //
@@ -2507,11 +2510,10 @@ ForceBeamColumn2d::getInitialFlexibility(Matrix &fe)
   double L = crdTransf->getInitialLength();
   double oneOverL  = 1.0/L;  
   
-  double xi[maxNumSections];
-  beamIntegr->getSectionLocations(numSections, L, xi);
+  this->formIntegration(L);
+  const double *xi = integrXi;
   
-  double wt[maxNumSections];
-  beamIntegr->getSectionWeights(numSections, L, wt);
+  const double *wt = integrWt;
   
   for (int i = 0; i < numSections; i++) {
     
@@ -2591,11 +2593,10 @@ ForceBeamColumn2d::getInitialDeformations(Vector &v0)
   double L = crdTransf->getInitialLength();
   double oneOverL  = 1.0/L;
 
-  double xi[maxNumSections];
-  beamIntegr->getSectionLocations(numSections, L, xi);
+  this->formIntegration(L);
+  const double *xi = integrXi;
   
-  double wt[maxNumSections];
-  beamIntegr->getSectionWeights(numSections, L, wt);
+  const double *wt = integrWt;
   
   for (int i = 0; i < numSections; i++) {
     
@@ -3044,9 +3045,9 @@ ForceBeamColumn2d::setResponse(const char **argv, int argc, OPS_Stream &output)
     if (argc > 2) {
       float sectionLoc = atof(argv[1]);
 
-      double xi[maxNumSections];
       double L = crdTransf->getInitialLength();
-      beamIntegr->getSectionLocations(numSections, L, xi);
+      this->formIntegration(L);
+      const double *xi = integrXi;
       
       sectionLoc /= L;
 
@@ -3083,9 +3084,9 @@ ForceBeamColumn2d::setResponse(const char **argv, int argc, OPS_Stream &output)
 
       if (sectionNum > 0 && sectionNum <= numSections && argc > 2) {
 
-	double xi[maxNumSections];
 	double L = crdTransf->getInitialLength();
-	beamIntegr->getSectionLocations(numSections, L, xi);
+	this->formIntegration(L);
+	const double *xi = integrXi;
 
 	output.tag("GaussPointOutput");
 	output.attr("number",sectionNum);
@@ -3106,9 +3107,9 @@ ForceBeamColumn2d::setResponse(const char **argv, int argc, OPS_Stream &output)
 
 	CompositeResponse *theCResponse = new CompositeResponse();
 	int numResponse = 0;
-	double xi[maxNumSections];
 	double L = crdTransf->getInitialLength();
-	beamIntegr->getSectionLocations(numSections, L, xi);
+	this->formIntegration(L);
+	const double *xi = integrXi;
 
 	for (int i=0; i<numSections; i++) {
 
@@ -3215,11 +3216,10 @@ ForceBeamColumn2d::getResponse(int responseID, Information &eleInfo)
     if (fabs(Se(1)+Se(2)) > DBL_EPSILON)
       LI = Se(1)/(Se(1)+Se(2))*L;
       
-    double wts[maxNumSections];
-    beamIntegr->getSectionWeights(numSections, L, wts);
+    this->formIntegration(L);
+    const double *wts = integrWt;
     
-    double pts[maxNumSections];
-    beamIntegr->getSectionLocations(numSections, L, pts);
+    const double *pts = integrXi;
     
     int i;
     for (i = 0; i < numSections; i++) {
@@ -3302,8 +3302,8 @@ ForceBeamColumn2d::getResponse(int responseID, Information &eleInfo)
 
   else if (responseID == 10) {
     double L = crdTransf->getInitialLength();
-    double pts[maxNumSections];
-    beamIntegr->getSectionLocations(numSections, L, pts);
+    this->formIntegration(L);
+    const double *pts = integrXi;
     Vector locs(numSections);
     for (int i = 0; i < numSections; i++)
       locs(i) = pts[i]*L;
@@ -3312,8 +3312,8 @@ ForceBeamColumn2d::getResponse(int responseID, Information &eleInfo)
 
   else if (responseID == 11) {
     double L = crdTransf->getInitialLength();
-    double wts[maxNumSections];
-    beamIntegr->getSectionWeights(numSections, L, wts);
+    this->formIntegration(L);
+    const double *wts = integrWt;
     Vector weights(numSections);
     for (int i = 0; i < numSections; i++)
       weights(i) = wts[i]*L;
@@ -3329,8 +3329,8 @@ ForceBeamColumn2d::getResponse(int responseID, Information &eleInfo)
   
   else if (responseID == 111) {
     double L = crdTransf->getInitialLength();
-    double pts[maxNumSections];
-    beamIntegr->getSectionLocations(numSections, L, pts);
+    this->formIntegration(L);
+    const double *pts = integrXi;
     // CBDI influence matrix
     Matrix ls(numSections, numSections);
     getCBDIinfluenceMatrix(numSections, pts, L, ls);
@@ -3347,7 +3347,6 @@ ForceBeamColumn2d::getResponse(int responseID, Information &eleInfo)
     // Displacement vector
     Vector dispsy(numSections);
     dispsy.addMatrixVector(0.0, ls, kappa, 1.0);
-    beamIntegr->getSectionLocations(numSections, L, pts);
     static Vector uxb(2);
     static Vector uxg(2);
     Matrix disps(numSections,3);
@@ -3365,8 +3364,8 @@ ForceBeamColumn2d::getResponse(int responseID, Information &eleInfo)
 
   else if (responseID == 112) {
     double L = crdTransf->getInitialLength();
-    double ipts[maxNumSections];
-    beamIntegr->getSectionLocations(numSections, L, ipts);
+    this->formIntegration(L);
+    const double *ipts = integrXi;
     // CBDI influence matrix
     double pts[1];
     pts[0] = eleInfo.theDouble;
@@ -3401,9 +3400,9 @@ ForceBeamColumn2d::getResponse(int responseID, Information &eleInfo)
   
   //by SAJalali
   else if (responseID == 14) {
-	  double xi[maxNumSections];
 	  double L = crdTransf->getInitialLength();
-	  beamIntegr->getSectionWeights(numSections, L, xi);
+	  this->formIntegration(L);
+	  const double *xi = integrWt;
 	  double energy = 0;
 	  for (int i = 0; i < numSections; i++) {
 		  energy += sections[i]->getEnergy()*xi[i] * L;
@@ -3464,8 +3463,8 @@ ForceBeamColumn2d::getResponseSensitivity(int responseID, int gradNumber,
  
     double L = crdTransf->getInitialLength();
     double oneOverL  = 1.0/L;  
-    double pts[maxNumSections];
-    beamIntegr->getSectionLocations(numSections, L, pts);
+    this->formIntegration(L);
+    const double *pts = integrXi;
     
     const ID &code = sections[sectionNum-1]->getType();
       
@@ -3584,9 +3583,9 @@ ForceBeamColumn2d::setParameter(const char **argv, int argc, Parameter &param)
     if (argc > 2) {
       float sectionLoc = atof(argv[1]);
 
-      double xi[maxNumSections];
       double L = crdTransf->getInitialLength();
-      beamIntegr->getSectionLocations(numSections, L, xi);
+      this->formIntegration(L);
+      const double *xi = integrXi;
       
       sectionLoc /= L;
 
@@ -3634,7 +3633,10 @@ ForceBeamColumn2d::setParameter(const char **argv, int argc, Parameter &param)
     if (argc < 2)
       return -1;
 
-    return beamIntegr->setParameter(&argv[1], argc-1, param);
+    int ok = beamIntegr->setParameter(&argv[1], argc-1, param);
+    if (ok != -1)
+      integrVarying = true;
+    return ok;
   }
 
   // Default, send to everything
@@ -3647,8 +3649,10 @@ ForceBeamColumn2d::setParameter(const char **argv, int argc, Parameter &param)
   }
   
   ok = beamIntegr->setParameter(argv, argc, param);
-  if (ok != -1)
+  if (ok != -1) {
     result = ok;
+    integrVarying = true;
+  }
 
   return result;
 }
@@ -3729,11 +3733,8 @@ ForceBeamColumn2d::commitSensitivity(int gradNumber, int numGrads)
   double L = crdTransf->getInitialLength();
   double oneOverL = 1.0/L;
   
-  double pts[maxNumSections];
-  beamIntegr->getSectionLocations(numSections, L, pts);
-  
-  double wts[maxNumSections];
-  beamIntegr->getSectionWeights(numSections, L, wts);
+  this->formIntegration(L);
+  const double *pts = integrXi;
 
   double dLdh = crdTransf->getdLdh();
 
@@ -3825,11 +3826,10 @@ ForceBeamColumn2d::computedqdh(int gradNumber)
   double L = crdTransf->getInitialLength();
   double oneOverL = 1.0/L;
   
-  double pts[maxNumSections];
-  beamIntegr->getSectionLocations(numSections, L, pts);
+  this->formIntegration(L);
+  const double *pts = integrXi;
   
-  double wts[maxNumSections];
-  beamIntegr->getSectionWeights(numSections, L, wts);
+  const double *wts = integrWt;
 
   double dLdh = crdTransf->getdLdh();
 
@@ -3962,11 +3962,10 @@ ForceBeamColumn2d::computedfedh(int gradNumber)
   double dLdh = crdTransf->getdLdh();
   double d1oLdh = crdTransf->getd1overLdh();
 
-  double xi[maxNumSections];
-  beamIntegr->getSectionLocations(numSections, L, xi);
+  this->formIntegration(L);
+  const double *xi = integrXi;
   
-  double wt[maxNumSections];
-  beamIntegr->getSectionWeights(numSections, L, wt);
+  const double *wt = integrWt;
 
   double dptsdh[maxNumSections];
   beamIntegr->getLocationsDeriv(numSections, L, dLdh, dptsdh);
@@ -4073,3 +4072,14 @@ ForceBeamColumn2d::computedfedh(int gradNumber)
   
   return dfedh;
 }
+
+void
+ForceBeamColumn2d::formIntegration(double L)
+{
+  if (L == integrL && integrVarying == false)
+    return;
+
+  beamIntegr->getSectionLocations(numSections, L, integrXi);
+  beamIntegr->getSectionWeights(numSections, L, integrWt);
+  integrL = L;
+}
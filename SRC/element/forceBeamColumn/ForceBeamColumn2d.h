@@ -222,6 +222,14 @@ class ForceBeamColumn2d: public Element
   // AddingSensitivity:END ///////////////////////////////////////////
 
   Damping *theDamping;
+
+  // section locations & weights, kept for the length they were formed
+  // at; formed every time once an integration parameter is set
+  void formIntegration(double L);
+  double integrXi[maxNumSections];
+  double integrWt[maxNumSections];
+  double integrL;
+  bool integrVarying;
 };
 
 #endif
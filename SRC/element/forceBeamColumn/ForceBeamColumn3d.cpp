@@ -390,7 +390,8 @@ ForceBeamColumn3d::ForceBeamColumn3d():
   fs(0), vs(0), Ssr(0), vscommit(0),
   numEleLoads(0), sizeEleLoads(0), eleLoads(0), eleLoadFactors(0), load(12),
   Ki(0), isTorsion(false), maxSubdivisions(1), subdivideFactor(1.0), parameterID(0),
-  theDamping(0)
+  theDamping(0),
+  integrL(-1.0), integrVarying(false)
 {
   load.Zero();
 
@@ -417,7 +418,8 @@ ForceBeamColumn3d::ForceBeamColumn3d (int tag, int nodeI, int nodeJ,
   fs(0), vs(0),Ssr(0), vscommit(0),
   numEleLoads(0), sizeEleLoads(0), eleLoads(0), eleLoadFactors(0), load(12),
   Ki(0), isTorsion(false), maxSubdivisions(maxNumSub), subdivideFactor(subFac), parameterID(0),
-  theDamping(0)
+  theDamping(0),
+  integrL(-1.0), integrVarying(false)
 {
   if (maxSubdivisions < 1)
     maxSubdivisions = 1;
@@ -967,11 +969,10 @@ void
     double L = crdTransf->getInitialLength();
     double oneOverL  = 1.0/L;  
 
-    double xi[maxNumSections];
-    beamIntegr->getSectionLocations(numSections, L, xi);
+    this->formIntegration(L);
+    const double *xi = integrXi;
 
-    double wt[maxNumSections];
-    beamIntegr->getSectionWeights(numSections, L, wt);
+    const double *wt = integrWt;
 
     static Vector vr(NEBD);       // element residual displacements
     static Matrix f(NEBD,NEBD);   // element flexibility matrix
@@ -1524,8 +1525,8 @@ ForceBeamColumn3d::computeSectionForces(Vector &sp, int isec)
 
   double L = crdTransf->getInitialLength();
 
-  double xi[maxNumSections];
-  beamIntegr->getSectionLocations(numSections, L, xi);
+  this->formIntegration(L);
+  const double *xi = integrXi;
   double x = xi[isec]*L;
 
   int order = sections[isec]->getOrder();
@@ -1723,8 +1724,8 @@ ForceBeamColumn3d::computeSectionForceSensitivity(Vector &dspdh, int isec,
   double L = crdTransf->getInitialLength();
   double dLdh = crdTransf->getdLdh();
 
-  double xi[maxNumSections];
-  beamIntegr->getSectionLocations(numSections, L, xi);
+  this->formIntegration(L);
+  const double *xi = integrXi;
 
   double dxidh[maxNumSections];
   beamIntegr->getLocationsDeriv(numSections, L, dLdh, dxidh);
@@ -2086,6 +2087,8 @@ ForceBeamColumn3d::computeSectionForceSensitivity(Vector &dspdh, int isec,
   int
   ForceBeamColumn3d::recvSelf(int commitTag, Channel &theChannel, FEM_ObjectBroker &theBroker)
   {
+  integrL = -1.0;
+
     //
     // receive the integer data containing tag, numSections and coord transformation info
     //
@@ -2403,11 +2406,10 @@ ForceBeamColumn3d::computeSectionForceSensitivity(Vector &dspdh, int isec,
     double L = crdTransf->getInitialLength();
     double oneOverL  = 1.0/L;  
 
-    double xi[maxNumSections];
-    beamIntegr->getSectionLocations(numSections, L, xi);
+    this->formIntegration(L);
+    const double *xi = integrXi;
 
-    double wt[maxNumSections];
-    beamIntegr->getSectionWeights(numSections, L, wt);
+    const double *wt = integrWt;
 
     for (int i = 0; i < numSections; i++) {
 
@@ -2526,11 +2528,10 @@ ForceBeamColumn3d::getInitialDeformations(Vector &v0)
   double L = crdTransf->getInitialLength();
   double oneOverL = 1.0 / L;
 
-  double xi[maxNumSections];
-  beamIntegr->getSectionLocations(numSections, L, xi);
+  this->formIntegration(L);
+  const double *xi = integrXi;
 
-  double wt[maxNumSections];
-  beamIntegr->getSectionWeights(numSections, L, wt);
+  const double *wt = integrWt;
 
   for (int i = 0; i < numSections; i++) {
 
@@ -3060,9 +3061,9 @@ ForceBeamColumn3d::getInitialDeformations(Vector &v0)
     } else if (strcmp(argv[0],"sections") ==0) { 
       CompositeResponse *theCResponse = new CompositeResponse();
       int numResponse = 0;
-      double xi[maxNumSections];
       double L = crdTransf->getInitialLength();
-      beamIntegr->getSectionLocations(numSections, L, xi);
+      this->formIntegration(L);
+      const double *xi = integrXi;
       
       for (int i=0; i<numSections; i++) {
 	
@@ -3107,9 +3108,9 @@ ForceBeamColumn3d::getInitialDeformations(Vector &v0)
       if (argc > 2) {
 	float sectionLoc = atof(argv[1]);
 	
-	double xi[maxNumSections];
 	double L = crdTransf->getInitialLength();
-	beamIntegr->getSectionLocations(numSections, L, xi);
+	this->formIntegration(L);
+	const double *xi = integrXi;
 	
 	sectionLoc /= L;
 	
@@ -3137,9 +3138,9 @@ ForceBeamColumn3d::getInitialDeformations(Vector &v0)
 	int sectionNum = atoi(argv[1]);
 	
 	if (sectionNum > 0 && sectionNum <= numSections && argc > 2) {
-	  double xi[maxNumSections];
 	  double L = crdTransf->getInitialLength();
-	  beamIntegr->getSectionLocations(numSections, L, xi);
+	  this->formIntegration(L);
+	  const double *xi = integrXi;
 	  
 	  output.tag("GaussPointOutput");
 	  output.attr("number",sectionNum);
@@ -3160,9 +3161,9 @@ ForceBeamColumn3d::getInitialDeformations(Vector &v0)
 
 	  CompositeResponse *theCResponse = new CompositeResponse();
 	  int numResponse = 0;
-	  double xi[maxNumSections];
 	  double L = crdTransf->getInitialLength();
-	  beamIntegr->getSectionLocations(numSections, L, xi);
+	  this->formIntegration(L);
+	  const double *xi = integrXi;
 	  
 	  for (int i=0; i<numSections; i++) {
 	    
@@ -3311,8 +3312,8 @@ ForceBeamColumn3d::getResponse(int responseID, Information &eleInfo)
 
   else if (responseID == 10) {
     double L = crdTransf->getInitialLength();
-    double pts[maxNumSections];
-    beamIntegr->getSectionLocations(numSections, L, pts);
+    this->formIntegration(L);
+    const double *pts = integrXi;
     Vector locs(numSections);
     for (int i = 0; i < numSections; i++)
       locs(i) = pts[i]*L;
@@ -3321,8 +3322,8 @@ ForceBeamColumn3d::getResponse(int responseID, Information &eleInfo)
 
   else if (responseID == 11) {
     double L = crdTransf->getInitialLength();
-    double wts[maxNumSections];
-    beamIntegr->getSectionWeights(numSections, L, wts);
+    this->formIntegration(L);
+    const double *wts = integrWt;
     Vector weights(numSections);
     for (int i = 0; i < numSections; i++)
       weights(i) = wts[i]*L;
@@ -3338,8 +3339,8 @@ ForceBeamColumn3d::getResponse(int responseID, Information &eleInfo)
   
   else if (responseID == 111 || responseID == 1111) {
     double L = crdTransf->getInitialLength();
-    double pts[maxNumSections];
-    beamIntegr->getSectionLocations(numSections, L, pts);
+    this->formIntegration(L);
+    const double *pts = integrXi;
     // CBDI influence matrix
     Matrix ls(numSections, numSections);
     getCBDIinfluenceMatrix(numSections, pts, L, ls);
@@ -3362,7 +3363,6 @@ ForceBeamColumn3d::getResponse(int responseID, Information &eleInfo)
     Vector dispsz(numSections); // along local z    
     dispsy.addMatrixVector(0.0, ls, kappaz,  1.0);
     dispsz.addMatrixVector(0.0, ls, kappay, -1.0);    
-    beamIntegr->getSectionLocations(numSections, L, pts);
     static Vector uxb(3);
     static Vector uxg(3);
     Matrix disps(numSections,3);
@@ -3384,8 +3384,8 @@ ForceBeamColumn3d::getResponse(int responseID, Information &eleInfo)
 
   else if (responseID == 112) {
     double L = crdTransf->getInitialLength();
-    double ipts[maxNumSections];
-    beamIntegr->getSectionLocations(numSections, L, ipts);
+    this->formIntegration(L);
+    const double *ipts = integrXi;
     // CBDI influence matrix
     double pts[1];
     pts[0] = eleInfo.theDouble;
@@ -3454,11 +3454,10 @@ ForceBeamColumn3d::getResponse(int responseID, Information &eleInfo)
 
     double L = crdTransf->getInitialLength();
 
-    double wts[maxNumSections];
-    beamIntegr->getSectionWeights(numSections, L, wts);
+    this->formIntegration(L);
+    const double *wts = integrWt;
 
-    double pts[maxNumSections];
-    beamIntegr->getSectionLocations(numSections, L, pts);
+    const double *pts = integrXi;
 
     // Location of inflection point from node I
     double LIz = 0.0;
@@ -3639,9 +3638,9 @@ ForceBeamColumn3d::getResponse(int responseID, Information &eleInfo)
   }
   //by SAJalali
   else if (responseID == 10) {
-	  double xi[maxNumSections];
 	  double L = crdTransf->getInitialLength();
-	  beamIntegr->getSectionWeights(numSections, L, xi);
+	  this->formIntegration(L);
+	  const double *xi = integrWt;
 	  double energy = 0;
 	  for (int i = 0; i < numSections; i++) {
 		  energy += sections[i]->getEnergy()*xi[i] * L;
@@ -3702,8 +3701,8 @@ ForceBeamColumn3d::getResponseSensitivity(int responseID, int gradNumber,
  
     double L = crdTransf->getInitialLength();
     double oneOverL  = 1.0/L;  
-    double pts[maxNumSections];
-    beamIntegr->getSectionLocations(numSections, L, pts);
+    this->formIntegration(L);
+    const double *pts = integrXi;
     
     const ID &code = sections[sectionNum-1]->getType();
       
@@ -3838,9 +3837,9 @@ ForceBeamColumn3d::setParameter(const char **argv, int argc, Parameter &param)
     if (argc > 2) {
       float sectionLoc = atof(argv[1]);
 
-      double xi[maxNumSections];
       double L = crdTransf->getInitialLength();
-      beamIntegr->getSectionLocations(numSections, L, xi);
+      this->formIntegration(L);
+      const double *xi = integrXi;
       
       sectionLoc /= L;
 
@@ -3894,7 +3893,10 @@ ForceBeamColumn3d::setParameter(const char **argv, int argc, Parameter &param)
     if (argc < 2)
       return -1;
 
-    return beamIntegr->setParameter(&argv[1], argc-1, param);
+    int ok = beamIntegr->setParameter(&argv[1], argc-1, param);
+    if (ok != -1)
+      integrVarying = true;
+    return ok;
   }
 
   // Default, send to everything
@@ -3907,8 +3909,10 @@ ForceBeamColumn3d::setParameter(const char **argv, int argc, Parameter &param)
   }
 
   ok = beamIntegr->setParameter(argv, argc, param);
-  if (ok != -1)
+  if (ok != -1) {
     result = ok;
+    integrVarying = true;
+  }
 
   return result;
 }
@@ -3990,11 +3994,8 @@ ForceBeamColumn3d::commitSensitivity(int gradNumber, int numGrads)
   double L = crdTransf->getInitialLength();
   double oneOverL = 1.0/L;
   
-  double pts[maxNumSections];
-  beamIntegr->getSectionLocations(numSections, L, pts);
-  
-  double wts[maxNumSections];
-  beamIntegr->getSectionWeights(numSections, L, wts);
+  this->formIntegration(L);
+  const double *pts = integrXi;
 
   double dLdh = crdTransf->getdLdh();
 
@@ -4101,11 +4102,10 @@ ForceBeamColumn3d::computedqdh(int gradNumber)
   double L = crdTransf->getInitialLength();
   double oneOverL = 1.0/L;
   
-  double pts[maxNumSections];
-  beamIntegr->getSectionLocations(numSections, L, pts);
+  this->formIntegration(L);
+  const double *pts = integrXi;
   
-  double wts[maxNumSections];
-  beamIntegr->getSectionWeights(numSections, L, wts);
+  const double *wts = integrWt;
 
   double dLdh = crdTransf->getdLdh();
 
@@ -4274,11 +4274,10 @@ ForceBeamColumn3d::computedfedh(int gradNumber)
   double dLdh = crdTransf->getdLdh();
   double d1oLdh = crdTransf->getd1overLdh();
 
-  double xi[maxNumSections];
-  beamIntegr->getSectionLocations(numSections, L, xi);
+  this->formIntegration(L);
+  const double *xi = integrXi;
   
-  double wt[maxNumSections];
-  beamIntegr->getSectionWeights(numSections, L, wt);
+  const double *wt = integrWt;
 
   double dptsdh[maxNumSections];
   beamIntegr->getLocationsDeriv(numSections, L, dLdh, dptsdh);
@@ -4450,3 +4449,14 @@ ForceBeamColumn3d::setSectionPointers(int numSec, SectionForceDeformation **secP
   }
   
 }
+
+void
+ForceBeamColumn3d::formIntegration(double L)
+{
+  if (L == integrL && integrVarying == false)
+    return;
+
+  beamIntegr->getSectionLocations(numSections, L, integrXi);
+  beamIntegr->getSectionWeights(numSections, L, integrWt);
+  integrL = L;
+}
@@ -223,6 +223,14 @@ class ForceBeamColumn3d: public Element
   void computeReactionSensitivity(double *dp0dh, int gradNumber);
   void computeSectionForceSensitivity(Vector &dspdh, int isec, int gradNumber);
   // AddingSensitivity:END ///////////////////////////////////////////
+
+  // section locations & weights, kept for the length they were formed
+  // at; formed every time once an integration parameter is set
+  void formIntegration(double L);
+  double integrXi[maxNumSections];
+  double integrWt[maxNumSections];
+  double integrL;
+  bool integrVarying;
 };
 
 #endif
@@ -128,7 +128,7 @@ void getCBDIinfluenceMatrix(int nIntegrPts, const Matrix &xi_pt, double L, Matri
    ls.addMatrixProduct(0.0, l, Ginv, L*L);
 }
 
-void getCBDIinfluenceMatrix(int nIntegrPts, double *pts, double L, Matrix &ls)
+void getCBDIinfluenceMatrix(int nIntegrPts, const double *pts, double L, Matrix &ls)
 {
    // setup Vandermode and CBDI influence matrices
    int i, j, i0, j0;
@@ -159,7 +159,7 @@ void getCBDIinfluenceMatrix(int nIntegrPts, double *pts, double L, Matrix &ls)
    ls.addMatrixProduct(0.0, l, Ginv, L*L);
 }
 
-void getCBDIinfluenceMatrix(int nPts, double *pts, int nIntegrPts, double *integrPts, double L, Matrix &ls)
+void getCBDIinfluenceMatrix(int nPts, const double *pts, int nIntegrPts, const double *integrPts, double L, Matrix &ls)
 {
    // setup Vandermode and CBDI influence matrices
    int i, j, i0, j0;
@@ -803,9 +803,57 @@ OpenSeesCommands::setVariableAnalysis(bool suppress)
 
 }
 
-void
-OpenSeesCommands::setTransientAnalysis(bool suppress)
-{
+int
+OpenSeesCommands::setTransientAnalysis(bool suppress, int type)
+{
+    // analysis Transient <-adaptive tol <-dtMin dtMin> <-dtMax dtMax> <-atol atol>>
+    // analysis Parareal -numWorkers n <-numWindows n> <-coarseSteps n> <-maxIter n> <-tol tol>
+    // analysis ModalSuperposition -numModes n <-damp zeta> <-links tags..> <-recordNodes tags..>
+    // the options are checked before the old analysis is deleted
+    const char *typeNames[3] = {"Transient", "Parareal", "ModalSuperposition"};
+    const char *options[11] = {"-adaptive", "-dtMin", "-dtMax", "-atol",
+			       "-numWorkers", "-numWindows", "-coarseSteps", "-maxIter", "-tol",
+			       "-numModes", "-damp"};
+    const int optionTypes[11] = {0, 0, 0, 0, 1, 1, 1, 1, 1, 2, 2};
+    double values[11] = {0.0, 0.0, 0.0, 0.0, 1.0, 0.0, 1.0, 10.0, 1.0e-6, 0.0, -1.0};
+    ID linkTags(0, 8), recordTags(0, 8);
+    int numdata = 1;
+    while (OPS_GetNumRemainingInputArgs() > 0) {
+	const char* opt = OPS_GetString();
+	if (type == 2 && (strcmp(opt, "-links") == 0 || strcmp(opt, "-recordNodes") == 0)) {
+	    ID &tags = (strcmp(opt, "-links") == 0) ? linkTags : recordTags;
+	    while (OPS_GetNumRemainingInputArgs() > 0) {
+		int tag;
+		if (OPS_GetIntInput(&numdata, &tag) < 0) {
+		    OPS_ResetCurrentInputArg(-1);
+		    break;
+		}
+		tags[tags.Size()] = tag;
+	    }
+	    continue;
+	}
+	int i = 0;
+	while (i < 11 && strcmp(opt, options[i]) != 0)
+	    i++;
+	if (i == 11 || optionTypes[i] != type) {
+	    opserr << "WARNING analysis " << typeNames[type] << " - unknown option " << opt << "\n";
+	    return -1;
+	}
+	if (OPS_GetNumRemainingInputArgs() < 1 || OPS_GetDoubleInput(&numdata, &values[i]) < 0) {
+	    opserr << "WARNING analysis " << typeNames[type] << " - invalid value for " << opt << "\n";
+	    return -1;
+	}
+    }
+    if (type == 0 && (values[0] < 0.0 || values[1] < 0.0 || values[3] < 0.0 ||
+		      (values[2] > 0.0 && values[2] < values[1]))) {
+	opserr << "WARNING analysis Transient - invalid -adaptive tol, -dtMin, -dtMax or -atol\n";
+	return -1;
+    }
+    if (type == 2 && values[9] < 1.0) {
+	opserr << "WARNING analysis ModalSuperposition -numModes n required\n";
+	return -1;
+    }
+
     // delete the old analysis
     if (theStaticAnalysis != 0) {
 	delete theStaticAnalysis;
@@ -862,14 +910,45 @@ OpenSeesCommands::setTransientAnalysis(bool suppress)
 	theSOE = new ProfileSPDLinSOE(*theSolver);
     }
 
-    theTransientAnalysis = new DirectIntegrationAnalysis(*theDomain,
-							 *theHandler,
-							 *theNumberer,
-							 *theAnalysisModel,
-							 *theAlgorithm,
-							 *theSOE,
-							 *theTransientIntegrator,
-							 theTest);
+    DirectIntegrationAnalysis *theDirectAnalysis = 0;
+    if (type == 2) {
+	theDirectAnalysis = new ModalSuperpositionAnalysis(*theDomain,
+							   *theHandler,
+							   *theNumberer,
+							   *theAnalysisModel,
+							   *theAlgorithm,
+							   *theSOE,
+							   *theTransientIntegrator,
+							   theTest,
+							   (int)values[9],
+							   values[10],
+							   &linkTags,
+							   &recordTags);
+    }
+    else if (type == 1)
+	theDirectAnalysis = new PararealAnalysis(*theDomain,
+						 *theHandler,
+						 *theNumberer,
+						 *theAnalysisModel,
+						 *theAlgorithm,
+						 *theSOE,
+						 *theTransientIntegrator,
+						 theTest,
+						 (int)values[4],
+						 (int)values[5],
+						 (int)values[6],
+						 (int)values[7],
+						 values[8]);
+    else
+	theDirectAnalysis = new DirectIntegrationAnalysis(*theDomain,
+							  *theHandler,
+							  *theNumberer,
+							  *theAnalysisModel,
+							  *theAlgorithm,
+							  *theSOE,
+							  *theTransientIntegrator,
+							  theTest);
+    theTransientAnalysis = theDirectAnalysis;
     if (theEigenSOE != 0) {
 	theTransientAnalysis->setEigenSOE(*theEigenSOE);
     }
@@ -878,6 +957,11 @@ OpenSeesCommands::setTransientAnalysis(bool suppress)
 	  ((MPIDiagonalSOE*) theSOE)->setAnalysisModel(*theAnalysisModel);
 	}
 #endif
+
+    if (values[0] > 0.0)
+	theDirectAnalysis->setAdaptive(values[0], values[1], values[2], values[3]);
+
+    return 0;
 }
 
 void
@@ -1896,7 +1980,21 @@ int OPS_Analysis() {
     }
   } else if (strcmp(type, "Transient") == 0) {
     if (cmds != 0) {
-      cmds->setTransientAnalysis(suppressWarnings);
+      if (cmds->setTransientAnalysis(suppressWarnings) < 0) {
+        return -1;
+      }
+    }
+  } else if (strcmp(type, "Parareal") == 0) {
+    if (cmds != 0) {
+      if (cmds->setTransientAnalysis(suppressWarnings, 1) < 0) {
+        return -1;
+      }
+    }
+  } else if (strcmp(type, "ModalSuperposition") == 0) {
+    if (cmds != 0) {
+      if (cmds->setTransientAnalysis(suppressWarnings, 2) < 0) {
+        return -1;
+      }
     }
   } else if (strcmp(type, "PFEM") == 0) {
     if (cmds != 0) {
@@ -2490,6 +2588,7 @@ void* OPS_KrylovNewton()
     int incrementTangent = CURRENT_TANGENT;
     int iterateTangent = CURRENT_TANGENT;
     int maxDim = 3;
+    int maxKeep = 0;
     while (OPS_GetNumRemainingInputArgs() > 0) {
 	const char* flag = OPS_GetString();
 
@@ -2525,6 +2624,13 @@ void* OPS_KrylovNewton()
 		opserr<< "WARNING KrylovNewton failed to read maxDim\n";
 		return 0;
 	    }
+	} else if (strcmp(flag,"-reuse") == 0 && OPS_GetNumRemainingInputArgs()>0) {
+
+	    int numdata = 1;
+	    if (OPS_GetIntInput(&numdata, &maxKeep) < 0) {
+		opserr<< "WARNING KrylovNewton failed to read reuse\n";
+		return 0;
+	    }
 	}
     }
 
@@ -2535,7 +2641,7 @@ void* OPS_KrylovNewton()
     }
 
     Accelerator *theAccel;
-    theAccel = new KrylovAccelerator(maxDim, iterateTangent);
+    theAccel = new KrylovAccelerator(maxDim, iterateTangent, maxKeep);
 
     return new AcceleratedNewton(*theTest, theAccel, incrementTangent);
 }
@@ -3468,7 +3574,13 @@ int OPS_numFact()
 	return -1;
     }
 
+    // numFact <-avoided>
     double value = theAlgorithm->getNumFactorizations();
+    if (OPS_GetNumRemainingInputArgs() > 0) {
+	const char* flag = OPS_GetString();
+	if (strcmp(flag, "-avoided") == 0)
+	    value = theAlgorithm->getNumFactorizationsAvoided();
+    }
     int numdata = 1;
     if (OPS_SetDoubleOutput(&numdata, &value, true) < 0) {
 	opserr << "WARNING failed to set output\n";
@@ -3755,7 +3867,24 @@ int OPS_sensitivityAlgorithm()
     	return -1;
     }
 
+    // number of parameters whose sensitivities are solved together
+    int blockSize = 1;
+    while (OPS_GetNumRemainingInputArgs() > 0) {
+    	const char* opt = OPS_GetString();
+    	if (strcmp(opt,"-block") == 0 && OPS_GetNumRemainingInputArgs() > 0) {
+    	    int numData = 1;
+    	    if (OPS_GetIntInput(&numData, &blockSize) < 0 || blockSize < 1) {
+    		opserr << "ERROR: invalid input: sensitivity block size\n";
+    		return -1;
+    	    }
+    	} else {
+    	    opserr << "Unknown sensitivity algorithm option: " << opt << "\n";
+    	    return -1;
+    	}
+    }
+
     theIntegrator->setComputeType(analysisTypeTag);
+    theIntegrator->setSensitivityBlockSize(blockSize);
     theIntegrator->activateSensitivityKey();
 	
     return 0;
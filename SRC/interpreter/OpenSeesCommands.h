@@ -59,6 +59,8 @@ UPDATES, ENHANCEMENTS, OR MODIFICATIONS.
 #include <FEM_ObjectBrokerAllClasses.h>
 #include <PFEMAnalysis.h>
 #include <VariableTimeStepDirectIntegrationAnalysis.h>
+#include <PararealAnalysis.h>
+#include <ModalSuperpositionAnalysis.h>
 #include <Timer.h>
 #include <SimulationInformation.h>
 #include <elementAPI.h>
@@ -133,7 +135,7 @@ public:
         return &theVariableTimeStepTransientAnalysis;
     }
 
-    void setTransientAnalysis(bool suppress);
+    int setTransientAnalysis(bool suppress, int type = 0);   // 1: Parareal, 2: ModalSuperposition
     DirectIntegrationAnalysis* getTransientAnalysis() {return theTransientAnalysis;}
     DirectIntegrationAnalysis** getTransientAnalysisPointer() {
         return &theTransientAnalysis;
@@ -271,6 +273,7 @@ int OPS_nodeDisp();
 int OPS_nodeReaction();
 int OPS_nodeEigenvector();
 int OPS_getTime();
+int OPS_criticalTimeStep();
 int OPS_eleResponse();
 int OPS_getLoadFactor();
 int OPS_printModelGID();
@@ -331,6 +334,7 @@ int OPS_sensLambda();
 int OPS_sensSectionForce();
 int OPS_sensNodePressure();
 int OPS_getNumElements();
+int OPS_getNumAllocations();
 int OPS_getEleClassTags();
 int OPS_getEleLoadClassTags();
 int OPS_getEleLoadTags();
@@ -365,6 +369,7 @@ int OPS_RigidDiaphragm();
 int OPS_addElementRayleigh();
 int OPS_mesh();
 int OPS_remesh();
+int OPS_meshImport();
 int OPS_getPID();
 int OPS_getNP();
 int OPS_barrier();
@@ -56,6 +56,7 @@
 #include <TetMesh.h>
 #include <BackgroundMesh.h>
 #include <Damping.h>
+#include <MeshImport.h>
 
 #ifdef _PARALLEL_INTERPRETERS
 #include <mpi.h>
@@ -1513,6 +1514,30 @@ int OPS_remesh()
     return 0;
 }
 
+int OPS_meshImport()
+{
+    if (OPS_GetNumRemainingInputArgs() < 1) {
+	opserr << "WARNING insufficient arguments\n";
+	opserr << "Want: meshImport fileName?\n";
+	return -1;
+    }
+
+    Domain* theDomain = OPS_GetDomain();
+    if (theDomain == 0) {
+	opserr << "WARNING: domain is not defined\n";
+	return -1;
+    }
+
+    const char* fileName = OPS_GetString();
+    MeshImport theImport(*theDomain, fileName, OPS_GetNDM());
+    if (theImport.buildFE_Model() < 0) {
+	opserr << "WARNING: failed to import mesh " << fileName << "\n";
+	return -1;
+    }
+
+    return 0;
+}
+
 int OPS_getPID()
 {
     int pid = 0;
@@ -67,6 +67,7 @@ UPDATES, ENHANCEMENTS, OR MODIFICATIONS.
 #include <vector>
 #include <Parameter.h>
 #include <ParameterIter.h>
+#include <ExplicitDifference.h>
 #include <DummyStream.h>
 #include <Response.h>
 #include <Mesh.h>
@@ -81,6 +82,7 @@ void* OPS_EnvelopeElementRecorder();
 void* OPS_PVDRecorder();
 void* OPS_AlgorithmRecorder();
 void* OPS_RemoveRecorder();
+void* OPS_PeriodRecorder();
 #ifdef _HDF5
 void* OPS_MPCORecorder();
 #endif
@@ -115,6 +117,7 @@ namespace {
 	recordersMap.insert(std::make_pair("Collapse", &OPS_RemoveRecorder));
 	recordersMap.insert(std::make_pair("Drift", &OPS_DriftRecorder));
 	recordersMap.insert(std::make_pair("EnvelopeDrift", &OPS_EnvelopeDriftRecorder));
+	recordersMap.insert(std::make_pair("Period", &OPS_PeriodRecorder));
 #ifdef _HDF5
 	recordersMap.insert(std::make_pair("mpco", &OPS_MPCORecorder));
 #endif
@@ -388,6 +391,39 @@ int OPS_getTime()
     return 0;
 }
 
+int OPS_criticalTimeStep()
+{
+    Domain* theDomain = OPS_GetDomain();
+    if (theDomain == 0) return -1;
+
+    // criticalTimeStep <eleTag1 eleTag2 ...>
+    int numEle = OPS_GetNumRemainingInputArgs();
+    if (numEle == 0) {
+	double dt = ExplicitDifference::getCriticalTimeStep(theDomain);
+	int numdata = 1;
+	if (OPS_SetDoubleOutput(&numdata, &dt, true) < 0) {
+	    opserr << "WARNING failed to set critical time step\n";
+	    return -1;
+	}
+	return 0;
+    }
+
+    ID eleTags(numEle);
+    if (OPS_GetIntInput(&numEle, &eleTags(0)) < 0) {
+	opserr << "WARNING criticalTimeStep <eleTag1 eleTag2 ...> - invalid eleTag\n";
+	return -1;
+    }
+
+    Vector eleDt(numEle);
+    ExplicitDifference::getCriticalTimeStep(theDomain, &eleTags, &eleDt);
+    if (OPS_SetDoubleOutput(&numEle, &eleDt(0), false) < 0) {
+	opserr << "WARNING failed to set critical time step\n";
+	return -1;
+    }
+
+    return 0;
+}
+
 int OPS_eleResponse()
 {
     Domain* theDomain = OPS_GetDomain();
@@ -4199,4 +4235,21 @@ int OPS_getNumElements()
     return 0;
 }
 
+// the numbers of Vector and Matrix data arrays allocated so far; these
+// are only counted in a build with -D_ALLOC_COUNT, otherwise 0
+int OPS_getNumAllocations()
+{
+    int data[2];
+    data[0] = (int)Vector::getNumAllocations();
+    data[1] = (int)Matrix::getNumAllocations();
+    int size = 2;
+
+    if (OPS_SetIntOutput(&size, data, false) < 0) {
+	opserr << "WARNING failed to set output\n";
+	return -1;
+    }
+
+    return 0;
+}
+
 // Sensitivity:END /////////////////////////////////////////////
@@ -2202,6 +2202,8 @@ int OPS_gradientEvaluator() {
     const char *type = OPS_GetString();
     if (strcmp(type, "FiniteDifference") == 0) {
         double perturbationFactor = 1000.0;
+        int numWorkers = 1;
+        bool useCache = false;
         // bool doGradientCheck = false;
         while (OPS_GetNumRemainingInputArgs() > 0) {
             const char *arg = OPS_GetString();
@@ -2215,6 +2217,18 @@ int OPS_gradientEvaluator() {
                     return -1;
                 }
             }
+            if (strcmp(arg, "-numWorkers") == 0 &&
+                OPS_GetNumRemainingInputArgs() > 0) {
+                if (OPS_GetIntInput(&numdata, &numWorkers) < 0 ||
+                    numWorkers < 1) {
+                    opserr << "ERROR: unable to read -numWorkers value for "
+                           << type << " gradient evaluator" << endln;
+                    return -1;
+                }
+            }
+            if (strcmp(arg, "-cache") == 0) {
+                useCache = true;
+            }
             if (strcmp(arg, "-check") == 0) {
                 // doGradientCheck = true;
             }
@@ -2231,7 +2245,8 @@ int OPS_gradientEvaluator() {
         }
 
         theEval = new FiniteDifferenceGradient(theEvaluator, theRelDomain,
-                                               theStrDomain);
+                                               theStrDomain, numWorkers,
+                                               useCache);
     } else if (strcmp(type, "OpenSees") == 0 ||
                strcmp(type, "Implicit") == 0) {
         // bool doGradientCheck = false;
@@ -2732,6 +2747,8 @@ int OPS_runImportanceSamplingAnalysis() {
     //     default -print 1   (print to screen) -print 2   (print
     //     to restart file)
     //
+    //     -numWorkers 1  ....................... this is the default
+    //
 
     // Declaration of input parameters
     long int numberOfSimulations = 1000;
@@ -2739,6 +2756,7 @@ int OPS_runImportanceSamplingAnalysis() {
     double samplingVariance = 1.0;
     int printFlag = 0;
     int analysisTypeTag = 1;
+    int numWorkers = 1;
 
     while (OPS_GetNumRemainingInputArgs() > 1) {
         const char *type = OPS_GetString();
@@ -2805,6 +2823,14 @@ int OPS_runImportanceSamplingAnalysis() {
                 return -1;
             }
 
+        } else if (strcmp(type, "-numWorkers") == 0) {
+            int numdata = 1;
+            if (OPS_GetIntInput(&numdata, &numWorkers) < 0 ||
+                numWorkers < 1) {
+                opserr << "ERROR: invalid input: numWorkers \n";
+                return -1;
+            }
+
         } else {
             opserr << "ERROR: invalid input to sampling analysis. \n";
             return -1;
@@ -2825,7 +2851,8 @@ int OPS_runImportanceSamplingAnalysis() {
             theReliabilityDomain, theStructuralDomain,
             theProbabilityTransformation, theFunctionEvaluator,
             theRandomNumberGenerator, 0, numberOfSimulations, targetCOV,
-            samplingVariance, printFlag, filename, analysisTypeTag);
+            samplingVariance, printFlag, filename, analysisTypeTag,
+            numWorkers);
 
     if (theImportanceSamplingAnalysis == 0) {
         opserr << "ERROR: could not create "
@@ -66,7 +66,10 @@ template<class T>void PythonStream::err_out(T err)
   std::stringstream ss;
   ss << err;
   msg = ss.str();
+  // the array commands of the module write with the GIL released
+  PyGILState_STATE gil = PyGILState_Ensure();
   PySys_FormatStderr(msg.c_str());
+  PyGILState_Release(gil);
 }
 
 
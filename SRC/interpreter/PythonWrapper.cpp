@@ -42,6 +42,9 @@ UPDATES, ENHANCEMENTS, OR MODIFICATIONS.
 #include "PythonWrapper.h"
 #include "OpenSeesCommands.h"
 #include <OPS_Globals.h>
+#include <MeshImport.h>
+#include <stdint.h>
+#include <string.h>
 
 
 
@@ -834,6 +837,18 @@ static PyObject *Py_ops_getTime(PyObject *self, PyObject *args)
     return wrapper->getResults();
 }
 
+static PyObject *Py_ops_criticalTimeStep(PyObject *self, PyObject *args)
+{
+    wrapper->resetCommandLine(PyTuple_Size(args), 1, args);
+
+    if (OPS_criticalTimeStep() < 0) {
+	opserr<<(void*)0;
+	return NULL;
+    }
+
+    return wrapper->getResults();
+}
+
 static PyObject *Py_ops_setCreep(PyObject *self, PyObject *args)
 {
     wrapper->resetCommandLine(PyTuple_Size(args), 1, args);
@@ -2059,6 +2074,351 @@ static PyObject *Py_ops_remesh(PyObject *self, PyObject *args)
     return wrapper->getResults();
 }
 
+static PyObject *Py_ops_meshImport(PyObject *self, PyObject *args)
+{
+    wrapper->resetCommandLine(PyTuple_Size(args), 1, args);
+
+    if (OPS_meshImport() < 0) {
+	opserr<<(void*)0;
+	return NULL;
+    }
+
+    return wrapper->getResults();
+}
+
+//
+// array commands: nodes, elements, fixes & masses create all the objects
+// of one kind from arrays (numpy arrays or anything with the buffer
+// protocol, or nested sequences) in one call, through a MeshImport. The
+// GIL is released while the objects are created; no other OpenSees
+// command may be issued from another thread until the call returns.
+//
+
+// append the numbers of an array or a (nested) sequence to data
+template <class T>
+static int Py_appendArray(PyObject *o, std::vector<T> &data)
+{
+    if (PyObject_CheckBuffer(o)) {
+	Py_buffer view;
+	if (PyObject_GetBuffer(o, &view, PyBUF_C_CONTIGUOUS | PyBUF_FORMAT) < 0) {
+	    PyErr_Clear();
+	    opserr << "WARNING: the arrays must be contiguous\n";
+	    return -1;
+	}
+
+	// the type of the items, by their kind and size
+	const int one = 1;
+	const char nativeOrder = (*(const char *)&one == 1) ? '<' : '>';
+	const char *fmt = (view.format != 0) ? view.format : "B";
+	if (*fmt == '@' || *fmt == '=' || *fmt == nativeOrder)
+	    fmt++;
+	char kind = 0;
+	if (fmt[0] != '\0' && fmt[1] == '\0') {
+	    if (strchr("bhilqn", fmt[0]) != 0)
+		kind = 'i';
+	    else if (strchr("BHILQN?", fmt[0]) != 0)
+		kind = 'u';
+	    else if (fmt[0] == 'f' || fmt[0] == 'd')
+		kind = 'f';
+	}
+
+	Py_ssize_t n = (view.itemsize > 0) ? view.len/view.itemsize : 0;
+	size_t start = data.size();
+	data.resize(start+n);
+	T *out = data.data()+start;
+	const char *in = (const char *)view.buf;
+
+	int res = 0;
+	if (kind == 'i' && view.itemsize == 1)
+	    for (Py_ssize_t i = 0; i < n; i++) out[i] = (T)((const int8_t *)in)[i];
+	else if (kind == 'i' && view.itemsize == 2)
+	    for (Py_ssize_t i = 0; i < n; i++) out[i] = (T)((const int16_t *)in)[i];
+	else if (kind == 'i' && view.itemsize == 4)
+	    for (Py_ssize_t i = 0; i < n; i++) out[i] = (T)((const int32_t *)in)[i];
+	else if (kind == 'i' && view.itemsize == 8)
+	    for (Py_ssize_t i = 0; i < n; i++) out[i] = (T)((const int64_t *)in)[i];
+	else if (kind == 'u' && view.itemsize == 1)
+	    for (Py_ssize_t i = 0; i < n; i++) out[i] = (T)((const uint8_t *)in)[i];
+	else if (kind == 'u' && view.itemsize == 2)
+	    for (Py_ssize_t i = 0; i < n; i++) out[i] = (T)((const uint16_t *)in)[i];
+	else if (kind == 'u' && view.itemsize == 4)
+	    for (Py_ssize_t i = 0; i < n; i++) out[i] = (T)((const uint32_t *)in)[i];
+	else if (kind == 'u' && view.itemsize == 8)
+	    for (Py_ssize_t i = 0; i < n; i++) out[i] = (T)((const uint64_t *)in)[i];
+	else if (kind == 'f' && view.itemsize == 4)
+	    for (Py_ssize_t i = 0; i < n; i++) out[i] = (T)((const float *)in)[i];
+	else if (kind == 'f' && view.itemsize == 8)
+	    for (Py_ssize_t i = 0; i < n; i++) out[i] = (T)((const double *)in)[i];
+	else {
+	    opserr << "WARNING: arrays of type " << view.format << " are not supported\n";
+	    res = -1;
+	}
+
+	PyBuffer_Release(&view);
+	return res;
+    }
+
+    if (PyUnicode_Check(o) || !PySequence_Check(o)) {
+	opserr << "WARNING: expected an array or a sequence of numbers\n";
+	return -1;
+    }
+
+    PyObject *seq = PySequence_Fast(o, "");
+    if (seq == 0) {
+	PyErr_Clear();
+	opserr << "WARNING: expected an array or a sequence of numbers\n";
+	return -1;
+    }
+
+    int res = 0;
+    Py_ssize_t n = PySequence_Fast_GET_SIZE(seq);
+    PyObject **items = PySequence_Fast_ITEMS(seq);
+    for (Py_ssize_t i = 0; i < n && res == 0; i++) {
+	PyObject *item = items[i];
+	if (PyLong_Check(item)) {
+	    data.push_back((T)PyLong_AsLong(item));
+	} else if (PyFloat_Check(item)) {
+	    data.push_back((T)PyFloat_AsDouble(item));
+	} else if (PyObject_CheckBuffer(item) || PySequence_Check(item)) {
+	    res = Py_appendArray(item, data);
+	} else if (PyNumber_Check(item)) {
+	    data.push_back((T)PyFloat_AsDouble(item));
+	} else {
+	    opserr << "WARNING: expected an array or a sequence of numbers\n";
+	    res = -1;
+	}
+	if (res == 0 && PyErr_Occurred()) {
+	    PyErr_Clear();
+	    opserr << "WARNING: invalid number in the arrays\n";
+	    res = -1;
+	}
+    }
+
+    Py_DECREF(seq);
+    return res;
+}
+
+template <class T>
+static int Py_getArray(PyObject *o, std::vector<T> &data)
+{
+    data.clear();
+    if (o == 0 || o == Py_None)
+	return 0;
+    return Py_appendArray(o, data);
+}
+
+// the number of values per object of an array holding count objects
+static int Py_arrayWidth(const char *name, size_t size, int count)
+{
+    if (count == 0)
+	return 0;
+    if (size % count != 0) {
+	opserr << "WARNING: the size of " << name << ", " << (int)size;
+	opserr << ", is not a multiple of the number of tags " << count << "\n";
+	return -1;
+    }
+    return (int)(size/count);
+}
+
+static PyObject *Py_ops_nodes(PyObject *self, PyObject *args)
+{
+    wrapper->resetCommandLine(PyTuple_Size(args), 1, args);
+
+    // nodes(tags, crds <, ndf>)
+    PyObject *tagsObj = 0, *crdsObj = 0;
+    int ndf = OPS_GetNDF();
+    if (!PyArg_ParseTuple(args, "OO|i", &tagsObj, &crdsObj, &ndf))
+	return NULL;
+
+    Domain *theDomain = OPS_GetDomain();
+    if (theDomain == 0) {
+	opserr << "WARNING: domain is not defined\n";
+	opserr << (void*)0;
+	return NULL;
+    }
+
+    std::vector<int> tags;
+    std::vector<double> crds;
+    if (Py_getArray(tagsObj, tags) < 0 || Py_getArray(crdsObj, crds) < 0) {
+	opserr << (void*)0;
+	return NULL;
+    }
+
+    int ndm = OPS_GetNDM();
+    if (ndm < 1 || ndf < 1) {
+	opserr << "WARNING: nodes - invalid ndm " << ndm << " or ndf " << ndf;
+	opserr << ", a model must be defined first\n";
+	opserr << (void*)0;
+	return NULL;
+    }
+
+    int count = (int)tags.size();
+    if (crds.size() != (size_t)count*ndm) {
+	opserr << "WARNING: nodes - want " << count*ndm << " coordinates, ";
+	opserr << "got " << (int)crds.size() << "\n";
+	opserr << (void*)0;
+	return NULL;
+    }
+
+    MeshImport theBuilder(*theDomain, ndm);
+    int res = 0;
+    Py_BEGIN_ALLOW_THREADS
+    res = theBuilder.addNodes(count, ndf, tags.data(), crds.data());
+    Py_END_ALLOW_THREADS
+
+    if (res < 0) {
+	opserr << (void*)0;
+	return NULL;
+    }
+
+    return wrapper->getResults();
+}
+
+static PyObject *Py_ops_elements(PyObject *self, PyObject *args)
+{
+    wrapper->resetCommandLine(PyTuple_Size(args), 1, args);
+
+    // elements(type, tags, nodes <, iData <, dData>>)
+    const char *type = 0;
+    PyObject *tagsObj = 0, *nodesObj = 0, *iDataObj = 0, *dDataObj = 0;
+    if (!PyArg_ParseTuple(args, "sOO|OO", &type, &tagsObj, &nodesObj, &iDataObj, &dDataObj))
+	return NULL;
+
+    Domain *theDomain = OPS_GetDomain();
+    if (theDomain == 0) {
+	opserr << "WARNING: domain is not defined\n";
+	opserr << (void*)0;
+	return NULL;
+    }
+
+    std::vector<int> tags, nodes, iData;
+    std::vector<double> dData;
+    if (Py_getArray(tagsObj, tags) < 0 || Py_getArray(nodesObj, nodes) < 0 ||
+	Py_getArray(iDataObj, iData) < 0 || Py_getArray(dDataObj, dData) < 0) {
+	opserr << (void*)0;
+	return NULL;
+    }
+
+    int count = (int)tags.size();
+    if (count == 0)
+	return wrapper->getResults();
+
+    int numNodes = Py_arrayWidth("the connectivity", nodes.size(), count);
+    int numInt = Py_arrayWidth("the int data", iData.size(), count);
+    int numDouble = Py_arrayWidth("the double data", dData.size(), count);
+    if (numNodes < 0 || numInt < 0 || numDouble < 0) {
+	opserr << (void*)0;
+	return NULL;
+    }
+
+    MeshImport theBuilder(*theDomain, OPS_GetNDM());
+    int res = 0;
+    Py_BEGIN_ALLOW_THREADS
+    res = theBuilder.addElements(type, count, numNodes, numInt, numDouble,
+				 tags.data(), nodes.data(), iData.data(), dData.data());
+    Py_END_ALLOW_THREADS
+
+    if (res < 0) {
+	opserr << (void*)0;
+	return NULL;
+    }
+
+    return wrapper->getResults();
+}
+
+static PyObject *Py_ops_fixes(PyObject *self, PyObject *args)
+{
+    wrapper->resetCommandLine(PyTuple_Size(args), 1, args);
+
+    // fixes(tags, flags)
+    PyObject *tagsObj = 0, *fixObj = 0;
+    if (!PyArg_ParseTuple(args, "OO", &tagsObj, &fixObj))
+	return NULL;
+
+    Domain *theDomain = OPS_GetDomain();
+    if (theDomain == 0) {
+	opserr << "WARNING: domain is not defined\n";
+	opserr << (void*)0;
+	return NULL;
+    }
+
+    std::vector<int> tags, fix;
+    if (Py_getArray(tagsObj, tags) < 0 || Py_getArray(fixObj, fix) < 0) {
+	opserr << (void*)0;
+	return NULL;
+    }
+
+    int count = (int)tags.size();
+    if (count == 0)
+	return wrapper->getResults();
+
+    int ndf = Py_arrayWidth("the flags", fix.size(), count);
+    if (ndf < 0) {
+	opserr << (void*)0;
+	return NULL;
+    }
+
+    MeshImport theBuilder(*theDomain, OPS_GetNDM());
+    int res = 0;
+    Py_BEGIN_ALLOW_THREADS
+    res = theBuilder.addFixes(count, ndf, tags.data(), fix.data());
+    Py_END_ALLOW_THREADS
+
+    if (res < 0) {
+	opserr << (void*)0;
+	return NULL;
+    }
+
+    return wrapper->getResults();
+}
+
+static PyObject *Py_ops_masses(PyObject *self, PyObject *args)
+{
+    wrapper->resetCommandLine(PyTuple_Size(args), 1, args);
+
+    // masses(tags, masses)
+    PyObject *tagsObj = 0, *massObj = 0;
+    if (!PyArg_ParseTuple(args, "OO", &tagsObj, &massObj))
+	return NULL;
+
+    Domain *theDomain = OPS_GetDomain();
+    if (theDomain == 0) {
+	opserr << "WARNING: domain is not defined\n";
+	opserr << (void*)0;
+	return NULL;
+    }
+
+    std::vector<int> tags;
+    std::vector<double> mass;
+    if (Py_getArray(tagsObj, tags) < 0 || Py_getArray(massObj, mass) < 0) {
+	opserr << (void*)0;
+	return NULL;
+    }
+
+    int count = (int)tags.size();
+    if (count == 0)
+	return wrapper->getResults();
+
+    int ndf = Py_arrayWidth("the masses", mass.size(), count);
+    if (ndf < 0) {
+	opserr << (void*)0;
+	return NULL;
+    }
+
+    MeshImport theBuilder(*theDomain, OPS_GetNDM());
+    int res = 0;
+    Py_BEGIN_ALLOW_THREADS
+    res = theBuilder.addMasses(count, ndf, tags.data(), mass.data());
+    Py_END_ALLOW_THREADS
+
+    if (res < 0) {
+	opserr << (void*)0;
+	return NULL;
+    }
+
+    return wrapper->getResults();
+}
+
 static PyObject *Py_ops_parameter(PyObject *self, PyObject *args)
 {
     wrapper->resetCommandLine(PyTuple_Size(args), 1, args);
@@ -2299,6 +2659,18 @@ static PyObject *Py_ops_getNumElements(PyObject *self, PyObject *args)
     return wrapper->getResults();
 }
 
+static PyObject *Py_ops_getNumAllocations(PyObject *self, PyObject *args)
+{
+    wrapper->resetCommandLine(PyTuple_Size(args), 1, args);
+
+    if (OPS_getNumAllocations() < 0) {
+	opserr<<(void*)0;
+	return NULL;
+    }
+
+    return wrapper->getResults();
+}
+
 static PyObject *Py_ops_getEleClassTags(PyObject *self, PyObject *args)
 {
     wrapper->resetCommandLine(PyTuple_Size(args), 1, args);
@@ -3171,6 +3543,7 @@ PythonWrapper::addOpenSeesCommands()
     addCommand("equalDOF", &Py_ops_equalDOF);
     addCommand("nodeEigenvector", &Py_ops_nodeEigenvector);
     addCommand("getTime", &Py_ops_getTime);
+    addCommand("criticalTimeStep", &Py_ops_criticalTimeStep);
     addCommand("setCreep", &Py_ops_setCreep);
     addCommand("eleResponse", &Py_ops_eleResponse);
     addCommand("sp", &Py_ops_SP);
@@ -3275,6 +3648,11 @@ PythonWrapper::addOpenSeesCommands()
     addCommand("setElementRayleighFactors", &Py_ops_setElementRayleighFactors);
     addCommand("mesh", &Py_ops_mesh);
     addCommand("remesh", &Py_ops_remesh);
+    addCommand("meshImport", &Py_ops_meshImport);
+    addCommand("nodes", &Py_ops_nodes);
+    addCommand("elements", &Py_ops_elements);
+    addCommand("fixes", &Py_ops_fixes);
+    addCommand("masses", &Py_ops_masses);
     addCommand("parameter", &Py_ops_parameter);
     addCommand("addToParameter", &Py_ops_addToParameter);
     addCommand("updateParameter", &Py_ops_updateParameter);
@@ -3295,6 +3673,7 @@ PythonWrapper::addOpenSeesCommands()
     addCommand("sensSectionForce", &Py_ops_sensSectionForce);
     addCommand("sensNodePressure", &Py_ops_sensNodePressure);
     addCommand("getNumElements", &Py_ops_getNumElements);
+    addCommand("getNumAllocations", &Py_ops_getNumAllocations);
     addCommand("getEleClassTags", &Py_ops_getEleClassTags);
     addCommand("getEleLoadClassTags", &Py_ops_getEleLoadClassTags);
     addCommand("getEleLoadTags", &Py_ops_getEleLoadTags);
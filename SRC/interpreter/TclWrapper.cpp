@@ -469,6 +469,14 @@ static int Tcl_ops_getTime(ClientData clientData, Tcl_Interp *interp, int argc,
     return TCL_OK;
 }
 
+static int Tcl_ops_criticalTimeStep(ClientData clientData, Tcl_Interp *interp, int argc,   TCL_Char **argv) {
+    wrapper->resetCommandLine(argc, 1, argv);
+
+    if (OPS_criticalTimeStep() < 0) return TCL_ERROR;
+
+    return TCL_OK;
+}
+
 static int Tcl_ops_setCreep(ClientData clientData, Tcl_Interp *interp, int argc,   TCL_Char **argv) {
     wrapper->resetCommandLine(argc, 1, argv);
 
@@ -1157,6 +1165,14 @@ static int Tcl_ops_remesh(ClientData clientData, Tcl_Interp *interp, int argc,
     return TCL_OK;
 }
 
+static int Tcl_ops_meshImport(ClientData clientData, Tcl_Interp *interp, int argc,   TCL_Char **argv) {
+    wrapper->resetCommandLine(argc, 1, argv);
+
+    if (OPS_meshImport() < 0) return TCL_ERROR;
+
+    return TCL_OK;
+}
+
 static int Tcl_ops_parameter(ClientData clientData, Tcl_Interp *interp, int argc,   TCL_Char **argv) {
     wrapper->resetCommandLine(argc, 1, argv);
 
@@ -1333,6 +1349,15 @@ static int Tcl_ops_getNumElements(ClientData clientData, Tcl_Interp *interp, int
     return TCL_OK;
 }
 
+static int Tcl_ops_getNumAllocations(ClientData clientData, Tcl_Interp *interp, int argc,   TCL_Char **argv)
+{
+    wrapper->resetCommandLine(argc, 1, argv);
+
+    if (OPS_getNumAllocations() < 0) return TCL_ERROR;
+
+    return TCL_OK;
+}
+
 static int Tcl_ops_getEleClassTags(ClientData clientData, Tcl_Interp *interp, int argc,   TCL_Char **argv)
 {
     wrapper->resetCommandLine(argc, 1, argv);
@@ -1718,6 +1743,7 @@ TclWrapper::addOpenSeesCommands(Tcl_Interp* interp)
     addCommand(interp,"equalDOF", &Tcl_ops_equalDOF);
     addCommand(interp,"nodeEigenvector", &Tcl_ops_nodeEigenvector);
     addCommand(interp,"getTime", &Tcl_ops_getTime);
+    addCommand(interp,"criticalTimeStep", &Tcl_ops_criticalTimeStep);
     addCommand(interp,"setCreep", &Tcl_ops_setCreep);
     addCommand(interp,"eleResponse", &Tcl_ops_eleResponse);
     addCommand(interp,"sp", &Tcl_ops_SP);
@@ -1805,6 +1831,7 @@ TclWrapper::addOpenSeesCommands(Tcl_Interp* interp)
     addCommand(interp,"setElementRayleighFactors", &Tcl_ops_setElementRayleighFactors);
     addCommand(interp,"mesh", &Tcl_ops_mesh);
     addCommand(interp,"remesh", &Tcl_ops_remesh);
+    addCommand(interp,"meshImport", &Tcl_ops_meshImport);
     addCommand(interp,"parameter", &Tcl_ops_parameter);
     addCommand(interp,"addToParameter", &Tcl_ops_addToParameter);
     addCommand(interp,"updateParameter", &Tcl_ops_updateParameter);
@@ -1825,6 +1852,7 @@ TclWrapper::addOpenSeesCommands(Tcl_Interp* interp)
     addCommand(interp,"sensSectionForce", &Tcl_ops_sensSectionForce);
     addCommand(interp,"sensNodePressure", &Tcl_ops_sensNodePressure);
     addCommand(interp,"getNumElements", &Tcl_ops_getNumElements);
+    addCommand(interp,"getNumAllocations", &Tcl_ops_getNumAllocations);
     addCommand(interp,"getEleClassTags", &Tcl_ops_getEleClassTags);
     addCommand(interp,"getEleLoadClassTags", &Tcl_ops_getEleLoadClassTags);
     addCommand(interp,"getEleLoadTags", &Tcl_ops_getEleLoadTags);
@@ -50,6 +50,10 @@ double Matrix::MATRIX_NOT_VALID_ENTRY =0.0;
 double *Matrix::matrixWork = 0;
 int    *Matrix::intWork =0;
 
+// number of data arrays allocated, counted if built with -D_ALLOC_COUNT
+// to check that the solution loops do not create temporaries
+static long numAllocations = 0;
+
 //double *Matrix::matrixWork = (double *)malloc(400*sizeof(double));
 
 //
@@ -101,6 +105,9 @@ Matrix::Matrix(int nRows,int nCols)
     data = 0;
 
     if (dataSize > 0) {
+#ifdef _ALLOC_COUNT
+      numAllocations++;
+#endif
       data = new (nothrow) double[dataSize];
       //data = (double *)malloc(dataSize*sizeof(double));
       if (data == 0) {
@@ -163,6 +170,9 @@ Matrix::Matrix(const Matrix &other)
     dataSize = other.dataSize;
 
     if (dataSize != 0) {
+#ifdef _ALLOC_COUNT
+      numAllocations++;
+#endif
       data = new (nothrow) double[dataSize];
       // data = (double *)malloc(dataSize*sizeof(double));
       if (data == 0) {
@@ -277,6 +287,9 @@ Matrix::resize(int rows, int cols) {
 
     fromFree = 0;
     // create new space
+#ifdef _ALLOC_COUNT
+    numAllocations++;
+#endif
     data = new (nothrow) double[newSize];
     // data = (double *)malloc(dataSize*sizeof(double));
     if (data == 0) {
@@ -1185,6 +1198,9 @@ Matrix::operator=(const Matrix &other)
       
       int theSize = other.numCols*other.numRows;
       
+#ifdef _ALLOC_COUNT
+      numAllocations++;
+#endif
       data = new (nothrow) double[theSize];
       
       this->dataSize = theSize;
@@ -2008,3 +2024,9 @@ Vector Matrix::diagonal() const
 
   return diagonal;
 }
+
+long
+Matrix::getNumAllocations(void)
+{
+  return numAllocations;
+}
@@ -137,6 +137,9 @@ class Matrix
 
     int Eigen3(const Matrix &M);
 
+    // data arrays allocated, counted if built with -D_ALLOC_COUNT
+    static long getNumAllocations(void);
+
     friend OPS_Stream &operator<<(OPS_Stream &s, const Matrix &M);
     //    friend istream &operator>>(istream &s, Matrix &M);    
     friend Matrix operator*(double a, const Matrix &M);
@@ -0,0 +1,177 @@
+/* ****************************************************************** **
+**    OpenSees - Open System for Earthquake Engineering Simulation    **
+**          Pacific Earthquake Engineering Research Center            **
+**                                                                    **
+**                                                                    **
+** (C) Copyright 1999, The Regents of the University of California    **
+** All Rights Reserved.                                               **
+**                                                                    **
+** Commercial use of this program without express permission of the   **
+** University of California, Berkeley, is strictly prohibited.  See   **
+** file 'COPYRIGHT'  in main directory for information on usage and   **
+** redistribution,  and for a DISCLAIMER OF ALL WARRANTIES.           **
+**                                                                    **
+** Developed by:                                                      **
+**   Frank McKenna (fmckenna@ce.berkeley.edu)                         **
+**   Gregory L. Fenves (fenves@ce.berkeley.edu)                       **
+**   Filip C. Filippou (filippou@ce.berkeley.edu)                     **
+**                                                                    **
+** ****************************************************************** */
+
+#ifndef MatrixND_h
+#define MatrixND_h
+
+// Description: This file contains the class template MatrixND, a matrix
+// with its dimensions fixed at compile time. The data is stored column by
+// column in the object itself, the same layout as Matrix, so a Matrix can
+// be made a view of a MatrixND without a copy (see view()). With the loop
+// bounds known the compiler unrolls and vectorizes the small products of
+// the coordinate transformations and element kernels; there are no size
+// checks and no work arrays.
+
+#include <Matrix.h>
+#include <VectorND.h>
+
+template <int NR, int NC>
+class MatrixND
+{
+  public:
+    double values[NC][NR];
+
+    // element access, (row, col) as for Matrix
+    inline double &operator()(int row, int col) { return values[col][row]; }
+    inline double operator()(int row, int col) const { return values[col][row]; }
+
+    int noRows(void) const { return NR; }
+    int noCols(void) const { return NC; }
+
+    void Zero(void) {
+      for (int j = 0; j < NC; j++)
+	for (int i = 0; i < NR; i++)
+	  values[j][i] = 0.0;
+    }
+
+    // a Matrix using the data of this object; the MatrixND must outlive it
+    Matrix view(void) { return Matrix(&values[0][0], NR, NC); }
+
+    // copy from a Matrix of the same size
+    MatrixND &operator=(const Matrix &other) {
+      if (other.noRows() != NR || other.noCols() != NC) {
+	opserr << "MatrixND::operator=() - incompatible sizes\n";
+	return *this;
+      }
+      for (int j = 0; j < NC; j++)
+	for (int i = 0; i < NR; i++)
+	  values[j][i] = other(i,j);
+      return *this;
+    }
+
+    // this = thisFact*this + otherFact*other
+    void addMatrix(double thisFact, const MatrixND<NR,NC> &other, double otherFact) {
+      for (int j = 0; j < NC; j++)
+	for (int i = 0; i < NR; i++)
+	  values[j][i] = thisFact*values[j][i] + otherFact*other.values[j][i];
+    }
+
+    // this = thisFact*this + otherFact*A*B
+    template <int NK>
+    void addMatrixProduct(double thisFact, const MatrixND<NR,NK> &A,
+			  const MatrixND<NK,NC> &B, double otherFact) {
+      for (int j = 0; j < NC; j++) {
+	double col[NR];
+	for (int i = 0; i < NR; i++)
+	  col[i] = 0.0;
+	for (int k = 0; k < NK; k++) {
+	  double bkj = B.values[j][k];
+	  for (int i = 0; i < NR; i++)
+	    col[i] += A.values[k][i]*bkj;
+	}
+	for (int i = 0; i < NR; i++)
+	  values[j][i] = thisFact*values[j][i] + otherFact*col[i];
+      }
+    }
+
+    // this = thisFact*this + otherFact*A^T*B
+    template <int NK>
+    void addMatrixTransposeProduct(double thisFact, const MatrixND<NK,NR> &A,
+				   const MatrixND<NK,NC> &B, double otherFact) {
+      for (int j = 0; j < NC; j++)
+	for (int i = 0; i < NR; i++) {
+	  double sum = 0.0;
+	  for (int k = 0; k < NK; k++)
+	    sum += A.values[i][k]*B.values[j][k];
+	  values[j][i] = thisFact*values[j][i] + otherFact*sum;
+	}
+    }
+
+    // this = thisFact*this + otherFact*T^T*B*T, this square
+    template <int NK>
+    void addMatrixTripleProduct(double thisFact, const MatrixND<NK,NR> &T,
+				const MatrixND<NK,NK> &B, double otherFact) {
+      MatrixND<NK,NR> BT;
+      BT.addMatrixProduct(0.0, B, T, 1.0);
+      this->addMatrixTransposeProduct(thisFact, T, BT, otherFact);
+    }
+
+    // this(init_row+i, init_col+j) += fact*M(i,j)
+    template <int MR, int MC>
+    void Assemble(const MatrixND<MR,MC> &M, int init_row, int init_col, double fact) {
+      for (int j = 0; j < MC; j++)
+	for (int i = 0; i < MR; i++)
+	  values[init_col+j][init_row+i] += fact*M.values[j][i];
+    }
+
+    // this(init_row+i, init_col+j) += fact*M(j,i)
+    template <int MR, int MC>
+    void AssembleTranspose(const MatrixND<MR,MC> &M, int init_row, int init_col, double fact) {
+      for (int j = 0; j < MR; j++)
+	for (int i = 0; i < MC; i++)
+	  values[init_col+j][init_row+i] += fact*M.values[i][j];
+    }
+
+    // add this times fact to a Matrix of the same size
+    int addTo(Matrix &other, double fact = 1.0) const {
+      if (other.noRows() != NR || other.noCols() != NC) {
+	opserr << "MatrixND::addTo() - incompatible sizes\n";
+	return -1;
+      }
+      for (int j = 0; j < NC; j++)
+	for (int i = 0; i < NR; i++)
+	  other(i,j) += fact*values[j][i];
+      return 0;
+    }
+};
+
+// y = yFact*y + fact*A*x
+template <int NR, int NC>
+inline void
+addMatrixVector(VectorND<NR> &y, double yFact, const MatrixND<NR,NC> &A,
+		const VectorND<NC> &x, double fact)
+{
+  double sum[NR];
+  for (int i = 0; i < NR; i++)
+    sum[i] = 0.0;
+  for (int j = 0; j < NC; j++) {
+    double xj = x.values[j];
+    for (int i = 0; i < NR; i++)
+      sum[i] += A.values[j][i]*xj;
+  }
+  for (int i = 0; i < NR; i++)
+    y.values[i] = yFact*y.values[i] + fact*sum[i];
+}
+
+// y = yFact*y + fact*A^T*x
+template <int NR, int NC>
+inline void
+addMatrixTransposeVector(VectorND<NC> &y, double yFact, const MatrixND<NR,NC> &A,
+			 const VectorND<NR> &x, double fact)
+{
+  for (int j = 0; j < NC; j++) {
+    double sum = 0.0;
+    for (int i = 0; i < NR; i++)
+      sum += A.values[j][i]*x.values[i];
+    y.values[j] = yFact*y.values[j] + fact*sum;
+  }
+}
+
+#endif
@@ -41,6 +41,10 @@ using std::nothrow;
 
 double Vector::VECTOR_NOT_VALID_ENTRY =0.0;
 
+// number of data arrays allocated, counted if built with -D_ALLOC_COUNT
+// to check that the solution loops do not create temporaries
+static long numAllocations = 0;
+
 // Vector():
 //	Standard constructor, sets size = 0;
 
@@ -66,6 +70,9 @@ Vector::Vector(int size)
   // get some space for the vector
   //  theData = (double *)malloc(size*sizeof(double));
   if (size > 0) {
+#ifdef _ALLOC_COUNT
+    numAllocations++;
+#endif
     theData = new (nothrow) double [size];
 
     if (theData == 0) {
@@ -102,6 +109,9 @@ Vector::Vector(const Vector &other)
 : sz(other.sz),theData(0),fromFree(0)
 {
   if (sz != 0) {
+#ifdef _ALLOC_COUNT
+    numAllocations++;
+#endif
     theData = new (nothrow) double [other.sz];    
     
     if (theData == 0) {
@@ -183,6 +193,9 @@ Vector::resize(int newSize){
     
     // create new memory
     // theData = (double *)malloc(newSize*sizeof(double));    
+#ifdef _ALLOC_COUNT
+    numAllocations++;
+#endif
     theData = new (nothrow) double[newSize];
     if (theData == 0) {
       opserr << "Vector::resize() - out of memory for size " << newSize << endln;
@@ -323,6 +336,46 @@ Vector::addVector(double thisFact, const Vector &other, double otherFact )
   // successful
   return 0;
 }
+
+
+// this = thisFact*this + aFact*a + bFact*b, in one pass & without a
+// temporary; for the integrator & algorithm updates of the form
+// U = Ut + c1*Udot + c2*Udotdot
+int
+Vector::addVector(double thisFact, const Vector &a, double aFact,
+		  const Vector &b, double bFact)
+{
+#ifdef _G3DEBUG
+  if (sz != a.sz || sz != b.sz) {
+    opserr <<  "WARNING Vector::addVector() - incompatible Vector sizes\n";
+    return -1;
+  }
+#endif
+
+  double *dataPtr = theData;
+  const double *aDataPtr = a.theData;
+  const double *bDataPtr = b.theData;
+
+  if (thisFact == 1.0) {
+    for (int i=0; i<sz; i++) 
+      *dataPtr++ += *aDataPtr++ * aFact + *bDataPtr++ * bFact;
+  } 
+
+  else if (thisFact == 0.0) {
+    for (int i=0; i<sz; i++) 
+      *dataPtr++ = *aDataPtr++ * aFact + *bDataPtr++ * bFact;
+  }
+
+  else {
+    for (int i=0; i<sz; i++) {
+      double value = *dataPtr * thisFact + *aDataPtr++ * aFact + *bDataPtr++ * bFact;
+      *dataPtr++ = value;
+    }
+  } 
+
+  // successful
+  return 0;
+}
 	    
 	
 int
@@ -649,6 +702,9 @@ Vector::operator[](int x)
 #endif
   
   if (x >= sz) {
+#ifdef _ALLOC_COUNT
+    numAllocations++;
+#endif
     double *dataNew = new (nothrow) double[x+1];
     for (int i=0; i<sz; i++)
       dataNew[i] = theData[i];
@@ -745,6 +801,9 @@ Vector::operator=(const Vector &V)
 	  this->sz = V.sz;
 	  
 	  // Check that we are not creating an empty Vector
+#ifdef _ALLOC_COUNT
+	  numAllocations++;
+#endif
 	  theData = (sz != 0) ? new (nothrow) double[sz] : 0;
       }
 
@@ -1214,3 +1273,9 @@ Matrix Vector::operator%(const Vector &V) const
   return result;
   
 }
+
+long
+Vector::getNumAllocations(void)
+{
+  return numAllocations;
+}
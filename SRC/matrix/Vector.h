@@ -65,6 +65,8 @@ class Vector
     int Normalize(void);
     
     int addVector(double factThis, const Vector &other, double factOther);
+    int addVector(double factThis, const Vector &a, double factA,
+		  const Vector &b, double factB);
     int addMatrixVector(double factThis, const Matrix &m, const Vector &v, double factOther); 
     int addMatrixTransposeVector(double factThis, const Matrix &m, const Vector &v, double factOther);
 
@@ -107,6 +109,9 @@ class Vector
     // methods added by Remo
     int  Assemble(const Vector &V, int init_row, double fact = 1.0);
     int  Extract (const Vector &V, int init_row, double fact = 1.0); 
+
+    // data arrays allocated, counted if built with -D_ALLOC_COUNT
+    static long getNumAllocations(void);
   
     friend OPS_Stream &operator<<(OPS_Stream &s, const Vector &V);
     // friend istream &operator>>(istream &s, Vector &V);    
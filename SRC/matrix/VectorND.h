@@ -0,0 +1,91 @@
+/* ****************************************************************** **
+**    OpenSees - Open System for Earthquake Engineering Simulation    **
+**          Pacific Earthquake Engineering Research Center            **
+**                                                                    **
+**                                                                    **
+** (C) Copyright 1999, The Regents of the University of California    **
+** All Rights Reserved.                                               **
+**                                                                    **
+** Commercial use of this program without express permission of the   **
+** University of California, Berkeley, is strictly prohibited.  See   **
+** file 'COPYRIGHT'  in main directory for information on usage and   **
+** redistribution,  and for a DISCLAIMER OF ALL WARRANTIES.           **
+**                                                                    **
+** Developed by:                                                      **
+**   Frank McKenna (fmckenna@ce.berkeley.edu)                         **
+**   Gregory L. Fenves (fenves@ce.berkeley.edu)                       **
+**   Filip C. Filippou (filippou@ce.berkeley.edu)                     **
+**                                                                    **
+** ****************************************************************** */
+
+#ifndef VectorND_h
+#define VectorND_h
+
+// Description: This file contains the class template VectorND, a vector
+// whose size is fixed at compile time and whose data is held in the
+// object. A Vector can be made a view of it without a copy (see view()).
+// It is the companion of MatrixND.
+
+#include <Vector.h>
+#include <math.h>
+
+template <int N>
+class VectorND
+{
+  public:
+    double values[N];
+
+    inline double &operator()(int i) { return values[i]; }
+    inline double operator()(int i) const { return values[i]; }
+
+    int Size(void) const { return N; }
+
+    void Zero(void) {
+      for (int i = 0; i < N; i++)
+	values[i] = 0.0;
+    }
+
+    // a Vector using the data of this object; the VectorND must outlive it
+    Vector view(void) { return Vector(values, N); }
+
+    // copy from a Vector of the same size
+    VectorND &operator=(const Vector &other) {
+      if (other.Size() != N) {
+	opserr << "VectorND::operator=() - incompatible sizes\n";
+	return *this;
+      }
+      for (int i = 0; i < N; i++)
+	values[i] = other(i);
+      return *this;
+    }
+
+    // this = thisFact*this + otherFact*other
+    void addVector(double thisFact, const VectorND<N> &other, double otherFact) {
+      for (int i = 0; i < N; i++)
+	values[i] = thisFact*values[i] + otherFact*other.values[i];
+    }
+
+    double dot(const VectorND<N> &other) const {
+      double sum = 0.0;
+      for (int i = 0; i < N; i++)
+	sum += values[i]*other.values[i];
+      return sum;
+    }
+
+    double Norm(void) const {
+      return sqrt(this->dot(*this));
+    }
+
+    // add this times fact to a Vector of the same size
+    int addTo(Vector &other, double fact = 1.0) const {
+      if (other.Size() != N) {
+	opserr << "VectorND::addTo() - incompatible sizes\n";
+	return -1;
+      }
+      for (int i = 0; i < N; i++)
+	other(i) += fact*values[i];
+      return 0;
+    }
+};
+
+#endif
@@ -0,0 +1,578 @@
+/* ****************************************************************** **
+**    OpenSees - Open System for Earthquake Engineering Simulation    **
+**          Pacific Earthquake Engineering Research Center            **
+**                                                                    **
+**                                                                    **
+** (C) Copyright 1999, The Regents of the University of California    **
+** All Rights Reserved.                                               **
+**                                                                    **
+** Commercial use of this program without express permission of the   **
+** University of California, Berkeley, is strictly prohibited.  See   **
+** file 'COPYRIGHT'  in main directory for information on usage and   **
+** redistribution,  and for a DISCLAIMER OF ALL WARRANTIES.           **
+**                                                                    **
+** Developed by:                                                      **
+**   Frank McKenna (fmckenna@ce.berkeley.edu)                         **
+**   Gregory L. Fenves (fenves@ce.berkeley.edu)                       **
+**   Filip C. Filippou (filippou@ce.berkeley.edu)                     **
+**                                                                    **
+** ****************************************************************** */
+
+// Description: This file contains the implementation of the
+// MeshImport class.
+
+#include <MeshImport.h>
+#include <Domain.h>
+#include <Node.h>
+#include <SP_Constraint.h>
+#include <MP_Constraint.h>
+#include <Matrix.h>
+#include <ID.h>
+#include <NDMaterial.h>
+#include <UniaxialMaterial.h>
+#include <SectionForceDeformation.h>
+#include <Brick.h>
+#include <SSPbrick.h>
+#include <FourNodeTetrahedron.h>
+#include <FourNodeQuad.h>
+#include <SSPquad.h>
+#include <Truss.h>
+#include <ShellMITC4.h>
+#include <OPS_Globals.h>
+#include <string.h>
+
+// the block types of the file
+enum {BLOCK_END = 0, BLOCK_NODES = 1, BLOCK_ELEMENTS = 2, BLOCK_FIX = 3,
+      BLOCK_MASS = 4, BLOCK_EQUALDOF = 5};
+
+// the element types: the number of nodes and ints and the range of the
+// number of doubles, the doubles left out are 0
+enum {ELE_STDBRICK, ELE_SSPBRICK, ELE_TETRAHEDRON, ELE_QUAD, ELE_SSPQUAD,
+      ELE_TRUSS, ELE_SHELLMITC4, ELE_NUMTYPES};
+
+static const struct {
+  const char *name;
+  int numNodes, numInt, minDouble, maxDouble;
+} eleTypes[ELE_NUMTYPES] = {
+  {"stdBrick",            8, 1, 0, 3},
+  {"SSPbrick",            8, 1, 0, 3},
+  {"FourNodeTetrahedron", 4, 1, 0, 3},
+  {"quad",                4, 2, 1, 5},
+  {"SSPquad",             4, 2, 1, 3},
+  {"truss",               2, 1, 1, 2},
+  {"ShellMITC4",          4, 1, 0, 0}
+};
+
+static const int maxEleDouble = 5;
+
+MeshImport::MeshImport(Domain &theDomain, const char *name, int nDM)
+:ModelBuilder(theDomain), fileName(0), theFile(0), fileSize(0), ndm(nDM),
+ numNodes(0), numElements(0), numSPs(0), numMPs(0)
+{
+  fileName = new char[strlen(name)+1];
+  strcpy(fileName, name);
+}
+
+MeshImport::MeshImport(Domain &theDomain, int nDM)
+:ModelBuilder(theDomain), fileName(0), theFile(0), fileSize(0), ndm(nDM),
+ numNodes(0), numElements(0), numSPs(0), numMPs(0)
+{
+
+}
+
+MeshImport::~MeshImport()
+{
+  if (theFile != 0)
+    fclose(theFile);
+  if (fileName != 0)
+    delete [] fileName;
+}
+
+int
+MeshImport::buildFE_Model(void)
+{
+  if (fileName == 0) {
+    opserr << "MeshImport::buildFE_Model - no mesh file\n";
+    return -1;
+  }
+
+  theFile = fopen(fileName, "rb");
+  if (theFile == 0) {
+    opserr << "MeshImport::buildFE_Model - could not open file " << fileName << endln;
+    return -1;
+  }
+
+  // the size bounds the counts read from the file
+  if (fseek(theFile, 0, SEEK_END) != 0 || (fileSize = ftell(theFile)) < 0 ||
+      fseek(theFile, 0, SEEK_SET) != 0) {
+    opserr << "MeshImport::buildFE_Model - could not read file " << fileName << endln;
+    return -1;
+  }
+
+  char magic[8];
+  if (fread(magic, 1, 8, theFile) != 8 || strncmp(magic, "OPSMESH1", 8) != 0) {
+    opserr << "MeshImport::buildFE_Model - " << fileName << " is not a mesh file\n";
+    return -1;
+  }
+
+  int fileNDM;
+  if (fread(&fileNDM, sizeof(int), 1, theFile) != 1 || fileNDM < 1 || fileNDM > 3) {
+    opserr << "MeshImport::buildFE_Model - invalid ndm in " << fileName << endln;
+    return -1;
+  }
+  if (fileNDM != ndm) {
+    opserr << "MeshImport::buildFE_Model - ndm " << fileNDM << " of " << fileName;
+    opserr << " differs from ndm " << ndm << " of the model\n";
+    return -1;
+  }
+
+  int res = 0;
+  int head[2];
+  while (res == 0 && fread(head, sizeof(int), 2, theFile) == 2) {
+    int type = head[0];
+    int count = head[1];
+    if (type == BLOCK_END)
+      break;
+
+    if (count < 0) {
+      opserr << "MeshImport::buildFE_Model - invalid block size " << count << endln;
+      res = -1;
+      break;
+    }
+
+    switch (type) {
+    case BLOCK_NODES:
+      res = this->readNodes(count);
+      break;
+    case BLOCK_ELEMENTS:
+      res = this->readElements(count);
+      break;
+    case BLOCK_FIX:
+      res = this->readFixes(count);
+      break;
+    case BLOCK_MASS:
+      res = this->readMasses(count);
+      break;
+    case BLOCK_EQUALDOF:
+      res = this->readEqualDOFs(count);
+      break;
+    default:
+      opserr << "MeshImport::buildFE_Model - unknown block type " << type << endln;
+      res = -1;
+    }
+  }
+
+  fclose(theFile);
+  theFile = 0;
+
+  if (res < 0) {
+    opserr << "MeshImport::buildFE_Model - failed to import " << fileName;
+    opserr << " after " << numNodes << " nodes, " << numElements << " elements, ";
+    opserr << numSPs << " fixed dofs and " << numMPs << " equalDOFs\n";
+  }
+
+  return res;
+}
+
+// the number of values of the given size left in the file
+size_t
+MeshImport::numRemaining(size_t size)
+{
+  long pos = ftell(theFile);
+  if (pos < 0 || pos >= fileSize)
+    return 0;
+  return (size_t)(fileSize - pos)/size;
+}
+
+int
+MeshImport::readInts(std::vector<int> &data, size_t num)
+{
+  // a corrupt count must not size the array beyond the file
+  if (num > this->numRemaining(sizeof(int))) {
+    opserr << "MeshImport::buildFE_Model - unexpected end of file\n";
+    return -1;
+  }
+  data.resize(num);
+  if (num > 0 && fread(&data[0], sizeof(int), num, theFile) != num) {
+    opserr << "MeshImport::buildFE_Model - unexpected end of file\n";
+    return -1;
+  }
+  return 0;
+}
+
+int
+MeshImport::readDoubles(std::vector<double> &data, size_t num)
+{
+  if (num > this->numRemaining(sizeof(double))) {
+    opserr << "MeshImport::buildFE_Model - unexpected end of file\n";
+    return -1;
+  }
+  data.resize(num);
+  if (num > 0 && fread(&data[0], sizeof(double), num, theFile) != num) {
+    opserr << "MeshImport::buildFE_Model - unexpected end of file\n";
+    return -1;
+  }
+  return 0;
+}
+
+int
+MeshImport::readNodes(int count)
+{
+  std::vector<int> ndf;
+  if (this->readInts(ndf, 1) < 0)
+    return -1;
+
+  if (ndf[0] < 1) {
+    opserr << "MeshImport::readNodes - invalid ndf " << ndf[0] << endln;
+    return -1;
+  }
+
+  std::vector<int> tags;
+  std::vector<double> crds;
+  if (this->readInts(tags, count) < 0 || this->readDoubles(crds, (size_t)count*ndm) < 0)
+    return -1;
+
+  return this->addNodes(count, ndf[0], tags.data(), crds.data());
+}
+
+int
+MeshImport::readElements(int count)
+{
+  char typeName[32];
+  if (fread(typeName, 1, 32, theFile) != 32) {
+    opserr << "MeshImport::readElements - unexpected end of file\n";
+    return -1;
+  }
+  typeName[31] = '\0';
+
+  std::vector<int> sizes;
+  if (this->readInts(sizes, 3) < 0)
+    return -1;
+  int numEleNodes = sizes[0];
+  int numInt = sizes[1];
+  int numDouble = sizes[2];
+
+  if (this->getElementType(typeName, numEleNodes, numInt, numDouble) < 0)
+    return -1;
+
+  std::vector<int> tags, nodes, iData;
+  std::vector<double> dData;
+  if (this->readInts(tags, count) < 0 ||
+      this->readInts(nodes, (size_t)count*numEleNodes) < 0 ||
+      this->readInts(iData, (size_t)count*numInt) < 0 ||
+      this->readDoubles(dData, (size_t)count*numDouble) < 0)
+    return -1;
+
+  return this->addElements(typeName, count, numEleNodes, numInt, numDouble,
+			   tags.data(), nodes.data(), iData.data(), dData.data());
+}
+
+int
+MeshImport::readFixes(int count)
+{
+  std::vector<int> ndf;
+  if (this->readInts(ndf, 1) < 0)
+    return -1;
+
+  if (ndf[0] < 1) {
+    opserr << "MeshImport::readFixes - invalid ndf " << ndf[0] << endln;
+    return -1;
+  }
+
+  std::vector<int> nodes, fix;
+  if (this->readInts(nodes, count) < 0 || this->readInts(fix, (size_t)count*ndf[0]) < 0)
+    return -1;
+
+  return this->addFixes(count, ndf[0], nodes.data(), fix.data());
+}
+
+int
+MeshImport::readMasses(int count)
+{
+  std::vector<int> ndf;
+  if (this->readInts(ndf, 1) < 0)
+    return -1;
+
+  if (ndf[0] < 1) {
+    opserr << "MeshImport::readMasses - invalid ndf " << ndf[0] << endln;
+    return -1;
+  }
+
+  std::vector<int> nodes;
+  std::vector<double> mass;
+  if (this->readInts(nodes, count) < 0 || this->readDoubles(mass, (size_t)count*ndf[0]) < 0)
+    return -1;
+
+  return this->addMasses(count, ndf[0], nodes.data(), mass.data());
+}
+
+int
+MeshImport::readEqualDOFs(int count)
+{
+  std::vector<int> numDOF;
+  if (this->readInts(numDOF, 1) < 0)
+    return -1;
+
+  if (numDOF[0] < 1) {
+    opserr << "MeshImport::readEqualDOFs - invalid number of dofs " << numDOF[0] << endln;
+    return -1;
+  }
+
+  std::vector<int> rNodes, cNodes, dofs;
+  if (this->readInts(rNodes, count) < 0 || this->readInts(cNodes, count) < 0 ||
+      this->readInts(dofs, (size_t)count*numDOF[0]) < 0)
+    return -1;
+
+  return this->addEqualDOFs(count, numDOF[0], rNodes.data(), cNodes.data(), dofs.data());
+}
+
+int
+MeshImport::addNodes(int count, int ndf, const int *tags, const double *crds)
+{
+  Domain *theDomain = this->getDomainPtr();
+
+  if (ndf < 1) {
+    opserr << "MeshImport::addNodes - invalid ndf " << ndf << endln;
+    return -1;
+  }
+
+  for (int i = 0; i < count; i++) {
+    const double *crd = &crds[(size_t)i*ndm];
+    Node *theNode = 0;
+    if (ndm == 1)
+      theNode = new Node(tags[i], ndf, crd[0]);
+    else if (ndm == 2)
+      theNode = new Node(tags[i], ndf, crd[0], crd[1]);
+    else
+      theNode = new Node(tags[i], ndf, crd[0], crd[1], crd[2]);
+
+    if (theDomain->addNode(theNode) == false) {
+      opserr << "MeshImport::addNodes - could not add node " << tags[i] << endln;
+      delete theNode;
+      return -1;
+    }
+    numNodes++;
+  }
+
+  return 0;
+}
+
+int
+MeshImport::getElementType(const char *typeName, int numEleNodes, int numInt, int numDouble)
+{
+  int type = 0;
+  while (type < ELE_NUMTYPES && strcmp(typeName, eleTypes[type].name) != 0)
+    type++;
+
+  if (type == ELE_NUMTYPES) {
+    opserr << "MeshImport::addElements - element type " << typeName << " is not supported\n";
+    return -1;
+  }
+
+  if (numEleNodes != eleTypes[type].numNodes || numInt != eleTypes[type].numInt ||
+      numDouble < eleTypes[type].minDouble || numDouble > eleTypes[type].maxDouble) {
+    opserr << "MeshImport::addElements - invalid data sizes " << numEleNodes << " ";
+    opserr << numInt << " " << numDouble << " for element type " << typeName << endln;
+    return -1;
+  }
+
+  return type;
+}
+
+int
+MeshImport::addElements(const char *typeName, int count, int numEleNodes,
+			int numInt, int numDouble, const int *tags,
+			const int *nodes, const int *iData, const double *dData)
+{
+  Domain *theDomain = this->getDomainPtr();
+
+  int type = this->getElementType(typeName, numEleNodes, numInt, numDouble);
+  if (type < 0)
+    return -1;
+
+  for (int i = 0; i < count; i++) {
+    Element *theEle = this->createElement(type, tags[i],
+					  &nodes[(size_t)i*numEleNodes],
+					  &iData[(size_t)i*numInt],
+					  numDouble > 0 ? &dData[(size_t)i*numDouble] : 0,
+					  numDouble);
+    if (theEle == 0)
+      return -1;
+
+    if (theDomain->addElement(theEle) == false) {
+      opserr << "MeshImport::addElements - could not add element " << tags[i] << endln;
+      delete theEle;
+      return -1;
+    }
+    numElements++;
+  }
+
+  return 0;
+}
+
+Element *
+MeshImport::createElement(int type, int tag, const int *nodes,
+			  const int *iData, const double *dData, int numDouble)
+{
+  double d[maxEleDouble];
+  for (int i = 0; i < maxEleDouble; i++)
+    d[i] = (i < numDouble) ? dData[i] : 0.0;
+
+  Element *theEle = 0;
+
+  if (type == ELE_TRUSS) {
+    UniaxialMaterial *theMaterial = OPS_getUniaxialMaterial(iData[0]);
+    if (theMaterial == 0) {
+      opserr << "MeshImport::createElement - no uniaxialMaterial " << iData[0];
+      opserr << " for element " << tag << endln;
+      return 0;
+    }
+    theEle = new Truss(tag, ndm, nodes[0], nodes[1], *theMaterial, d[0], d[1]);
+
+  } else if (type == ELE_SHELLMITC4) {
+    SectionForceDeformation *theSection = OPS_getSectionForceDeformation(iData[0]);
+    if (theSection == 0) {
+      opserr << "MeshImport::createElement - no section " << iData[0];
+      opserr << " for element " << tag << endln;
+      return 0;
+    }
+    theEle = new ShellMITC4(tag, nodes[0], nodes[1], nodes[2], nodes[3], *theSection);
+
+  } else {
+    NDMaterial *theMaterial = OPS_getNDMaterial(iData[0]);
+    if (theMaterial == 0) {
+      opserr << "MeshImport::createElement - no nDMaterial " << iData[0];
+      opserr << " for element " << tag << endln;
+      return 0;
+    }
+
+    const char *planeType = 0;
+    if (type == ELE_QUAD || type == ELE_SSPQUAD) {
+      if (iData[1] == 0)
+	planeType = "PlaneStrain";
+      else if (iData[1] == 1)
+	planeType = "PlaneStress";
+      else {
+	opserr << "MeshImport::createElement - invalid planeType " << iData[1];
+	opserr << " for element " << tag << endln;
+	return 0;
+      }
+    }
+
+    switch (type) {
+    case ELE_STDBRICK:
+      theEle = new Brick(tag, nodes[0], nodes[1], nodes[2], nodes[3],
+			 nodes[4], nodes[5], nodes[6], nodes[7],
+			 *theMaterial, d[0], d[1], d[2]);
+      break;
+    case ELE_SSPBRICK:
+      theEle = new SSPbrick(tag, nodes[0], nodes[1], nodes[2], nodes[3],
+			    nodes[4], nodes[5], nodes[6], nodes[7],
+			    *theMaterial, d[0], d[1], d[2]);
+      break;
+    case ELE_TETRAHEDRON:
+      theEle = new FourNodeTetrahedron(tag, nodes[0], nodes[1], nodes[2], nodes[3],
+				       *theMaterial, d[0], d[1], d[2]);
+      break;
+    case ELE_QUAD:
+      theEle = new FourNodeQuad(tag, nodes[0], nodes[1], nodes[2], nodes[3],
+				*theMaterial, planeType, d[0], d[1], d[2], d[3], d[4]);
+      break;
+    case ELE_SSPQUAD:
+      theEle = new SSPquad(tag, nodes[0], nodes[1], nodes[2], nodes[3],
+			   *theMaterial, planeType, d[0], d[1], d[2]);
+      break;
+    }
+  }
+
+  if (theEle == 0)
+    opserr << "MeshImport::createElement - ran out of memory creating element " << tag << endln;
+
+  return theEle;
+}
+
+int
+MeshImport::addFixes(int count, int ndf, const int *nodes, const int *fix)
+{
+  Domain *theDomain = this->getDomainPtr();
+
+  if (ndf < 1) {
+    opserr << "MeshImport::addFixes - invalid ndf " << ndf << endln;
+    return -1;
+  }
+
+  for (int i = 0; i < count; i++) {
+    for (int j = 0; j < ndf; j++) {
+      if (fix[(size_t)i*ndf+j] == 0)
+	continue;
+
+      SP_Constraint *theSP = new SP_Constraint(nodes[i], j, 0.0, true);
+      if (theDomain->addSP_Constraint(theSP) == false) {
+	opserr << "MeshImport::addFixes - could not fix dof " << j+1;
+	opserr << " of node " << nodes[i] << endln;
+	delete theSP;
+	return -1;
+      }
+      numSPs++;
+    }
+  }
+
+  return 0;
+}
+
+int
+MeshImport::addMasses(int count, int ndf, const int *nodes, const double *mass)
+{
+  Domain *theDomain = this->getDomainPtr();
+
+  if (ndf < 1) {
+    opserr << "MeshImport::addMasses - invalid ndf " << ndf << endln;
+    return -1;
+  }
+
+  Matrix theMass(ndf, ndf);
+  for (int i = 0; i < count; i++) {
+    for (int j = 0; j < ndf; j++)
+      theMass(j,j) = mass[(size_t)i*ndf+j];
+
+    if (theDomain->setMass(theMass, nodes[i]) != 0) {
+      opserr << "MeshImport::addMasses - could not set the mass of node " << nodes[i] << endln;
+      return -1;
+    }
+  }
+
+  return 0;
+}
+
+int
+MeshImport::addEqualDOFs(int count, int numDOF, const int *rNodes,
+			 const int *cNodes, const int *dofs)
+{
+  Domain *theDomain = this->getDomainPtr();
+
+  if (numDOF < 1) {
+    opserr << "MeshImport::addEqualDOFs - invalid number of dofs " << numDOF << endln;
+    return -1;
+  }
+
+  Matrix Ccr(numDOF, numDOF);
+  for (int j = 0; j < numDOF; j++)
+    Ccr(j,j) = 1.0;
+
+  ID rcDOF(numDOF);
+  for (int i = 0; i < count; i++) {
+    for (int j = 0; j < numDOF; j++)
+      rcDOF(j) = dofs[(size_t)i*numDOF+j] - 1;
+
+    MP_Constraint *theMP = new MP_Constraint(rNodes[i], cNodes[i], Ccr, rcDOF, rcDOF);
+    if (theDomain->addMP_Constraint(theMP) == false) {
+      opserr << "MeshImport::addEqualDOFs - could not tie node " << cNodes[i];
+      opserr << " to node " << rNodes[i] << endln;
+      delete theMP;
+      return -1;
+    }
+    numMPs++;
+  }
+
+  return 0;
+}
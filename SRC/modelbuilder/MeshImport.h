@@ -0,0 +1,108 @@
+/* ****************************************************************** **
+**    OpenSees - Open System for Earthquake Engineering Simulation    **
+**          Pacific Earthquake Engineering Research Center            **
+**                                                                    **
+**                                                                    **
+** (C) Copyright 1999, The Regents of the University of California    **
+** All Rights Reserved.                                               **
+**                                                                    **
+** Commercial use of this program without express permission of the   **
+** University of California, Berkeley, is strictly prohibited.  See   **
+** file 'COPYRIGHT'  in main directory for information on usage and   **
+** redistribution,  and for a DISCLAIMER OF ALL WARRANTIES.           **
+**                                                                    **
+** Developed by:                                                      **
+**   Frank McKenna (fmckenna@ce.berkeley.edu)                         **
+**   Gregory L. Fenves (fenves@ce.berkeley.edu)                       **
+**   Filip C. Filippou (filippou@ce.berkeley.edu)                     **
+**                                                                    **
+** ****************************************************************** */
+
+#ifndef MeshImport_h
+#define MeshImport_h
+
+// Description: This file contains the class definition for MeshImport.
+// A MeshImport creates the nodes, elements, fixities, nodal masses and
+// equalDOF constraints stored in a binary mesh file, so that large models
+// are defined without one interpreter command per object. The materials
+// and sections the elements refer to must exist before the import.
+//
+// The file holds 4 byte ints and 8 byte doubles in the byte order of the
+// machine. It starts with the 8 characters "OPSMESH1" and the int ndm,
+// which must be the ndm of the model, followed by blocks of the form: int type, int count, block data.
+// Within a block each quantity is stored for all count objects before
+// the next, so every array is read with one call:
+//
+//   1 nodes:     int ndf; int tag[count]; double crd[count][ndm]
+//   2 elements:  char type[32]; int numNodes, numInt, numDouble;
+//                int tag[count]; int node[count][numNodes];
+//                int iData[count][numInt]; double dData[count][numDouble]
+//   3 fix:       int ndf; int node[count]; int fix[count][ndf]
+//   4 mass:      int ndf; int node[count]; double mass[count][ndf]
+//   5 equalDOF:  int numDOF; int rNode[count]; int cNode[count];
+//                int dof[count][numDOF]             (dofs 1 through ndf)
+//   0 end of the mesh (the end of the file does as well)
+//
+// The element types, with iData and dData as for the element commands:
+//
+//   stdBrick, SSPbrick   8 nodes  matTag           <b1 b2 b3>
+//   FourNodeTetrahedron  4 nodes  matTag           <b1 b2 b3>
+//   quad                 4 nodes  matTag planeType thick <p rho b1 b2>
+//   SSPquad              4 nodes  matTag planeType thick <b1 b2>
+//   truss                2 nodes  matTag           A <rho>
+//   ShellMITC4           4 nodes  secTag
+//
+// where planeType is 0 for PlaneStrain and 1 for PlaneStress.
+//
+// The add methods create the objects of one block from arrays laid out as
+// in the file; they are used by the array commands of the Python module.
+
+#include <ModelBuilder.h>
+#include <stdio.h>
+#include <vector>
+
+class Element;
+
+class MeshImport : public ModelBuilder
+{
+  public:
+    MeshImport(Domain &theDomain, const char *fileName, int ndm);
+    MeshImport(Domain &theDomain, int ndm);
+    ~MeshImport();
+
+    int buildFE_Model(void);
+
+    int addNodes(int count, int ndf, const int *tags, const double *crds);
+    int addElements(const char *type, int count, int numNodes, int numInt,
+		    int numDouble, const int *tags, const int *nodes,
+		    const int *iData, const double *dData);
+    int addFixes(int count, int ndf, const int *nodes, const int *fix);
+    int addMasses(int count, int ndf, const int *nodes, const double *mass);
+    int addEqualDOFs(int count, int numDOF, const int *rNodes,
+		     const int *cNodes, const int *dofs);
+
+  protected:
+
+  private:
+    int readNodes(int count);
+    int readElements(int count);
+    int readFixes(int count);
+    int readMasses(int count);
+    int readEqualDOFs(int count);
+
+    int getElementType(const char *type, int numNodes, int numInt, int numDouble);
+    Element *createElement(int type, int tag, const int *nodes,
+			   const int *iData, const double *dData, int numDouble);
+
+    int readInts(std::vector<int> &data, size_t num);
+    int readDoubles(std::vector<double> &data, size_t num);
+    size_t numRemaining(size_t size);
+
+    char *fileName;
+    FILE *theFile;
+    long fileSize;
+    int ndm;
+    int numNodes, numElements, numSPs, numMPs;
+};
+
+#endif
@@ -123,6 +123,7 @@ extern const char * getInterpPWD(Tcl_Interp *interp);  //L.Jiang [SIF]
 #include <StrengthDegradation.h>
 #include <HystereticBackbone.h>
 #include <BeamIntegration.h>
+#include <MeshImport.h>
 
 ////////////////////// gnp adding damping 
 #include <Element.h>
@@ -173,6 +174,9 @@ TclCommand_mesh(ClientData clientData, Tcl_Interp *interp,  int argc,
 int
 TclCommand_remesh(ClientData clientData, Tcl_Interp *interp,  int argc, 
 		  TCL_Char **argv);
+int
+TclCommand_meshImport(ClientData clientData, Tcl_Interp *interp,  int argc, 
+		      TCL_Char **argv);
 #if defined(OPSDEF_Element_PFEM)
 int 
 TclCommand_backgroundMesh(ClientData clientData, Tcl_Interp *interp, int argc, TCL_Char **argv);
@@ -486,6 +490,8 @@ TclModelBuilder::TclModelBuilder(Domain &theDomain, Tcl_Interp *interp, int NDM,
 		    (ClientData)NULL, NULL);
   Tcl_CreateCommand(interp, "remesh", TclCommand_remesh,
 		    (ClientData)NULL, NULL);
+  Tcl_CreateCommand(interp, "meshImport", TclCommand_meshImport,
+		    (ClientData)NULL, NULL);
 #if defined(OPSDEF_Element_PFEM)
   Tcl_CreateCommand(interp, "background", &TclCommand_backgroundMesh, 
 		    (ClientData)NULL, (Tcl_CmdDeleteProc *)NULL);
@@ -726,6 +732,7 @@ TclModelBuilder::~TclModelBuilder()
   Tcl_DeleteCommand(theInterp, "element");
   Tcl_DeleteCommand(theInterp, "mesh");
   Tcl_DeleteCommand(theInterp, "remesh");
+  Tcl_DeleteCommand(theInterp, "meshImport");
   Tcl_DeleteCommand(theInterp, "background");
   Tcl_DeleteCommand(theInterp, "uniaxialMaterial");
   Tcl_DeleteCommand(theInterp, "nDMaterial");
@@ -1407,6 +1414,32 @@ TclCommand_remesh(ClientData clientData, Tcl_Interp *interp,  int argc,
 
 }
 
+int
+TclCommand_meshImport(ClientData clientData, Tcl_Interp *interp,  int argc, 
+		      TCL_Char **argv) 
+{
+    // ensure the destructor has not been called - 
+    if (theTclBuilder == 0) {
+	opserr << "WARNING builder has been destroyed" << endln;
+	return TCL_ERROR;
+    }
+
+    // make sure correct number of arguments on command line
+    if (argc < 2) {
+	opserr << "WARNING insufficient arguments\n";
+	opserr << "Want: meshImport fileName?\n";
+	return TCL_ERROR;
+    }
+
+    MeshImport theImport(*theTclDomain, argv[1], theTclBuilder->getNDM());
+    if (theImport.buildFE_Model() < 0) {
+	opserr << "WARNING failed to import mesh " << argv[1] << endln;
+	return TCL_ERROR;
+    }
+
+    return TCL_OK;
+}
+
 #if defined(OPSDEF_Element_PFEM)
 extern int OPS_BgMesh();
 
@@ -0,0 +1,404 @@
+/* ****************************************************************** **
+**    OpenSees - Open System for Earthquake Engineering Simulation    **
+**          Pacific Earthquake Engineering Research Center            **
+**                                                                    **
+**                                                                    **
+** (C) Copyright 1999, The Regents of the University of California    **
+** All Rights Reserved.                                               **
+**                                                                    **
+** Commercial use of this program without express permission of the   **
+** University of California, Berkeley, is strictly prohibited.  See   **
+** file 'COPYRIGHT'  in main directory for information on usage and   **
+** redistribution,  and for a DISCLAIMER OF ALL WARRANTIES.           **
+**                                                                    **
+** Developed by:                                                      **
+**   Frank McKenna (fmckenna@ce.berkeley.edu)                         **
+**   Gregory L. Fenves (fenves@ce.berkeley.edu)                       **
+**   Filip C. Filippou (filippou@ce.berkeley.edu)                     **
+**                                                                    **
+** ****************************************************************** */
+                                                                        
+// Created: 10/26
+//
+// Description: This file contains the class implementation for PeriodRecorder.
+// A PeriodRecorder is used to record the periods of the lowest modes of the
+// current tangent at regular intervals during an analysis.
+
+#include <PeriodRecorder.h>
+#include <Domain.h>
+#include <Vector.h>
+#include <classTags.h>
+
+#include <StandardStream.h>
+#include <DataFileStream.h>
+#include <XmlFileStream.h>
+#include <BinaryFileStream.h>
+
+#include <ArpackSOE.h>
+#include <LinearSOE.h>
+#include <AnalysisModel.h>
+#include <FE_Element.h>
+#include <FE_EleIter.h>
+#include <DOF_Group.h>
+#include <DOF_GrpIter.h>
+#include <Graph.h>
+
+#include <elementAPI.h>
+
+#include <string.h>
+#include <math.h>
+
+void*
+OPS_PeriodRecorder()
+{
+    if (OPS_GetNumRemainingInputArgs() < 1) {
+        opserr << "WARNING: recorder Period <-file fileName?> <-numModes numModes?> ";
+        opserr << "<-interval numSteps?> <-dT dT?> <-subspace numIter? tol?>\n";
+        return 0;
+    }
+
+    OPS_Stream *theOutputStream = 0;
+    const char* filename = 0;
+
+    const int STANDARD_STREAM = 0;
+    const int DATA_STREAM = 1;
+    const int XML_STREAM = 2;
+    const int BINARY_STREAM = 4;
+    const int DATA_STREAM_CSV = 5;
+
+    int eMode = STANDARD_STREAM;
+
+    int numModes = 1;
+    int interval = 1;
+    double dT = 0.0;
+    double rTolDt = 0.00001;
+    int numIter = 4;
+    double tol = 1.0e-6;
+    bool echoTime = true;
+    bool doScientific = false;
+    bool closeOnWrite = false;
+    int precision = 6;
+
+    while (OPS_GetNumRemainingInputArgs() > 0) {
+
+        const char* option = OPS_GetString();
+
+        if (strcmp(option, "-file") == 0) {
+            if (OPS_GetNumRemainingInputArgs() > 0)
+                filename = OPS_GetString();
+            eMode = DATA_STREAM;
+        }
+        else if (strcmp(option, "-csv") == 0) {
+            if (OPS_GetNumRemainingInputArgs() > 0)
+                filename = OPS_GetString();
+            eMode = DATA_STREAM_CSV;
+        }
+        else if (strcmp(option, "-xml") == 0) {
+            if (OPS_GetNumRemainingInputArgs() > 0)
+                filename = OPS_GetString();
+            eMode = XML_STREAM;
+        }
+        else if (strcmp(option, "-binary") == 0) {
+            if (OPS_GetNumRemainingInputArgs() > 0)
+                filename = OPS_GetString();
+            eMode = BINARY_STREAM;
+        }
+        else if (strcmp(option, "-scientific") == 0) {
+            doScientific = true;
+        }
+        else if (strcmp(option, "-closeOnWrite") == 0) {
+            closeOnWrite = true;
+        }
+        else if (strcmp(option, "-noTime") == 0) {
+            echoTime = false;
+        }
+        else if (strcmp(option, "-precision") == 0) {
+            int num = 1;
+            if (OPS_GetIntInput(&num, &precision) < 0) {
+                opserr << "WARNING: recorder Period - failed to read precision\n";
+                return 0;
+            }
+        }
+        else if (strcmp(option, "-numModes") == 0) {
+            int num = 1;
+            if (OPS_GetIntInput(&num, &numModes) < 0 || numModes < 1) {
+                opserr << "WARNING: recorder Period - invalid numModes\n";
+                return 0;
+            }
+        }
+        else if (strcmp(option, "-interval") == 0) {
+            int num = 1;
+            if (OPS_GetIntInput(&num, &interval) < 0 || interval < 1) {
+                opserr << "WARNING: recorder Period - invalid interval\n";
+                return 0;
+            }
+        }
+        else if (strcmp(option, "-dT") == 0) {
+            int num = 1;
+            if (OPS_GetDoubleInput(&num, &dT) < 0) {
+                opserr << "WARNING: recorder Period - failed to read dT\n";
+                return 0;
+            }
+        }
+        else if (strcmp(option, "-rTolDt") == 0) {
+            int num = 1;
+            if (OPS_GetDoubleInput(&num, &rTolDt) < 0) {
+                opserr << "WARNING: recorder Period - failed to read rTolDt\n";
+                return 0;
+            }
+        }
+        else if (strcmp(option, "-subspace") == 0) {
+            int num = 1;
+            if (OPS_GetIntInput(&num, &numIter) < 0 || numIter < 0) {
+                opserr << "WARNING: recorder Period - invalid number of subspace iterations\n";
+                return 0;
+            }
+            if (OPS_GetNumRemainingInputArgs() > 0) {
+                if (OPS_GetDoubleInput(&num, &tol) < 0) {
+                    // not a tolerance; leave it for the next option
+                    OPS_ResetCurrentInputArg(-1);
+                }
+            }
+        }
+        else {
+            opserr << "WARNING: recorder Period - unknown option " << option << endln;
+        }
+    }
+
+    // data handler
+    if (eMode == DATA_STREAM && filename != 0)
+        theOutputStream = new DataFileStream(filename, OVERWRITE, 2, 0, closeOnWrite, precision, doScientific);
+    else if (eMode == DATA_STREAM_CSV && filename != 0)
+        theOutputStream = new DataFileStream(filename, OVERWRITE, 2, 1, closeOnWrite, precision, doScientific);
+    else if (eMode == XML_STREAM && filename != 0)
+        theOutputStream = new XmlFileStream(filename);
+    else if (eMode == BINARY_STREAM && filename != 0)
+        theOutputStream = new BinaryFileStream(filename);
+    else
+        theOutputStream = new StandardStream();
+
+    theOutputStream->setPrecision(precision);
+
+    Domain* domain = OPS_GetDomain();
+    if (domain == 0)
+        return 0;
+
+    return new PeriodRecorder(numModes, *domain, *theOutputStream,
+                              interval, dT, rTolDt, numIter, tol, echoTime);
+}
+
+
+PeriodRecorder::PeriodRecorder()
+:Recorder(RECORDER_TAGS_PeriodRecorder),
+ numModes(0), theDomain(0), theOutputHandler(0),
+ interval(1), numCommits(0),
+ deltaT(0.0), relDeltaTTol(0.00001), nextTimeStampToRecord(0.0),
+ numSubspaceIter(0), subspaceTol(1.0e-6), echoTimeFlag(true),
+ initializationDone(false),
+ theEigenSOE(0), theModel(0), theLinearSOE(0), domainStamp(-1)
+{
+
+}
+
+PeriodRecorder::PeriodRecorder(int nModes,
+			       Domain &theDom,
+			       OPS_Stream &theOutput,
+			       int numSteps,
+			       double dT,
+			       double rTolDt,
+			       int numIter,
+			       double tol,
+			       bool echoTime)
+:Recorder(RECORDER_TAGS_PeriodRecorder),
+ numModes(nModes), theDomain(&theDom), theOutputHandler(&theOutput),
+ interval(numSteps), numCommits(0),
+ deltaT(dT), relDeltaTTol(rTolDt), nextTimeStampToRecord(0.0),
+ numSubspaceIter(numIter), subspaceTol(tol), echoTimeFlag(echoTime),
+ initializationDone(false),
+ theEigenSOE(0), theModel(0), theLinearSOE(0), domainStamp(-1)
+{
+  if (interval < 1)
+    interval = 1;
+}
+
+PeriodRecorder::~PeriodRecorder()
+{
+  if (theOutputHandler != 0) {
+    theOutputHandler->endTag(); // Data
+    delete theOutputHandler;
+  }
+
+  if (theEigenSOE != 0)
+    delete theEigenSOE;
+}
+
+int 
+PeriodRecorder::record(int commitTag, double timeStamp)
+{
+  if (theDomain == 0 || theOutputHandler == 0)
+    return 0;
+
+  // only every interval commits & at the requested time spacing
+  numCommits++;
+  if (numCommits < interval)
+    return 0;
+
+  if (deltaT != 0.0 && timeStamp - nextTimeStampToRecord < -deltaT * relDeltaTTol)
+    return 0;
+
+  numCommits = 0;
+  if (deltaT != 0.0)
+    nextTimeStampToRecord = timeStamp + deltaT;
+
+  if (initializationDone == false)
+    if (this->initialize() != 0)
+      return -1;
+
+  //
+  // the eigenpairs are found with an ArpackSOE owned by the recorder, so
+  // the EigenSOE of the analysis, the eigen command and the eigenpairs
+  // stored in the domain are left as they are
+  //
+
+  AnalysisModel **theModelPtr = OPS_GetAnalysisModel();
+  LinearSOE **theSOEPtr = OPS_GetSOE();
+
+  if (theModelPtr == 0 || *theModelPtr == 0 || theSOEPtr == 0 || *theSOEPtr == 0) {
+    opserr << "WARNING PeriodRecorder::record() - no analysis has been defined\n";
+    return -1;
+  }
+
+  if (theEigenSOE == 0) {
+    theEigenSOE = new ArpackSOE(0.0);
+    theEigenSOE->setSubspaceTracking(numSubspaceIter, subspaceTol);
+  }
+
+  int stamp = theDomain->hasDomainChanged();
+  if (*theModelPtr != theModel || *theSOEPtr != theLinearSOE || stamp != domainStamp) {
+    theModel = *theModelPtr;
+    theLinearSOE = *theSOEPtr;
+    domainStamp = stamp;
+
+    theEigenSOE->setLinks(*theModel);
+    theEigenSOE->setLinearSOE(*theLinearSOE);
+    Graph &theGraph = theModel->getDOFGraph();
+    if (theEigenSOE->setSize(theGraph) < 0) {
+      opserr << "WARNING PeriodRecorder::record() - failed to size the eigen system\n";
+      return -1;
+    }
+  }
+
+  //
+  // form K & M and solve
+  //
+
+  theEigenSOE->zeroA();
+  theEigenSOE->zeroM();
+
+  int result = 0;
+
+  FE_EleIter &theEles = theModel->getFEs();
+  FE_Element *elePtr;
+  while ((elePtr = theEles()) != 0) {
+    elePtr->zeroTangent();
+    elePtr->addKtToTang(1.0);
+    if (theEigenSOE->addA(elePtr->getTangent(0), elePtr->getID()) < 0)
+      result = -2;
+  }
+
+  FE_EleIter &theEles2 = theModel->getFEs();
+  while ((elePtr = theEles2()) != 0) {
+    elePtr->zeroTangent();
+    elePtr->addMtoTang(1.0);
+    if (theEigenSOE->addM(elePtr->getTangent(0), elePtr->getID()) < 0)
+      result = -2;
+  }
+
+  DOF_GrpIter &theDofs = theModel->getDOFs();
+  DOF_Group *dofPtr;
+  while ((dofPtr = theDofs()) != 0) {
+    dofPtr->zeroTangent();
+    dofPtr->addMtoTang(1.0);
+    if (theEigenSOE->addM(dofPtr->getTangent(0), dofPtr->getID()) < 0)
+      result = -3;
+  }
+
+  if (result == 0 && theEigenSOE->solve(numModes, true, true) < 0)
+    result = -4;
+
+  if (result < 0) {
+    opserr << "WARNING PeriodRecorder::record() - eigen analysis failed at time " << timeStamp << endln;
+    return result;
+  }
+
+  //
+  // write the time & periods
+  //
+
+  int loc = 0;
+  if (echoTimeFlag == true)
+    response(loc++) = timeStamp;
+
+  const double pi = 3.14159265358979323846;
+  for (int i=0; i<numModes; i++) {
+    double lambda = theEigenSOE->getEigenvalue(i+1);
+    response(loc++) = (lambda > 0.0) ? 2.0*pi/sqrt(lambda) : 0.0;
+  }
+
+  theOutputHandler->write(response);
+
+  return 0;
+}
+
+int
+PeriodRecorder::initialize(void)
+{
+  int numColumns = numModes;
+  if (echoTimeFlag == true)
+    numColumns++;
+  response.resize(numColumns);
+  response.Zero();
+
+  if (echoTimeFlag == true) {
+    theOutputHandler->tag("TimeOutput");
+    theOutputHandler->tag("ResponseType", "time");
+    theOutputHandler->endTag();
+  }
+
+  theOutputHandler->tag("PeriodOutput");
+  theOutputHandler->attr("numModes", numModes);
+  for (int i=1; i<=numModes; i++) {
+    char periodName[32];
+    sprintf(periodName, "T%d", i);
+    theOutputHandler->tag("ResponseType", periodName);
+  }
+  theOutputHandler->endTag();
+
+  theOutputHandler->tag("Data");
+
+  initializationDone = true;
+  return 0;
+}
+
+int
+PeriodRecorder::restart(void)
+{
+  numCommits = 0;
+  nextTimeStampToRecord = 0.0;
+  return 0;
+}
+
+int
+PeriodRecorder::flush(void)
+{
+  if (theOutputHandler != 0)
+    return theOutputHandler->flush();
+  return 0;
+}
+
+int
+PeriodRecorder::setDomain(Domain &theDom)
+{
+  theDomain = &theDom;
+  return 0;
+}
@@ -0,0 +1,94 @@
+/* ****************************************************************** **
+**    OpenSees - Open System for Earthquake Engineering Simulation    **
+**          Pacific Earthquake Engineering Research Center            **
+**                                                                    **
+**                                                                    **
+** (C) Copyright 1999, The Regents of the University of California    **
+** All Rights Reserved.                                               **
+**                                                                    **
+** Commercial use of this program without express permission of the   **
+** University of California, Berkeley, is strictly prohibited.  See   **
+** file 'COPYRIGHT'  in main directory for information on usage and   **
+** redistribution,  and for a DISCLAIMER OF ALL WARRANTIES.           **
+**                                                                    **
+** Developed by:                                                      **
+**   Frank McKenna (fmckenna@ce.berkeley.edu)                         **
+**   Gregory L. Fenves (fenves@ce.berkeley.edu)                       **
+**   Filip C. Filippou (filippou@ce.berkeley.edu)                     **
+**                                                                    **
+** ****************************************************************** */
+                                                                        
+#ifndef PeriodRecorder_h
+#define PeriodRecorder_h
+
+// Created: 10/26
+//
+// Description: This file contains the class definition for PeriodRecorder.
+// A PeriodRecorder tracks the periods of the lowest modes during an analysis.
+// Every interval commits it solves the eigenproblem of the current tangent
+// and mass of the analysis model and writes the time and periods to the
+// output stream. The recorder keeps its own ArpackSOE, in which the
+// eigenvectors of the previous record are refined by subspace iteration
+// rather than recomputed from scratch; the eigenpairs of the eigen command
+// are not touched.
+
+#include <Recorder.h>
+#include <Vector.h>
+
+class Domain;
+class OPS_Stream;
+class ArpackSOE;
+class AnalysisModel;
+class LinearSOE;
+
+class PeriodRecorder: public Recorder
+{
+  public:
+    PeriodRecorder();
+    PeriodRecorder(int numModes,
+		   Domain &theDomain,
+		   OPS_Stream &theOutputHandler,
+		   int interval = 1,
+		   double deltaT = 0.0,
+		   double relDeltaTTol = 0.00001,
+		   int numSubspaceIter = 4,
+		   double subspaceTol = 1.0e-6,
+		   bool echoTimeFlag = true);
+
+    ~PeriodRecorder();
+
+    int record(int commitTag, double timeStamp);
+    int restart(void);    
+    int flush(void);
+
+    int setDomain(Domain &theDomain);
+    
+  protected:
+    
+  private:	
+    int initialize(void);
+
+    int numModes;
+    Domain *theDomain;
+    OPS_Stream *theOutputHandler;
+
+    int interval;
+    int numCommits;
+    double deltaT;
+    double relDeltaTTol;
+    double nextTimeStampToRecord;
+
+    int numSubspaceIter;
+    double subspaceTol;
+    bool echoTimeFlag;
+
+    bool initializationDone;
+    Vector response;
+
+    ArpackSOE *theEigenSOE;
+    AnalysisModel *theModel;
+    LinearSOE *theLinearSOE;
+    int domainStamp;
+};
+
+#endif
@@ -56,6 +56,42 @@ using std::setw;
 using std::setprecision;
 using std::setiosflags;
 
+#if !defined(_WIN32) && !defined(_PARALLEL_PROCESSING) && !defined(_PARALLEL_INTERPRETERS)
+#define _SAMPLING_WORKERS
+#include <unistd.h>
+#include <sys/types.h>
+#include <sys/wait.h>
+#include <vector>
+
+static bool
+writeSampleRecord(int fd, const double *data, int numBytes)
+{
+  const char *ptr = (const char *)data;
+  while (numBytes > 0) {
+    ssize_t numWritten = write(fd, ptr, numBytes);
+    if (numWritten <= 0)
+      return false;
+    ptr += numWritten;
+    numBytes -= numWritten;
+  }
+  return true;
+}
+
+static bool
+readSampleRecord(int fd, double *data, int numBytes)
+{
+  char *ptr = (char *)data;
+  while (numBytes > 0) {
+    ssize_t numRead = read(fd, ptr, numBytes);
+    if (numRead <= 0)
+      return false;
+    ptr += numRead;
+    numBytes -= numRead;
+  }
+  return true;
+}
+#endif
+
 
 ImportanceSamplingAnalysis::ImportanceSamplingAnalysis(ReliabilityDomain *passedReliabilityDomain,
                                                        Domain *passedOpenSeesDomain,
@@ -66,7 +102,8 @@ ImportanceSamplingAnalysis::ImportanceSamplingAnalysis(ReliabilityDomain *passed
 							long int passedNumberOfSimulations,
                             double passedTargetCOV, double passedSamplingStdv,
 							int passedPrintFlag, TCL_Char *passedFileName,
-							int passedAnalysisTypeTag)
+							int passedAnalysisTypeTag,
+							int passedNumWorkers)
 :ReliabilityAnalysis(), theReliabilityDomain(passedReliabilityDomain), 
 theOpenSeesDomain(passedOpenSeesDomain)
 {
@@ -80,6 +117,7 @@ theOpenSeesDomain(passedOpenSeesDomain)
 	printFlag = passedPrintFlag;
 	strcpy(fileName,passedFileName);
 	analysisTypeTag = passedAnalysisTypeTag;
+	numWorkers = (passedNumWorkers > 1) ? passedNumWorkers : 1;
 }
 
 
@@ -206,13 +244,24 @@ ImportanceSamplingAnalysis::analyze(void)
 	double govCov = 999.0;
 	//Vector temp1;
 	double temp2, denumerator;
-	bool FEconvergence;
 
 
 	// Prepare output file
 	ofstream resultsOutputFile( fileName, ios::out );
 
 
+	// The samples are drawn & evaluated in batches. The random numbers are
+	// always generated here in sample order, so the estimates do not depend
+	// on how many workers evaluate the limit-state functions of a batch.
+	int batchSize = (numWorkers > 1) ? 4*numWorkers : 1;
+	Matrix uBatch(batchSize, numRV);
+	Matrix xBatch(batchSize, numRV);
+	Matrix gBatch(batchSize, numLsf);
+	ID convergedBatch(batchSize);
+	ID seedBatch(batchSize);
+	int numInBatch = 0;
+	int batchLoc = 0;
+
 	bool isFirstSimulation = true;
 	while( ( k <= numberOfSimulations && govCov > targetCOV || k <= 2 ) ) {
 
@@ -223,60 +272,61 @@ ImportanceSamplingAnalysis::analyze(void)
 		}
 
 		
-		// Create array of standard normal random numbers
-		if (isFirstSimulation) {
-			result = theRandomNumberGenerator->generate_nIndependentStdNormalNumbers(numRV,seed);
-		}
-		else {
-			result = theRandomNumberGenerator->generate_nIndependentStdNormalNumbers(numRV);
-		}
-		seed = theRandomNumberGenerator->getSeed();
-		if (result < 0) {
-			opserr << "ImportanceSamplingAnalysis::analyze() - could not generate" << endln
-				<< " random numbers for simulation." << endln;
-			return -1;
-		}
-		randomArray = theRandomNumberGenerator->getGeneratedNumbers();
-
-		// Compute the point in standard normal space
-		//u = startPointY + chol_covariance * randomArray;
-        u = startPointY;
-		u.addVector(1.0, randomArray, samplingStdv);
-
-		// Transform into original space
-		result = theProbabilityTransformation->transform_u_to_x(u, x);
-		if (result < 0) {
-		  opserr << "ImportanceSamplingAnalysis::analyze() - could not transform u to x. " << endln;
-		  return -1;
-		}
-        
-        // update domain with new x values
-        for (int j = 0; j < numRV; j++) {
-            RandomVariable *theRV = theReliabilityDomain->getRandomVariablePtrFromIndex(j);
-            int param_indx = theReliabilityDomain->getParameterIndexFromRandomVariableIndex(j);
-            Parameter *theParam = theOpenSeesDomain->getParameterFromIndex(param_indx);
-            
-            // now we should update the parameter value
-            theParam->update( x(j) );
-        }
-		
-        
-        // set values in the variable namespace
-        if (theGFunEvaluator->setVariables() < 0) {
-            opserr << "ImportanceSamplingAnalysis::analyze() - " << endln
-                << " could not set variables in namespace. " << endln;
-            return -1;
-        }
-        
-		// Evaluate limit-state function
-		FEconvergence = true;
-		if (theGFunEvaluator -> runAnalysis() < 0) {
-			// In this case a failure happened during the analysis
-			// Hence, register this as failure
-            opserr << "ERROR ImportanceSamplingAnalysis -- error running analysis" << endln;
-			FEconvergence = false;
+		// Draw & evaluate the next batch of samples if the current one is used up
+		if (batchLoc == numInBatch) {
+
+			numInBatch = batchSize;
+			if (numberOfSimulations - k + 1 < numInBatch)
+				numInBatch = numberOfSimulations - k + 1;
+			if (numInBatch < 1)
+				numInBatch = 1;
+
+			for (int b = 0; b < numInBatch; b++) {
+
+				// Create array of standard normal random numbers
+				if (isFirstSimulation && b == 0) {
+					result = theRandomNumberGenerator->generate_nIndependentStdNormalNumbers(numRV,seed);
+				}
+				else {
+					result = theRandomNumberGenerator->generate_nIndependentStdNormalNumbers(numRV);
+				}
+				seedBatch(b) = theRandomNumberGenerator->getSeed();
+				if (result < 0) {
+					opserr << "ImportanceSamplingAnalysis::analyze() - could not generate" << endln
+						<< " random numbers for simulation." << endln;
+					return -1;
+				}
+				randomArray = theRandomNumberGenerator->getGeneratedNumbers();
+
+				// Compute the point in standard normal space
+				//u = startPointY + chol_covariance * randomArray;
+				u = startPointY;
+				u.addVector(1.0, randomArray, samplingStdv);
+
+				// Transform into original space
+				result = theProbabilityTransformation->transform_u_to_x(u, x);
+				if (result < 0) {
+					opserr << "ImportanceSamplingAnalysis::analyze() - could not transform u to x. " << endln;
+					return -1;
+				}
+
+				for (int j = 0; j < numRV; j++) {
+					uBatch(b,j) = u(j);
+					xBatch(b,j) = x(j);
+				}
+			}
+
+			// Evaluate limit-state functions for the whole batch
+			if (this->evaluateBatch(numInBatch, xBatch, gBatch, convergedBatch) < 0)
+				return -1;
+
+			batchLoc = 0;
 		}
 
+		seed = seedBatch(batchLoc);
+		for (int j = 0; j < numRV; j++)
+			u(j) = uBatch(batchLoc,j);
+
 
 		LimitStateFunctionIter &lsfIter = theReliabilityDomain->getLimitStateFunctions();
 		LimitStateFunction *theLimitStateFunction;
@@ -289,14 +339,8 @@ ImportanceSamplingAnalysis::analyze(void)
 			// Set tag of "active" limit-state function
 			theReliabilityDomain->setTagOfActiveLimitStateFunction(lsfTag);
 
-            // set and evaluate LSF
-            const char *lsfExpression = theLimitStateFunction->getExpression();
-            theGFunEvaluator->setExpression(lsfExpression);
-            
-            gFunctionValue = theGFunEvaluator->evaluateExpression();
-            if (!FEconvergence) {
-				gFunctionValue = -1.0;
-			}
+            // g already evaluated with the batch (-1 if the FE analysis failed)
+            gFunctionValue = gBatch(batchLoc,lsf);
 
 			
 			// ESTIMATION OF FAILURE PROBABILITY
@@ -467,6 +511,7 @@ ImportanceSamplingAnalysis::analyze(void)
 
 		// Increment k (the simulation number counter)
 		k++;
+		batchLoc++;
 		isFirstSimulation = false;
 
 	}
@@ -612,3 +657,165 @@ ImportanceSamplingAnalysis::analyze(void)
 	return 0;
 }
 
+
+
+int
+ImportanceSamplingAnalysis::evaluateSample(const Vector &x, Vector &gValues, bool &FEconvergence)
+{
+	int numRV = x.Size();
+	int numLsf = gValues.Size();
+
+	// update domain with new x values
+	for (int j = 0; j < numRV; j++) {
+		int param_indx = theReliabilityDomain->getParameterIndexFromRandomVariableIndex(j);
+		Parameter *theParam = theOpenSeesDomain->getParameterFromIndex(param_indx);
+
+		// now we should update the parameter value
+		theParam->update( x(j) );
+	}
+
+	// set values in the variable namespace
+	if (theGFunEvaluator->setVariables() < 0) {
+		opserr << "ImportanceSamplingAnalysis::analyze() - " << endln
+		       << " could not set variables in namespace. " << endln;
+		return -1;
+	}
+
+	// Evaluate limit-state function
+	FEconvergence = true;
+	if (theGFunEvaluator -> runAnalysis() < 0) {
+		// In this case a failure happened during the analysis
+		// Hence, register this as failure
+		opserr << "ERROR ImportanceSamplingAnalysis -- error running analysis" << endln;
+		FEconvergence = false;
+	}
+
+	for (int lsf = 0; lsf < numLsf; lsf++ ) {
+		LimitStateFunction *theLimitStateFunction = 
+			theReliabilityDomain->getLimitStateFunctionPtrFromIndex(lsf);
+		int lsfTag = theLimitStateFunction->getTag();
+
+		// Set tag of "active" limit-state function
+		theReliabilityDomain->setTagOfActiveLimitStateFunction(lsfTag);
+
+		// set and evaluate LSF
+		const char *lsfExpression = theLimitStateFunction->getExpression();
+		theGFunEvaluator->setExpression(lsfExpression);
+
+		double gFunctionValue = theGFunEvaluator->evaluateExpression();
+		if (!FEconvergence) {
+			gFunctionValue = -1.0;
+		}
+		gValues(lsf) = gFunctionValue;
+	}
+
+	return 0;
+}
+
+
+
+int
+ImportanceSamplingAnalysis::evaluateBatch(int numSamples, const Matrix &xBatch,
+					  Matrix &gBatch, ID &convergedBatch)
+{
+	int numRV = xBatch.noCols();
+	int numLsf = gBatch.noCols();
+
+	Vector x(numRV);
+	Vector g(numLsf);
+	bool FEconvergence;
+	ID evaluated(numSamples);
+
+#ifdef _SAMPLING_WORKERS
+	//
+	// Each worker is a forked copy of this process, with its own copy of the
+	// domain & interpreter, that evaluates every numProcs'th sample of the
+	// batch and returns (sample, status, g values) through a pipe. Samples
+	// not returned by a worker are evaluated serially below.
+	//
+
+	if (numWorkers > 1 && numSamples > 1) {
+
+		int numProcs = (numWorkers < numSamples) ? numWorkers : numSamples;
+		int numRecord = 2 + numLsf;
+		Vector record(numRecord);
+		std::vector<int> readEnds;
+		std::vector<pid_t> pids;
+
+		opserr.flush();
+		fflush(stdout);
+		fflush(stderr);
+
+		for (int w = 0; w < numProcs; w++) {
+			int fd[2];
+			if (pipe(fd) != 0)
+				break;
+
+			pid_t pid = fork();
+			if (pid == 0) {
+				close(fd[0]);
+				for (unsigned int i = 0; i < readEnds.size(); i++)
+					close(readEnds[i]);
+
+				for (int b = w; b < numSamples; b += numProcs) {
+					for (int j = 0; j < numRV; j++)
+						x(j) = xBatch(b,j);
+					int res = this->evaluateSample(x, g, FEconvergence);
+					record(0) = b;
+					record(1) = (res < 0) ? -1.0 : (FEconvergence ? 1.0 : 0.0);
+					for (int lsf = 0; lsf < numLsf; lsf++)
+						record(2+lsf) = g(lsf);
+					if (!writeSampleRecord(fd[1], &record(0), numRecord*sizeof(double)))
+						break;
+				}
+
+				close(fd[1]);
+				opserr.flush();
+				fflush(stdout);
+				_exit(0);
+			}
+
+			close(fd[1]);
+			if (pid < 0) {
+				close(fd[0]);
+				break;
+			}
+			readEnds.push_back(fd[0]);
+			pids.push_back(pid);
+		}
+
+		for (unsigned int w = 0; w < readEnds.size(); w++) {
+			while (readSampleRecord(readEnds[w], &record(0), numRecord*sizeof(double))) {
+				int b = (int)record(0);
+				if (b < 0 || b >= numSamples || record(1) < 0.0)
+					continue;
+				convergedBatch(b) = (record(1) > 0.0) ? 1 : 0;
+				for (int lsf = 0; lsf < numLsf; lsf++) {
+					gBatch(b,lsf) = record(2+lsf);
+					theGFunEvaluator->incrementEvaluations();
+				}
+				evaluated(b) = 1;
+			}
+			close(readEnds[w]);
+			waitpid(pids[w], 0, 0);
+		}
+	}
+#endif
+
+	for (int b = 0; b < numSamples; b++) {
+		if (evaluated(b) != 0)
+			continue;
+
+		for (int j = 0; j < numRV; j++)
+			x(j) = xBatch(b,j);
+		if (this->evaluateSample(x, g, FEconvergence) < 0)
+			return -1;
+
+		convergedBatch(b) = FEconvergence ? 1 : 0;
+		for (int lsf = 0; lsf < numLsf; lsf++)
+			gBatch(b,lsf) = g(lsf);
+	}
+
+	return 0;
+}
+
@@ -39,6 +39,7 @@
 #include <ProbabilityTransformation.h>
 #include <RandomNumberGenerator.h>
 #include <FunctionEvaluator.h>
+#include <ID.h>
 
 #include <fstream>
 #include <tcl.h>
@@ -59,7 +60,8 @@ public:
 				   double samplingStdv,
 				   int printFlag,
 				   TCL_Char *fileName,
-				   int analysisTypeTag);
+				   int analysisTypeTag,
+				   int numWorkers = 1);
 	
 	~ImportanceSamplingAnalysis();
 	
@@ -68,6 +70,10 @@ public:
 protected:
 	
 private:
+	int evaluateSample(const Vector &x, Vector &gValues, bool &FEconvergence);
+	int evaluateBatch(int numSamples, const Matrix &xBatch,
+			  Matrix &gBatch, ID &convergedBatch);
+
 	ReliabilityDomain *theReliabilityDomain;
     Domain *theOpenSeesDomain;
 	ProbabilityTransformation *theProbabilityTransformation;
@@ -80,6 +86,7 @@ private:
 	int printFlag;
 	char fileName[256];
 	int analysisTypeTag;
+	int numWorkers;
 };
 
 #endif
@@ -39,17 +39,60 @@
 #include <LimitStateFunction.h>
 #include <ReliabilityDomain.h>
 #include <Vector.h>
+#include <ID.h>
 #include <string.h>
 
+#if !defined(_WIN32) && !defined(_PARALLEL_PROCESSING) && !defined(_PARALLEL_INTERPRETERS)
+#define _GRADIENT_WORKERS
+#include <unistd.h>
+#include <sys/types.h>
+#include <sys/wait.h>
+
+static bool
+writeGradientRecord(int fd, const double *data, int numBytes)
+{
+  const char *ptr = (const char *)data;
+  while (numBytes > 0) {
+    ssize_t numWritten = write(fd, ptr, numBytes);
+    if (numWritten <= 0)
+      return false;
+    ptr += numWritten;
+    numBytes -= numWritten;
+  }
+  return true;
+}
+
+static bool
+readGradientRecord(int fd, double *data, int numBytes)
+{
+  char *ptr = (char *)data;
+  while (numBytes > 0) {
+    ssize_t numRead = read(fd, ptr, numBytes);
+    if (numRead <= 0)
+      return false;
+    ptr += numRead;
+    numBytes -= numRead;
+  }
+  return true;
+}
+#endif
+
+// bound on the number of memoized perturbed g values
+#define FD_GRADIENT_MAX_CACHE 100000
+
 FiniteDifferenceGradient::FiniteDifferenceGradient(
     FunctionEvaluator *passedGFunEvaluator,
     ReliabilityDomain *passedReliabilityDomain,
-    Domain *passedOpenSeesDomain)
+    Domain *passedOpenSeesDomain, int passedNumWorkers, bool passedUseCache)
 
     : GradientEvaluator(passedReliabilityDomain, passedGFunEvaluator),
-      theOpenSeesDomain(passedOpenSeesDomain) {
+      theOpenSeesDomain(passedOpenSeesDomain),
+      numWorkers(passedNumWorkers),
+      useCache(passedUseCache) {
     int nrv = passedReliabilityDomain->getNumberOfRandomVariables();
     grad_g = new Vector(nrv);
+
+    if (numWorkers < 1) numWorkers = 1;
 }
 
 FiniteDifferenceGradient::~FiniteDifferenceGradient() {
@@ -58,6 +101,143 @@ FiniteDifferenceGradient::~FiniteDifferenceGradient() {
 
 const Vector &FiniteDifferenceGradient::getGradient() { return *grad_g; }
 
+void FiniteDifferenceGradient::getPointKey(int rvIndex, double h,
+                                           std::vector<double> &key) {
+    // the perturbed point is identified by the active limit-state function
+    // and the current values of all random variable parameters, with
+    // the rvIndex'th one perturbed by h
+    int nrv = theReliabilityDomain->getNumberOfRandomVariables();
+    key.resize(nrv + 1);
+    key[0] = theReliabilityDomain->getTagOfActiveLimitStateFunction();
+    for (int j = 0; j < nrv; j++) {
+        int param_indx =
+            theReliabilityDomain->getParameterIndexFromRandomVariableIndex(
+                j);
+        Parameter *theParam =
+            theOpenSeesDomain->getParameterFromIndex(param_indx);
+        double value = (theParam != 0) ? theParam->getValue() : 0.0;
+        if (j == rvIndex) value += h;
+        key[j + 1] = value;
+    }
+}
+
+int FiniteDifferenceGradient::evaluatePerturbed(const char *lsfExpression,
+                                                double &gPerturbed) {
+    // set perturbed values in the variable namespace
+    if (theFunctionEvaluator->setVariables() < 0) {
+        opserr << "ERROR FiniteDifferenceGradient -- error "
+                  "setting variables in namespace"
+               << endln;
+        return -1;
+    }
+
+    // run analysis
+    if (theFunctionEvaluator->runAnalysis() < 0) {
+        opserr << "ERROR FiniteDifferenceGradient -- error "
+                  "running analysis"
+               << endln;
+        return -1;
+    }
+
+    // evaluate LSF and obtain result
+    theFunctionEvaluator->setExpression(lsfExpression);
+
+    // perturbed lsf
+    gPerturbed = theFunctionEvaluator->evaluateExpression();
+
+    return 0;
+}
+
+int FiniteDifferenceGradient::evaluateInWorkers(const char *lsfExpression,
+                                                const Vector &h,
+                                                Vector &gPerturbed,
+                                                ID &evaluated) {
+#ifdef _GRADIENT_WORKERS
+    //
+    // Each worker is a forked copy of this process, with its own copy of
+    // the domain & interpreter, that evaluates every numProcs'th of the
+    // pending perturbations and returns (rv index, status, g) through a
+    // pipe. Perturbations not returned are left for the serial loop.
+    //
+
+    int nrv = h.Size();
+    ID pending(nrv);
+    int numPending = 0;
+    for (int i = 0; i < nrv; i++)
+        if (evaluated(i) == 0) pending(numPending++) = i;
+
+    if (numWorkers < 2 || numPending < 2) return 0;
+
+    int numProcs = (numWorkers < numPending) ? numWorkers : numPending;
+    double record[3];
+    std::vector<int> readEnds;
+    std::vector<pid_t> pids;
+
+    opserr.flush();
+    fflush(stdout);
+    fflush(stderr);
+
+    for (int w = 0; w < numProcs; w++) {
+        int fd[2];
+        if (pipe(fd) != 0) break;
+
+        pid_t pid = fork();
+        if (pid == 0) {
+            close(fd[0]);
+            for (unsigned int k = 0; k < readEnds.size(); k++)
+                close(readEnds[k]);
+
+            for (int k = w; k < numPending; k += numProcs) {
+                int i = pending(k);
+                int param_indx = theReliabilityDomain
+                    ->getParameterIndexFromRandomVariableIndex(i);
+                Parameter *theParam =
+                    theOpenSeesDomain->getParameterFromIndex(param_indx);
+                double original = theParam->getValue();
+                theParam->update(original + h(i));
+
+                double g = 0.0;
+                int res = this->evaluatePerturbed(lsfExpression, g);
+                theParam->update(original);
+
+                record[0] = i;
+                record[1] = (res < 0) ? -1.0 : 1.0;
+                record[2] = g;
+                if (!writeGradientRecord(fd[1], record, 3 * sizeof(double)))
+                    break;
+            }
+
+            close(fd[1]);
+            opserr.flush();
+            fflush(stdout);
+            _exit(0);
+        }
+
+        close(fd[1]);
+        if (pid < 0) {
+            close(fd[0]);
+            break;
+        }
+        readEnds.push_back(fd[0]);
+        pids.push_back(pid);
+    }
+
+    for (unsigned int w = 0; w < readEnds.size(); w++) {
+        while (readGradientRecord(readEnds[w], record, 3 * sizeof(double))) {
+            int i = (int)record[0];
+            if (i < 0 || i >= nrv || record[1] < 0.0) continue;
+            gPerturbed(i) = record[2];
+            evaluated(i) = 1;
+            theFunctionEvaluator->incrementEvaluations();
+        }
+        close(readEnds[w]);
+        waitpid(pids[w], 0, 0);
+    }
+#endif
+
+    return 0;
+}
+
 int FiniteDifferenceGradient::computeGradient(double g) {
     // note FiniteDifferentGradient presumes that the expression has
     // already been evaluated once with
@@ -77,8 +257,18 @@ int FiniteDifferenceGradient::computeGradient(double g) {
     // get RVs created in the reliability domain
     int nrv = this->theReliabilityDomain->getNumberOfRandomVariables();
 
-    // now loop through to create gradient vector
-    // for all RVs
+    Vector h(nrv);
+    Vector gPerturbed(nrv);
+    ID evaluated(nrv);
+    std::vector<std::vector<double> > keys(nrv);
+
+    // g values of another expression are of no use
+    if (useCache && cacheExpression != lsfExpression) {
+        gCache.clear();
+        cacheExpression = lsfExpression;
+    }
+
+    // collect perturbations and look up the points already evaluated
     for (int i = 0; i < nrv; i++) {
         // get RV
         auto *theRV =
@@ -103,37 +293,51 @@ int FiniteDifferenceGradient::computeGradient(double g) {
         }
 
         // use parameter defined perturbation
-        double h = theParam->getPerturbation();
-        double original = theParam->getValue();
-        theParam->update(original + h);
-
-        // set perturbed values in the variable namespace
-        if (theFunctionEvaluator->setVariables() < 0) {
-            opserr << "ERROR FiniteDifferenceGradient -- error "
-                      "setting variables in namespace"
-                   << endln;
-            theParam->update(original);
-            return -1;
-        }
+        h(i) = theParam->getPerturbation();
 
-        // run analysis
-        if (theFunctionEvaluator->runAnalysis() < 0) {
-            opserr << "ERROR FiniteDifferenceGradient -- error "
-                      "running analysis"
-                   << endln;
-            theParam->update(original);
-            return -1;
+        if (useCache) {
+            this->getPointKey(i, h(i), keys[i]);
+            std::map<std::vector<double>, double>::const_iterator it =
+                gCache.find(keys[i]);
+            if (it != gCache.end()) {
+                gPerturbed(i) = it->second;
+                evaluated(i) = 1;
+            }
         }
+    }
+
+    // the perturbed analyses are independent; farm them out first
+    if (this->evaluateInWorkers(lsfExpression, h, gPerturbed, evaluated) < 0)
+        return -1;
+
+    // now loop through the remaining perturbations serially
+    for (int i = 0; i < nrv; i++) {
+        if (evaluated(i) != 0) continue;
+
+        int param_indx =
+            theReliabilityDomain->getParameterIndexFromRandomVariableIndex(
+                i);
+        auto *theParam =
+            theOpenSeesDomain->getParameterFromIndex(param_indx);
 
-        // evaluate LSF and obtain result
-        theFunctionEvaluator->setExpression(lsfExpression);
+        double original = theParam->getValue();
+        theParam->update(original + h(i));
 
-        // perturbed lsf
-        double g_perturbed = theFunctionEvaluator->evaluateExpression();
-        (*grad_g)(i) = (g_perturbed - g) / h;
+        int res = this->evaluatePerturbed(lsfExpression, gPerturbed(i));
 
         // return parameter values to previous state
         theParam->update(original);
+
+        if (res < 0) return -1;
+        evaluated(i) = 1;
+    }
+
+    if (useCache && gCache.size() + nrv > FD_GRADIENT_MAX_CACHE)
+        gCache.clear();
+
+    for (int i = 0; i < nrv; i++) {
+        if (useCache) gCache[keys[i]] = gPerturbed(i);
+        (*grad_g)(i) = (gPerturbed(i) - g) / h(i);
     }
 
     return 0;
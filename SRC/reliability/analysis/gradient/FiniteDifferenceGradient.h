@@ -40,6 +40,10 @@
 #include <ReliabilityDomain.h>
 #include <Domain.h>
 #include <FunctionEvaluator.h>
+#include <ID.h>
+#include <map>
+#include <vector>
+#include <string>
 
 class FiniteDifferenceGradient : public GradientEvaluator
 {
@@ -47,7 +51,9 @@ class FiniteDifferenceGradient : public GradientEvaluator
 public:
 	FiniteDifferenceGradient(FunctionEvaluator *passedGFunEvaluator,
 				 ReliabilityDomain *passedReliabilityDomain,
-				 Domain *passedOpenSeesDomain);
+				 Domain *passedOpenSeesDomain,
+				 int numWorkers = 1,
+				 bool useCache = false);
 	~FiniteDifferenceGradient();
 	
 	int		computeGradient(double gFunValue);
@@ -56,8 +62,23 @@ public:
 protected:
 	
 private:
+	int evaluatePerturbed(const char *lsfExpression, double &gPerturbed);
+	int evaluateInWorkers(const char *lsfExpression, const Vector &h,
+			      Vector &gPerturbed, ID &evaluated);
+	void getPointKey(int rvIndex, double h, std::vector<double> &key);
+
 	Domain *theOpenSeesDomain;
 	Vector *grad_g;
+
+	// perturbed runs are forked to numWorkers processes; with useCache
+	// the g values of the perturbed points are memoized by (lsf tag,
+	// parameter values) so that revisited points in the design point
+	// search are not re-analyzed; the memo is cleared when the limit-state
+	// expression changes
+	int numWorkers;
+	bool useCache;
+	std::string cacheExpression;
+	std::map<std::vector<double>, double> gCache;
 	
 };
 
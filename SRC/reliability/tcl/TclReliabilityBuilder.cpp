@@ -3104,46 +3104,47 @@ TclReliabilityModelBuilder_addGradientEvaluator(ClientData clientData, Tcl_Inter
 			return TCL_ERROR;
 		}
 
-		// Possibly read perturbation factor
-		if (argc>2) {
-			int numExtras;
-			if (argc==3 || argc==4) {
-				numExtras = 1;
-			}
-			else if (argc==5) {
-				numExtras = 2;
-			}
-			else {
-				opserr << "ERROR: Wrong number of arguments to FiniteDifferenceGradient. " << endln;
-				return TCL_ERROR;
-			}
+		int numWorkers = 1;
+		bool useCache = false;
 
-			int counter = 2;
+		// Possibly read perturbation factor and number of workers
+		int counter = 2;
+		while (counter < argc) {
 
-			for (int i=1; i<=numExtras; i++) {
+			if (strcmp(argv[counter],"-pert") == 0 && counter+1 < argc) {
+				counter ++;
 
-				if (strcmp(argv[counter],"-pert") == 0) {
-					counter ++;
-
-					if (Tcl_GetDouble(interp, argv[counter], &perturbationFactor) != TCL_OK) {
-						opserr << "ERROR: invalid input: perturbationFactor \n";
-						return TCL_ERROR;
-					}
-					counter++;
-				}
-				else if (strcmp(argv[counter],"-check") == 0) {
-					counter++;
-					doGradientCheck = true;
+				if (Tcl_GetDouble(interp, argv[counter], &perturbationFactor) != TCL_OK) {
+					opserr << "ERROR: invalid input: perturbationFactor \n";
+					return TCL_ERROR;
 				}
-				else {
-					opserr << "ERROR: Error in input to FiniteDifferenceGradient. " << endln;
+				counter++;
+			}
+			else if (strcmp(argv[counter],"-numWorkers") == 0 && counter+1 < argc) {
+				counter ++;
+
+				if (Tcl_GetInt(interp, argv[counter], &numWorkers) != TCL_OK || numWorkers < 1) {
+					opserr << "ERROR: invalid input: numWorkers \n";
 					return TCL_ERROR;
 				}
+				counter++;
+			}
+			else if (strcmp(argv[counter],"-cache") == 0) {
+				counter++;
+				useCache = true;
+			}
+			else if (strcmp(argv[counter],"-check") == 0) {
+				counter++;
+				doGradientCheck = true;
+			}
+			else {
+				opserr << "ERROR: Error in input to FiniteDifferenceGradient. " << endln;
+				return TCL_ERROR;
 			}
 		}
 
 		theGradientEvaluator = new FiniteDifferenceGradient(theFunctionEvaluator, theReliabilityDomain, 
-								    theStructuralDomain);
+								    theStructuralDomain, numWorkers, useCache);
 	}
 
 	else if (strcmp(argv[1],"OpenSees") == 0 || strcmp(argv[1],"Implicit") == 0) {
@@ -4158,8 +4159,10 @@ TclReliabilityModelBuilder_runImportanceSamplingAnalysis(ClientData clientData,
 	//     -print 1   (print to screen)
 	//     -print 2   (print to restart file)
 	//
+	//     -numWorkers 1  ....................... this is the default
+	//
 
-	if (argc!=2 && argc!=4 && argc!=6 && argc!=8 && argc!=10 && argc!=12) {
+	if (argc!=2 && argc!=4 && argc!=6 && argc!=8 && argc!=10 && argc!=12 && argc!=14) {
 		opserr << "ERROR: Wrong number of arguments to Sampling analysis" << endln;
 		return TCL_ERROR;
 	}
@@ -4171,6 +4174,7 @@ TclReliabilityModelBuilder_runImportanceSamplingAnalysis(ClientData clientData,
 	double samplingVariance	= 1.0;
 	int printFlag			= 0;
 	int analysisTypeTag		= 1;
+	int numWorkers			= 1;
 
 
 	for (int i=2; i<argc; i=i+2) {
@@ -4240,6 +4244,13 @@ TclReliabilityModelBuilder_runImportanceSamplingAnalysis(ClientData clientData,
 				return TCL_ERROR;
 			}
 		}
+		else if (strcmp(argv[i],"-numWorkers") == 0) {
+			// GET INPUT PARAMETER (integer)
+			if (Tcl_GetInt(interp, argv[i+1], &numWorkers) != TCL_OK || numWorkers < 1) {
+				opserr << "ERROR: invalid input: numWorkers \n";
+				return TCL_ERROR;
+			}
+		}
 		else {
 			opserr << "ERROR: invalid input to sampling analysis. " << endln;
 			return TCL_ERROR;
@@ -4263,7 +4274,8 @@ TclReliabilityModelBuilder_runImportanceSamplingAnalysis(ClientData clientData,
 							 numberOfSimulations, targetCOV, samplingVariance,
 							 printFlag,
 							 argv[1],
-							 analysisTypeTag);
+							 analysisTypeTag,
+							 numWorkers);
 
 	if (theImportanceSamplingAnalysis == 0) {
 		opserr << "ERROR: could not create theImportanceSamplingAnalysis \n";
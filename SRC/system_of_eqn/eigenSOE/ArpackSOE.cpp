@@ -27,6 +27,7 @@
 //
 // Description: This file contains the class definition for ArpackSOE
 
+#include <algorithm>
 #include <ArpackSOE.h>
 #include <ArpackSolver.h>
 #include <Matrix.h>
@@ -40,11 +41,10 @@
 #include <AnalysisModel.h>
 #include <LinearSOE.h>
 
-
-
 ArpackSOE::ArpackSOE(double s)
 :EigenSOE(EigenSOE_TAGS_ArpackSOE),
- M(0), Msize(0), mDiagonal(false), shift(s), theModel(0), theSOE(0),
+ M(0), Msize(0), mDiagonal(false), shift(s), 
+ mSparseFormed(false), theModel(0), theSOE(0),
  processID(-1), numChannels(0), theChannels(0), localCol(0), sizeLocal(0)
 {
   ArpackSolver *theSolvr = new ArpackSolver();
@@ -190,6 +190,14 @@ ArpackSOE::addA(const Matrix &m, const ID &id, double fact)
   // check for a quick return 
   if (fact == 0.0)  return 0;
 
+  // keep the contribution for the comparison with the last solve
+  int idSize = id.Size();
+  for (int i=0; i<idSize; i++) {
+    contributions.push_back(id(i));
+    for (int j=0; j<idSize; j++)
+      contributions.push_back(m(i,j)*fact);
+  }
+
   return theSOE->addA(m, id, fact);
 }
 
@@ -201,6 +209,9 @@ ArpackSOE::zeroA(void)
     opserr << "ArpackSOE::zeroA() - no SOE set\n";
     return;
   }
+  contributions.clear();
+  contributions.push_back(shift);
+
   return theSOE->zeroA();
 }
 
@@ -217,9 +228,8 @@ ArpackSOE::addM(const Matrix &m, const ID &id, double fact)
   if (res < 0)
     return res;
 
-  if (mDiagonal == false)
-    return  res;
-
+  // the shifted A above only sees -shift*M; keep M itself so that a zero
+  // shift still distinguishes between different mass matrices
   int idSize = id.Size();
   for (int i=0; i<idSize; i++) {
     int locI = id(i);
@@ -227,14 +237,17 @@ ArpackSOE::addM(const Matrix &m, const ID &id, double fact)
       for (int j=0; j<idSize; j++) {
 	int locJ = id(j);
 	if (locJ >= 0 && locJ < Msize) {
-	  if (locI == locJ) {
-	    M[locI] += m(i,i);
-	  } else {
-	    if (m(i,j) != 0.0) {
-	      mDiagonal = false;
-	      return res;
-	    }
-	  }
+	  double value = m(i,j);
+	  if (value == 0.0)
+	    continue;
+	  contributions.push_back(value);
+	  mTripletRow.push_back(locI);
+	  mTripletCol.push_back(locJ);
+	  mTripletVal.push_back(value);
+	  if (locI == locJ) 
+	    M[locI] += value;
+	  else
+	    mDiagonal = false;
 	}
       }
     }
@@ -255,6 +268,64 @@ ArpackSOE::zeroM(void)
 
   for (int i=0; i<Msize; i++)
     M[i] = 0;
+
+  mTripletRow.clear();
+  mTripletCol.clear();
+  mTripletVal.clear();
+  mSparseFormed = false;
+}
+
+
+int
+ArpackSOE::formSparseM(void)
+{
+  if (mSparseFormed == true)
+    return 0;
+
+  mRowStart.assign(Msize+1, 0);
+  mColIndex.clear();
+  mValues.clear();
+
+  if (mDiagonal == false) {
+
+    // sort the triplets by row then column & merge duplicate entries
+    int numTriplets = mTripletRow.size();
+    std::vector<int> order(numTriplets);
+    for (int i=0; i<numTriplets; i++)
+      order[i] = i;
+    std::sort(order.begin(), order.end(), [this](int a, int b) {
+	if (mTripletRow[a] != mTripletRow[b])
+	  return mTripletRow[a] < mTripletRow[b];
+	return mTripletCol[a] < mTripletCol[b];
+      });
+
+    int lastRow = -1;
+    int lastCol = -1;
+    for (int k=0; k<numTriplets; k++) {
+      int t = order[k];
+      int row = mTripletRow[t];
+      int col = mTripletCol[t];
+      if (row == lastRow && col == lastCol) {
+	mValues.back() += mTripletVal[t];
+      } else {
+	mColIndex.push_back(col);
+	mValues.push_back(mTripletVal[t]);
+	mRowStart[row+1]++;
+	lastRow = row;
+	lastCol = col;
+      }
+    }
+    for (int i=0; i<Msize; i++)
+      mRowStart[i+1] += mRowStart[i];
+  }
+
+  // triplets no longer needed
+  std::vector<int>().swap(mTripletRow);
+  std::vector<int>().swap(mTripletCol);
+  std::vector<double>().swap(mTripletVal);
+
+  mSparseFormed = true;
+  return 0;
 }
 
 
@@ -265,6 +336,17 @@ ArpackSOE::getShift(void)
 }
 
 
+int
+ArpackSOE::setSubspaceTracking(int numIter, double tol)
+{
+  ArpackSolver *theSolvr = (ArpackSolver *)this->getSolver();
+  if (theSolvr == 0)
+    return -1;
+
+  return theSolvr->setSubspaceTracking(numIter, tol);
+}
+
+
 int 
 ArpackSOE::sendSelf(int commitTag, Channel &theChannel)
 {
@@ -33,6 +33,7 @@
 
 #include "eigenSOE/EigenSOE.h"
 #include <Vector.h>
+#include <vector>
 
 class AnalysisModel;
 class ArpackSolver;
@@ -58,6 +59,7 @@ class ArpackSOE : public EigenSOE
     void zeroM(void);
 
     double getShift(void);
+    int setSubspaceTracking(int numIter, double tol = 1.0e-6);
     
     int sendSelf(int commitTag, Channel &theChannel);
     int recvSelf(int commitTag, Channel &theChannel, FEM_ObjectBroker &theBroker);
@@ -67,12 +69,26 @@ class ArpackSOE : public EigenSOE
 	int checkSameInt(int);
 
   protected:
+    int formSparseM(void);
     
   private:
     double *M;
     int Msize;
     bool mDiagonal;
     double shift;
+
+    // M in compressed row form for the non-diagonal case; the (row,col,val)
+    // triplets are collected in addM() and compressed before the solve
+    std::vector<int> mTripletRow, mTripletCol;
+    std::vector<double> mTripletVal;
+    std::vector<int> mRowStart, mColIndex;
+    std::vector<double> mValues;
+    bool mSparseFormed;
+
+    // the A & M contributions since the last zeroA(), in the order they
+    // were added; compared by the solver with those of its last solve to
+    // decide if the previous eigenpairs are still valid
+    std::vector<double> contributions;
     AnalysisModel *theModel;
     LinearSOE *theSOE;
 
@@ -60,6 +60,7 @@
 
 #include <fstream>
 #include <iostream>
+#include <vector>
 using namespace std;
 
 static double *workArea = 0;
@@ -69,7 +70,9 @@ ArpackSolver::ArpackSolver()
 :EigenSolver(EigenSOLVER_TAGS_ArpackSolver),
  theSOE(0), numModesMax(0), numMode(0), size(0),
  eigenvalues(0), eigenvectors(0), 
- v(0), workl(0), workd(0), resid(0), select(0)
+ v(0), workl(0), workd(0), resid(0), select(0), sizeAllocated(0),
+ solutionValid(false), solutionFindSmallest(true),
+ vectorsValid(false), numSubspaceIter(0), subspaceTol(1.0e-6)
 {
   // do nothing here.    
 }
@@ -129,6 +132,16 @@ extern "C" int dseupd_(bool *rvec, char *howmny, logical *select, double *d, dou
 		       double *workl, int *lworkl, int *info);
 #endif
 
+#ifdef _WIN32
+extern "C" int DSYGV(int *itype, char *jobz, char *uplo, int *n,
+		     double *A, int *lda, double *B, int *ldb,
+		     double *w, double *work, int *lwork, int *info);
+#else
+extern "C" int dsygv_(int *itype, char *jobz, char *uplo, int *n,
+		      double *A, int *lda, double *B, int *ldb,
+		      double *w, double *work, int *lwork, int *info);
+#endif
+
 
 
 
@@ -157,10 +170,56 @@ ArpackSolver::solve(int numModes, bool generalized, bool findSmallest)
   int lworkl = ncv*ncv + 8*ncv;
 
   int processID = theArpackSOE->processID;
+
+  //
+  // if neither K nor M changed since the last solve, the eigenpairs
+  // obtained then are still valid & the factorization of (K - shift*M)
+  // and the Lanczos iterations can be skipped altogether
+  //
+
+  int reuse = 0;
+  if (solutionValid == true && eigenvalues != 0 &&
+      numModes <= numMode && n == sizeAllocated &&
+      findSmallest == solutionFindSmallest &&
+      theArpackSOE->contributions == solutionContributions)
+    reuse = 1;
+
+  if (theArpackSOE->checkSameInt(reuse) == 1 && reuse == 1)
+    return 0;
+
+  solutionValid = false;
+
+  // form the compressed M used by myMv()
+  theArpackSOE->formSparseM();
+
+  //
+  // if tracking, try to update the previous eigenpairs with a few subspace
+  // iterations on the new K before falling back on a full ARPACK solve
+  //
+
+  std::vector<double> startVector;
+  if (numSubspaceIter > 0 && processID == -1 && findSmallest == true &&
+      vectorsValid == true && eigenvectors != 0 && n == sizeAllocated) {
+
+    if (numModes <= numMode && this->subspaceUpdate(numModes) == 0) {
+      numMode = numModes;
+      solutionValid = true;
+      solutionContributions = theArpackSOE->contributions;
+      solutionFindSmallest = findSmallest;
+      return 0;
+    }
+
+    // otherwise start the Lanczos process from the previous eigenvectors
+    startVector.assign(n, 0.0);
+    for (int j=0; j<numMode; j++)
+      for (int i=0; i<n; i++)
+	startVector[i] += eigenvectors[j*n+i];
+  }
+  vectorsValid = false;
   
-  // set up the space for ARPACK functions.
-  // this is done each time method is called!! .. this needs to be cleaned up
-  if (numModes > numModesMax) {
+  // set up the space for ARPACK functions; only done if the
+  // number of modes or the size of the system has grown
+  if (numModes > numModesMax || n != sizeAllocated) {
     
     if (v != 0) delete [] v;
     if (workl != 0) delete [] workl;
@@ -187,6 +246,7 @@ ArpackSolver::solve(int numModes, bool generalized, bool findSmallest)
       v[i] = 0;
     
     numModesMax = numModes;
+    sizeAllocated = n;
   }
 
   char which[3];
@@ -203,6 +263,10 @@ ArpackSolver::solve(int numModes, bool generalized, bool findSmallest)
   // some more variables
   double tol = 0.0;
   int info = 0;
+  if (startVector.empty() == false) {
+    memcpy(resid, &startVector[0], n*sizeof(double));
+    info = 1;
+  }
   int maxitr = 1000;
   int mode = 3;
   
@@ -349,6 +413,9 @@ ArpackSolver::solve(int numModes, bool generalized, bool findSmallest)
     if (eigenvectors != 0)
       delete [] eigenvectors;
     eigenvectors = 0;
+
+    // force the workspace to be reallocated on the next solve
+    sizeAllocated = 0;
     
     return info;
   } else {
@@ -438,6 +505,11 @@ ArpackSolver::solve(int numModes, bool generalized, bool findSmallest)
   
   numMode = numModes;
 
+  solutionValid = true;
+  solutionContributions = theArpackSOE->contributions;
+  solutionFindSmallest = findSmallest;
+  vectorsValid = true;
+
   /*
   ofstream outfile;
   outfile.open("eigenvectors.dat", ios::out);
@@ -469,6 +541,113 @@ ArpackSolver::solve(int numModes, bool generalized, bool findSmallest)
 }
 
 
+int
+ArpackSolver::subspaceUpdate(int numModes)
+{
+  // subspace iteration (Bathe) started from the numMode eigenvectors of
+  // the last solve; with Y = M*X & (K - shift*M)*Z = Y the projections are
+  // Kr = Z'*Y & Mr = Z'*M*Z, and the Ritz vectors X = Z*phi are M-orthonormal
+
+  int n = size;
+  int q = numMode;
+  if (q < 1 || q < numModes)
+    return -1;
+
+  std::vector<double> X(eigenvectors, eigenvectors + n*q);
+  std::vector<double> Y(n*q), Z(n*q);
+  std::vector<double> Kr(q*q), Mr(q*q), mu(q), lambdaOld(q);
+  int lwork = 3*q*q + 16;
+  std::vector<double> work(lwork);
+
+  for (int j=0; j<q; j++)
+    lambdaOld[j] = eigenvalues[j];
+
+  for (int iter=0; iter<numSubspaceIter; iter++) {
+
+    // Z = inv(K - shift*M) * M * X, one factorization for all q vectors
+    for (int j=0; j<q; j++) {
+      double *y = &Y[j*n];
+      myMv(n, &X[j*n], y);
+      theVector.setData(y, n);
+      theSOE->setB(theVector);
+      if (theSOE->solve() < 0)
+	return -1;
+      const Vector &x = theSOE->getX();
+      for (int i=0; i<n; i++)
+	Z[j*n+i] = x(i);
+    }
+
+    // project; X is reused to hold M*Z
+    for (int j=0; j<q; j++)
+      myMv(n, &Z[j*n], &X[j*n]);
+
+    for (int j=0; j<q; j++) {
+      for (int k=0; k<=j; k++) {
+	double kjk = 0.0;
+	double mjk = 0.0;
+	const double *zk = &Z[k*n];
+	const double *yj = &Y[j*n];
+	const double *wj = &X[j*n];
+	for (int i=0; i<n; i++) {
+	  kjk += zk[i]*yj[i];
+	  mjk += zk[i]*wj[i];
+	}
+	Kr[j*q+k] = Kr[k*q+j] = kjk;
+	Mr[j*q+k] = Mr[k*q+j] = mjk;
+      }
+    }
+
+    // reduced generalized problem Kr*phi = mu*Mr*phi
+    int itype = 1;
+    char jobz = 'V';
+    char uplo = 'U';
+    int info = 0;
+#ifdef _WIN32
+    DSYGV(&itype, &jobz, &uplo, &q, &Kr[0], &q, &Mr[0], &q, &mu[0],
+	  &work[0], &lwork, &info);
+#else
+    dsygv_(&itype, &jobz, &uplo, &q, &Kr[0], &q, &Mr[0], &q, &mu[0],
+	   &work[0], &lwork, &info);
+#endif
+    if (info != 0)
+      return -1;
+
+    // Ritz vectors X = Z*phi
+    for (int j=0; j<q; j++) {
+      double *xj = &X[j*n];
+      for (int i=0; i<n; i++)
+	xj[i] = 0.0;
+      for (int k=0; k<q; k++) {
+	double phikj = Kr[j*q+k];
+	const double *zk = &Z[k*n];
+	for (int i=0; i<n; i++)
+	  xj[i] += phikj*zk[i];
+      }
+    }
+
+    // converged when the requested eigenvalues stop changing; the first
+    // iteration is only compared against the previous tangent, so skip it
+    bool converged = (iter > 0);
+    for (int j=0; j<numModes; j++) {
+      double lambda = mu[j] + shift;
+      if (fabs(lambda - lambdaOld[j]) > subspaceTol*fabs(lambda))
+	converged = false;
+      lambdaOld[j] = lambda;
+    }
+
+    if (converged == true) {
+      for (int j=0; j<numModes; j++)
+	eigenvalues[j] = lambdaOld[j];
+      for (int i=0; i<n*numModes; i++)
+	eigenvectors[i] = X[i];
+      return 0;
+    }
+  }
+
+  return -1;
+}
+
+
 int 
 ArpackSolver::getNCV(int n, int nev)
 {
@@ -518,24 +697,27 @@ ArpackSolver::myMv(int n, double *v, double *result)
 
   } else {
 
-    y.Zero();
+    //
+    // product with the compressed M assembled in ArpackSOE::addM(); rows
+    // are independent so the loop is split over the available threads
+    //
 
-    AnalysisModel *theAnalysisModel = theArpackSOE->theModel;
-    
-    // loop over the FE_Elements
-    FE_Element *elePtr;
-    FE_EleIter &theEles = theAnalysisModel->getFEs();    
-    while((elePtr = theEles()) != 0) {
-      const Vector &b = elePtr->getM_Force(x, 1.0);
-      y.Assemble(b, elePtr->getID(), 1.0);
+    int Msize = theArpackSOE->Msize;
+    if (n > Msize) {
+      opserr << "ArpackSolver::myMv() n > Msize!\n";
+      return;
     }
 
-    // loop over the DOF_Groups
-    DOF_Group *dofPtr;
-    DOF_GrpIter &theDofs = theAnalysisModel->getDOFs();
-    while ((dofPtr = theDofs()) != 0) {
-      const Vector &a = dofPtr->getM_Force(x,1.0);      
-      y.Assemble(a, dofPtr->getID(), 1.0);
+    const int *rowStart = &(theArpackSOE->mRowStart[0]);
+    const int *colIndex = theArpackSOE->mColIndex.empty() ? 0 : &(theArpackSOE->mColIndex[0]);
+    const double *values = theArpackSOE->mValues.empty() ? 0 : &(theArpackSOE->mValues[0]);
+
+#pragma omp parallel for
+    for (int i=0; i<n; i++) {
+      double sum = 0.0;
+      for (int k=rowStart[i]; k<rowStart[i+1]; k++)
+	sum += values[k]*v[colIndex[k]];
+      result[i] = sum;
     }
   }
 
@@ -565,9 +747,17 @@ ArpackSolver::myMv(int n, double *v, double *result)
 void
 ArpackSolver::myCopy(int n, double *v, double *result)
 {
-  for (int i=0; i<n; i++) {
-    result[i] = v[i];
-  }
+  memcpy(result, v, n*sizeof(double));
+}
+
+
+int
+ArpackSolver::setSubspaceTracking(int numIter, double tol)
+{
+  numSubspaceIter = numIter;
+  if (tol > 0.0)
+    subspaceTol = tol;
+  return 0;
 }
 
 
@@ -619,6 +809,8 @@ int
 ArpackSolver::setSize()
 {
   size = theArpackSOE->Msize;
+  solutionValid = false;
+  vectorsValid = false;
 
   if (sizeWork < size)
     if (workArea != 0)
@@ -63,6 +63,8 @@ class ArpackSolver : public EigenSolver
     
     const Vector &getEigenvector(int mode);
     double getEigenvalue(int mode);
+
+    int setSubspaceTracking(int numIter, double tol = 1.0e-6);
     
     int sendSelf(int commitTag, Channel &theChannel);
     int recvSelf(int commitTag, Channel &theChannel, 
@@ -90,10 +92,24 @@ class ArpackSolver : public EigenSolver
     int ipntr[11];
   //	long int* select;
   int* select;
+    int sizeAllocated;
+
+    // eigenpairs of the last solve are reused if the SOE contributions,
+    // size & search direction have not changed since
+    bool solutionValid;
+    std::vector<double> solutionContributions;
+    bool solutionFindSmallest;
+
+    // eigenvector tracking: the eigenvectors of the last solve are used as
+    // the start subspace for a few subspace iterations on the new K
+    bool vectorsValid;
+    int numSubspaceIter;
+    double subspaceTol;
     
     void myMv(int n, double *v, double *result);
     void myCopy(int n, double *v, double *result);
     int getNCV(int n, int nev);
+    int subspaceUpdate(int numModes);
 };
 
 #endif
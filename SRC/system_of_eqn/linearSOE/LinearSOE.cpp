@@ -32,6 +32,8 @@
 
 #include<LinearSOE.h>
 #include<LinearSOESolver.h>
+#include<Vector.h>
+#include<Matrix.h>
 
 LinearSOE::LinearSOE(LinearSOESolver &theLinearSOESolver, int classtag)
     :MovableObject(classtag), theModel(0), theSolver(&theLinearSOESolver)
@@ -61,6 +63,39 @@ LinearSOE::solve(void)
     return -1;
 }
 
+int
+LinearSOE::solveMultiple(Matrix &BX)
+{
+  if (theSolver == 0)
+    return -1;
+
+  // let the solver do all right-hand sides at once if it can
+  int res = theSolver->solveMultiple(BX);
+  if (res <= 0)
+    return res;
+
+  // otherwise one column at a time; the solvers only factor A on the first
+  int n = BX.noRows();
+  if (n != this->getNumEqn()) {
+    opserr << "LinearSOE::solveMultiple() - B has " << n << " rows, system has ";
+    opserr << this->getNumEqn() << " equations\n";
+    return -1;
+  }
+  if (n == 0)
+    return 0;
+
+  for (int j = 0; j < BX.noCols(); j++) {
+    Vector col(&BX(0,j), n);
+    this->setB(col);
+    res = this->solve();
+    if (res < 0)
+      return res;
+    col = this->getX();
+  }
+
+  return 0;
+}
+
 int
 LinearSOE::formAp(const Vector &p, Vector &Ap)
 {
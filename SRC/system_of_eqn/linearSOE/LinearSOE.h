@@ -56,6 +56,7 @@ class LinearSOE : public MovableObject
     virtual ~LinearSOE();
 
     virtual int solve(void);    
+    virtual int solveMultiple(Matrix &BX);
     virtual int setLinks(AnalysisModel &theModel);    
 
     // pure virtual functions
@@ -39,6 +39,7 @@
 
 #include <MovableObject.h>
 class LinearSOE;
+class Matrix;
 
 class LinearSOESolver : public MovableObject
 {
@@ -48,6 +49,10 @@ class LinearSOESolver : public MovableObject
 
     virtual int solve(void) = 0;
     virtual int setSize(void) = 0;
+
+    // solves A X = B for all the columns of BX in one call, overwriting
+    // them with the solutions; returns 1 if not provided by the solver
+    virtual int solveMultiple(Matrix &BX) {return 1;};
     virtual double getDeterminant(void) {return 1.0;};
     
   protected:
@@ -37,6 +37,7 @@
 
 #include <BandGenLinLapackSolver.h>
 #include <BandGenLinSOE.h>
+#include <Matrix.h>
 #include <math.h>
 
 void* OPS_BandGenLinLapack()
@@ -151,6 +152,75 @@ BandGenLinLapackSolver::solve(void)
     theSOE->factored = true;
     return 0;
 }
+
+int
+BandGenLinLapackSolver::solveMultiple(Matrix &BX)
+{
+    if (theSOE == 0) {
+	opserr << "WARNING BandGenLinLapackSolver::solveMultiple()- ";
+	opserr << " No LinearSOE object has been set\n";
+	return -1;
+    }
+
+    int n = theSOE->size;
+    if (BX.noRows() != n) {
+	opserr << "WARNING BandGenLinLapackSolver::solveMultiple()- ";
+	opserr << " B has " << BX.noRows() << " rows, system has " << n << endln;
+	return -1;
+    }
+
+    int nrhs = BX.noCols();
+    if (n == 0 || nrhs == 0)
+	return 0;
+
+    if (iPivSize < n) {
+	opserr << "WARNING BandGenLinLapackSolver::solveMultiple()- ";
+	opserr << " iPiv not large enough - has setSize() been called?\n";
+	return -1;
+    }
+
+    int kl = theSOE->numSubD;
+    int ku = theSOE->numSuperD;
+    int ldA = 2*kl + ku +1;
+    int ldB = n;
+    int info;
+    double *Aptr = theSOE->A;
+    double *Bptr = &BX(0,0);
+    char trans[] = "N";
+    int    *iPIV = iPiv;
+
+    // all right-hand sides are solved against the one factorization
+
+#ifdef _WIN32
+    {if (theSOE->factored == false)
+	DGBSV(&n,&kl,&ku,&nrhs,Aptr,&ldA,iPIV,Bptr,&ldB,&info);
+    else
+	DGBTRS(trans,&n,&kl,&ku,&nrhs,Aptr,&ldA,iPIV,Bptr,&ldB,&info);
+    }
+#else
+    {if (theSOE->factored == false)
+	dgbsv_(&n,&kl,&ku,&nrhs,Aptr,&ldA,iPIV,Bptr,&ldB,&info);
+    else
+	dgbtrs_(trans,&n,&kl,&ku,&nrhs,Aptr,&ldA,iPIV,Bptr,&ldB,&info);
+    }
+#endif
+
+    // check if successful
+    if (info != 0) {
+      if (info > 0) {
+	opserr << "WARNING BandGenLinLapackSolver::solveMultiple() -";
+	opserr << "factorization failed, matrix singular U(i,i) = 0, i= " << info-1 << endln;
+	return -info+1;
+      } else {
+	opserr << "WARNING BandGenLinLapackSolver::solveMultiple() - OpenSees code error\n";
+	return info;
+      }
+    }
+
+    theSOE->factored = true;
+    return 0;
+}
+
     
 
 
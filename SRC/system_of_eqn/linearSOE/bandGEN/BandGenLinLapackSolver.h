@@ -47,6 +47,7 @@ class BandGenLinLapackSolver : public BandGenLinSolver
     ~BandGenLinLapackSolver();
 
     int solve(void);
+    int solveMultiple(Matrix &BX);
     int setSize(void);
 
     int sendSelf(int commitTag, Channel &theChannel);
@@ -32,6 +32,7 @@
 
 #include <BandSPDLinLapackSolver.h>
 #include <BandSPDLinSOE.h>
+#include <Matrix.h>
 //#include <f2c.h>
 #include <math.h>
 
@@ -140,6 +141,66 @@ BandSPDLinLapackSolver::solve(void)
     theSOE->factored = true;
     return 0;
 }
+
+int
+BandSPDLinLapackSolver::solveMultiple(Matrix &BX)
+{
+    if (theSOE == 0) {
+	opserr << "WARNING BandSPDLinLapackSolver::solveMultiple()- ";
+	opserr << " No LinearSOE object has been set\n";
+	return -1;
+    }
+
+    int n = theSOE->size;
+    if (BX.noRows() != n) {
+	opserr << "WARNING BandSPDLinLapackSolver::solveMultiple()- ";
+	opserr << " B has " << BX.noRows() << " rows, system has " << n << endln;
+	return -1;
+    }
+
+    int nrhs = BX.noCols();
+    if (n == 0 || nrhs == 0)
+	return 0;
+
+    int kd = theSOE->half_band -1;
+    int ldA = kd +1;
+    int ldB = n;
+    int info;
+    double *Aptr = theSOE->A;
+    double *Bptr = &BX(0,0);
+    char uplo[] = "U";
+
+    // all right-hand sides are solved against the one factorization
+
+#ifdef _WIN32
+    if (theSOE->factored == false)
+	DPBSV(uplo, &n,&kd,&nrhs,Aptr,&ldA,Bptr,&ldB,&info);
+    else
+	DPBTRS(uplo, &n,&kd,&nrhs,Aptr,&ldA,Bptr,&ldB,&info);
+#else
+    { if (theSOE->factored == false)
+	dpbsv_(uplo,&n,&kd,&nrhs,Aptr,&ldA,Bptr,&ldB,&info);
+      else
+	dpbtrs_(uplo,&n,&kd,&nrhs,Aptr,&ldA,Bptr,&ldB,&info);
+    }
+#endif
+
+    // check if successful
+    if (info != 0) {
+      if (info > 0) {
+	opserr << "WARNING BandSPDLinLapackSolver::solveMultiple() -";
+	opserr << "factorization failed, matrix singular U(i,i) = 0, i= " << info-1 << endln;
+	return -info+1;
+      } else {
+	opserr << "WARNING BandSPDLinLapackSolver::solveMultiple() - OpenSees code error\n";
+	return info;
+      }
+    }
+
+    theSOE->factored = true;
+    return 0;
+}
+
     
 
 
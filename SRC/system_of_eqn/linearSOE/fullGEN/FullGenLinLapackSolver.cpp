@@ -34,6 +34,7 @@
 
 #include <FullGenLinLapackSolver.h>
 #include <FullGenLinSOE.h>
+#include <Matrix.h>
 #include <math.h>
 #include <Channel.h>
 #include <FEM_ObjectBroker.h>
@@ -143,6 +144,73 @@ FullGenLinLapackSolver::solve(void)
     return 0;
 }
 
+int
+FullGenLinLapackSolver::solveMultiple(Matrix &BX)
+{
+    if (theSOE == 0) {
+	opserr << "WARNING FullGenLinLapackSolver::solveMultiple()- ";
+	opserr << " No LinearSOE object has been set\n";
+	return -1;
+    }
+
+    int n = theSOE->size;
+    if (BX.noRows() != n) {
+	opserr << "WARNING FullGenLinLapackSolver::solveMultiple()- ";
+	opserr << " B has " << BX.noRows() << " rows, system has " << n << endln;
+	return -1;
+    }
+
+    int nrhs = BX.noCols();
+    if (n == 0 || nrhs == 0)
+	return 0;
+
+    if (sizeIpiv < n) {
+	opserr << "WARNING FullGenLinLapackSolver::solveMultiple()- ";
+	opserr << " iPiv not large enough - has setSize() been called?\n";
+	return -1;
+    }
+
+    int ldA = n;
+    int ldB = n;
+    int info;
+    double *Aptr = theSOE->A;
+    double *Bptr = &BX(0,0);
+    char trans[] = "N";
+    int *iPIV = iPiv;
+
+    // all right-hand sides are solved against the one factorization
+
+#ifdef _WIN32
+    {if (theSOE->factored == false)
+	DGESV(&n,&nrhs,Aptr,&ldA,iPIV,Bptr,&ldB,&info);
+     else
+	DGETRS(trans, &n,&nrhs,Aptr,&ldA,iPIV,Bptr,&ldB,&info);
+    }
+#else
+    {if (theSOE->factored == false)
+	dgesv_(&n,&nrhs,Aptr,&ldA,iPIV,Bptr,&ldB,&info);
+     else
+	dgetrs_(trans, &n,&nrhs,Aptr,&ldA,iPIV,Bptr,&ldB,&info);
+    }
+#endif
+
+    // check if successful
+    if (info != 0) {
+      if (info > 0) {
+	opserr << "WARNING FullGenLinLapackSolver::solveMultiple() -";
+	opserr << "factorization failed, matrix singular U(i,i) = 0, i= " << info-1 << endln;
+	return -info+1;
+      } else {
+	opserr << "WARNING FullGenLinLapackSolver::solveMultiple() - OpenSees code error\n";
+	return info;
+      }
+    }
+
+    theSOE->factored = true;
+    return 0;
+}
+
+
 
 int
 FullGenLinLapackSolver::setSize()
@@ -47,6 +47,7 @@ class FullGenLinLapackSolver : public FullGenLinSolver
     ~FullGenLinLapackSolver();
 
     int solve(void);
+    int solveMultiple(Matrix &BX);
     int setSize(void);
     
     int sendSelf(int commitTag, Channel &theChannel);
@@ -266,6 +266,8 @@ extern int OPS_sdfResponse(void);
 #include <StaticAnalysis.h>
 #include <DirectIntegrationAnalysis.h>
 #include <VariableTimeStepDirectIntegrationAnalysis.h>
+#include <PararealAnalysis.h>
+#include <ModalSuperpositionAnalysis.h>
 
 #include <PFEMAnalysis.h>
 
@@ -860,6 +862,8 @@ int OpenSeesAppInit(Tcl_Interp *interp) {
 		      (ClientData)NULL, (Tcl_CmdDeleteProc *)NULL);     
     Tcl_CreateCommand(interp, "getTime", &getTime,
 		      (ClientData)NULL, (Tcl_CmdDeleteProc *)NULL);
+    Tcl_CreateCommand(interp, "criticalTimeStep", &criticalTimeStep,
+		      (ClientData)NULL, (Tcl_CmdDeleteProc *)NULL);
     Tcl_CreateCommand(interp, "getLoadFactor", &getLoadFactor,
 		      (ClientData)NULL, (Tcl_CmdDeleteProc *)NULL);
 		
@@ -1041,6 +1045,8 @@ int OpenSeesAppInit(Tcl_Interp *interp) {
 
     Tcl_CreateCommand(interp, "getNumElements", &getNumElements,
 		      (ClientData)NULL, (Tcl_CmdDeleteProc *)NULL);
+    Tcl_CreateCommand(interp, "getNumAllocations", &getNumAllocations,
+		      (ClientData)NULL, (Tcl_CmdDeleteProc *)NULL);
     Tcl_CreateCommand(interp, "getEleClassTags", &getEleClassTags,
 		      (ClientData)NULL, (Tcl_CmdDeleteProc *)NULL);
     Tcl_CreateCommand(interp, "getEleLoadClassTags", &getEleLoadClassTags,
@@ -1335,6 +1341,22 @@ sensitivityAlgorithm(ClientData clientData, Tcl_Interp *interp, int argc, TCL_Ch
 	  opserr << "Unknown sensitivity algorithm option: " << argv[1] << endln;
 	  return TCL_ERROR;
 	}
+
+	// number of parameters whose sensitivities are solved together
+	int blockSize = 1;
+	for (int i = 2; i < argc; i++) {
+	  if (strcmp(argv[i],"-block") == 0 && i+1 < argc) {
+	    if (Tcl_GetInt(interp, argv[i+1], &blockSize) != TCL_OK || blockSize < 1) {
+	      opserr << "ERROR: invalid input: sensitivity block size " << argv[i+1] << endln;
+	      return TCL_ERROR;
+	    }
+	    i++;
+	  }
+	  else {
+	    opserr << "Unknown sensitivity algorithm option: " << argv[i] << endln;
+	    return TCL_ERROR;
+	  }
+	}
 	
 	ReliabilityDomain *theReliabilityDomain;
 	theReliabilityDomain = theReliabilityBuilder->getReliabilityDomain();
@@ -1373,6 +1395,7 @@ sensitivityAlgorithm(ClientData clientData, Tcl_Interp *interp, int argc, TCL_Ch
 	  opserr << "ERROR: Could not create theSensitivityAlgorithm. " << endln;
 	  return TCL_ERROR;
 	}	
+	theIntegrator->setSensitivityBlockSize(blockSize);
 	// ---- by Quan 2009 for recover the previous framework ---
 
 	if (theIntegrator->shouldComputeAtEachStep()) {
@@ -1690,6 +1713,36 @@ getTime(ClientData clientData, Tcl_Interp *interp, int argc, TCL_Char **argv)
   return TCL_OK;
 }
 
+int 
+criticalTimeStep(ClientData clientData, Tcl_Interp *interp, int argc, TCL_Char **argv)
+{
+  // criticalTimeStep <eleTag1 eleTag2 ...>
+  char buffer [40];
+  if (argc == 1) {
+    double dt = ExplicitDifference::getCriticalTimeStep(&theDomain);
+    sprintf(buffer,"%35.20f", dt);
+    Tcl_SetResult(interp, buffer, TCL_VOLATILE);
+    return TCL_OK;
+  }
+
+  ID eleTags(argc-1);
+  for (int i = 1; i < argc; i++) {
+    if (Tcl_GetInt(interp, argv[i], &eleTags(i-1)) != TCL_OK) {
+      opserr << "WARNING criticalTimeStep <eleTag1 eleTag2 ...> - invalid eleTag " << argv[i] << endln;
+      return TCL_ERROR;
+    }
+  }
+
+  Vector eleDt(argc-1);
+  ExplicitDifference::getCriticalTimeStep(&theDomain, &eleTags, &eleDt);
+  for (int i = 0; i < eleDt.Size(); i++) {
+    sprintf(buffer,"%35.20f ", eleDt(i));
+    Tcl_AppendResult(interp, buffer, NULL);
+  }
+
+  return TCL_OK;
+}
+
 int 
 getLoadFactor(ClientData clientData, Tcl_Interp *interp, int argc, TCL_Char **argv)
 {
@@ -2596,7 +2649,8 @@ specifyAnalysis(ClientData clientData, Tcl_Interp *interp, int argc,
 
         theTransientAnalysis = thePFEMAnalysis;
 
-    } else if (strcmp(argv[1],"Transient") == 0) {
+    } else if (strcmp(argv[1],"Transient") == 0 || strcmp(argv[1],"Parareal") == 0 ||
+	       strcmp(argv[1],"ModalSuperposition") == 0) {
 	// make sure all the components have been built,
 	// otherwise print a warning and use some defaults
 	if (theAnalysisModel == 0) 
@@ -2642,6 +2696,12 @@ specifyAnalysis(ClientData clientData, Tcl_Interp *interp, int argc,
 	int count = 2;
 	int numSubLevels = 0;
 	int numSubSteps = 10;
+	double adaptTol = 0.0, adaptDtMin = 0.0, adaptDtMax = 0.0, adaptAtol = 0.0;
+	int numWorkers = 1, numWindows = 0, coarseSteps = 1, maxIter = 10;
+	double pararealTol = 1.0e-6;
+	int numModes = 0;
+	double modalDamp = -1.0;
+	ID linkTags(0, 8), recordNodes(0, 8);
 	while (count < argc) {
 	  if (strcmp(argv[count],"-numSubLevels") == 0) {
 	    count++;
@@ -2655,10 +2715,90 @@ specifyAnalysis(ClientData clientData, Tcl_Interp *interp, int argc,
 	      if (Tcl_GetInt(interp, argv[count], &numSubSteps) != TCL_OK)
 		return TCL_ERROR;		     
 	  }
+	  else if ((strcmp(argv[count],"-adaptive") == 0) ) {
+	    count++;
+	    if (count < argc)
+	      if (Tcl_GetDouble(interp, argv[count], &adaptTol) != TCL_OK)
+		return TCL_ERROR;		     
+	  }
+	  else if ((strcmp(argv[count],"-dtMin") == 0) ) {
+	    count++;
+	    if (count < argc)
+	      if (Tcl_GetDouble(interp, argv[count], &adaptDtMin) != TCL_OK)
+		return TCL_ERROR;		     
+	  }
+	  else if ((strcmp(argv[count],"-dtMax") == 0) ) {
+	    count++;
+	    if (count < argc)
+	      if (Tcl_GetDouble(interp, argv[count], &adaptDtMax) != TCL_OK)
+		return TCL_ERROR;		     
+	  }
+	  else if ((strcmp(argv[count],"-atol") == 0) ) {
+	    count++;
+	    if (count < argc)
+	      if (Tcl_GetDouble(interp, argv[count], &adaptAtol) != TCL_OK)
+		return TCL_ERROR;		     
+	  }
+	  else if ((strcmp(argv[count],"-numWorkers") == 0) ) {
+	    count++;
+	    if (count < argc)
+	      if (Tcl_GetInt(interp, argv[count], &numWorkers) != TCL_OK)
+		return TCL_ERROR;		     
+	  }
+	  else if ((strcmp(argv[count],"-numWindows") == 0) ) {
+	    count++;
+	    if (count < argc)
+	      if (Tcl_GetInt(interp, argv[count], &numWindows) != TCL_OK)
+		return TCL_ERROR;		     
+	  }
+	  else if ((strcmp(argv[count],"-coarseSteps") == 0) ) {
+	    count++;
+	    if (count < argc)
+	      if (Tcl_GetInt(interp, argv[count], &coarseSteps) != TCL_OK)
+		return TCL_ERROR;		     
+	  }
+	  else if ((strcmp(argv[count],"-maxIter") == 0) ) {
+	    count++;
+	    if (count < argc)
+	      if (Tcl_GetInt(interp, argv[count], &maxIter) != TCL_OK)
+		return TCL_ERROR;		     
+	  }
+	  else if ((strcmp(argv[count],"-tol") == 0) ) {
+	    count++;
+	    if (count < argc)
+	      if (Tcl_GetDouble(interp, argv[count], &pararealTol) != TCL_OK)
+		return TCL_ERROR;		     
+	  }
+	  else if ((strcmp(argv[count],"-numModes") == 0) ) {
+	    count++;
+	    if (count < argc)
+	      if (Tcl_GetInt(interp, argv[count], &numModes) != TCL_OK)
+		return TCL_ERROR;		     
+	  }
+	  else if ((strcmp(argv[count],"-damp") == 0) ) {
+	    count++;
+	    if (count < argc)
+	      if (Tcl_GetDouble(interp, argv[count], &modalDamp) != TCL_OK)
+		return TCL_ERROR;		     
+	  }
+	  else if ((strcmp(argv[count],"-links") == 0) || (strcmp(argv[count],"-recordNodes") == 0)) {
+	    ID &tags = (strcmp(argv[count],"-links") == 0) ? linkTags : recordNodes;
+	    int tag;
+	    while (count+1 < argc && Tcl_GetInt(interp, argv[count+1], &tag) == TCL_OK) {
+	      tags[tags.Size()] = tag;
+	      count++;
+	    }
+	  }
 	  count++;
 	}
 
-	theTransientAnalysis = new DirectIntegrationAnalysis(theDomain,
+	DirectIntegrationAnalysis *theDirectAnalysis = 0;
+	if (strcmp(argv[1],"ModalSuperposition") == 0) {
+	  if (numModes < 1) {
+	    opserr << "WARNING analysis ModalSuperposition -numModes n <-damp zeta> <-links tags> <-recordNodes tags>\n";
+	    return TCL_ERROR;
+	  }
+	  theDirectAnalysis = new ModalSuperpositionAnalysis(theDomain,
 							     *theHandler,
 							     *theNumberer,
 							     *theAnalysisModel,
@@ -2666,9 +2806,39 @@ specifyAnalysis(ClientData clientData, Tcl_Interp *interp, int argc,
 							     *theSOE,
 							     *theTransientIntegrator,
 							     theTest,
-							     numSubLevels,
-							     numSubSteps);
-	  ;
+							     numModes,
+							     modalDamp,
+							     &linkTags,
+							     &recordNodes);
+	}
+	else if (strcmp(argv[1],"Parareal") == 0)
+	  theDirectAnalysis = new PararealAnalysis(theDomain,
+						   *theHandler,
+						   *theNumberer,
+						   *theAnalysisModel,
+						   *theAlgorithm,
+						   *theSOE,
+						   *theTransientIntegrator,
+						   theTest,
+						   numWorkers,
+						   numWindows,
+						   coarseSteps,
+						   maxIter,
+						   pararealTol);
+	else
+	  theDirectAnalysis = new DirectIntegrationAnalysis(theDomain,
+							    *theHandler,
+							    *theNumberer,
+							    *theAnalysisModel,
+							    *theAlgorithm,
+							    *theSOE,
+							    *theTransientIntegrator,
+							    theTest,
+							    numSubLevels,
+							    numSubSteps);
+	if (adaptTol > 0.0)
+	  theDirectAnalysis->setAdaptive(adaptTol, adaptDtMin, adaptDtMax, adaptAtol);
+	theTransientAnalysis = theDirectAnalysis;
 #ifdef _PARALLEL_INTERPRETERS
 	if (setMPIDSOEFlag) {
 	  ((MPIDiagonalSOE*) theSOE)->setAnalysisModel(*theAnalysisModel);
@@ -3847,6 +4017,7 @@ specifyAlgorithm(ClientData clientData, Tcl_Interp *interp, int argc,
     int incrementTangent = CURRENT_TANGENT;
     int iterateTangent = CURRENT_TANGENT;
     int maxDim = 3;
+    int maxKeep = 0;
     for (int i = 2; i < argc; i++) {
       if (strcmp(argv[i],"-iterate") == 0 && i+1 < argc) {
 	i++;
@@ -3870,6 +4041,10 @@ specifyAlgorithm(ClientData clientData, Tcl_Interp *interp, int argc,
 	i++;
 	maxDim = atoi(argv[i]);
       }
+      else if (strcmp(argv[i],"-reuse") == 0 && i+1 < argc) {
+	i++;
+	maxKeep = atoi(argv[i]);
+      }
     }
 
     if (theTest == 0) {
@@ -3878,7 +4053,7 @@ specifyAlgorithm(ClientData clientData, Tcl_Interp *interp, int argc,
     }
 
     Accelerator *theAccel;
-    theAccel = new KrylovAccelerator(maxDim, iterateTangent);
+    theAccel = new KrylovAccelerator(maxDim, iterateTangent, maxKeep);
 
     theNewAlgo = new AcceleratedNewton(*theTest, theAccel, incrementTangent);
   }
@@ -9030,6 +9205,19 @@ getNumElements(ClientData clientData, Tcl_Interp *interp, int argc, TCL_Char **a
   return TCL_OK;
 }
 
+// the numbers of Vector and Matrix data arrays allocated so far; these
+// are only counted in a build with -D_ALLOC_COUNT, otherwise 0
+int
+getNumAllocations(ClientData clientData, Tcl_Interp *interp, int argc, TCL_Char **argv)
+{
+  char buffer[60];
+
+  sprintf(buffer, "%ld %ld", Vector::getNumAllocations(), Matrix::getNumAllocations());
+  Tcl_SetResult(interp, buffer, TCL_VOLATILE);
+
+  return TCL_OK;
+}
+
 int
 getEleClassTags(ClientData clientData, Tcl_Interp *interp, int argc, TCL_Char **argv)
 {
@@ -10126,7 +10314,11 @@ numFact(ClientData clientData, Tcl_Interp *interp, int argc, TCL_Char **argv)
   if (theAlgorithm == 0)
     return TCL_ERROR;
 
-  sprintf(buffer, "%d", theAlgorithm->getNumFactorizations());
+  // numFact <-avoided>
+  if (argc > 1 && strcmp(argv[1], "-avoided") == 0)
+    sprintf(buffer, "%d", theAlgorithm->getNumFactorizationsAvoided());
+  else
+    sprintf(buffer, "%d", theAlgorithm->getNumFactorizations());
   Tcl_SetResult(interp, buffer, TCL_VOLATILE);
 
   return TCL_OK;
@@ -77,6 +77,9 @@ setTime(ClientData clientData, Tcl_Interp *interp, int argc, TCL_Char **argv);
 int 
 getTime(ClientData clientData, Tcl_Interp *interp, int argc, TCL_Char **argv);
 
+int 
+criticalTimeStep(ClientData clientData, Tcl_Interp *interp, int argc, TCL_Char **argv);
+
 int 
 getLoadFactor(ClientData clientData, Tcl_Interp *interp, int argc, TCL_Char **argv);
 
@@ -287,6 +290,9 @@ sensitivityIntegrator(ClientData clientData, Tcl_Interp *interp, int argc, TCL_C
 int 
 getNumElements(ClientData clientData, Tcl_Interp *interp, int argc, TCL_Char **argv);
 
+int 
+getNumAllocations(ClientData clientData, Tcl_Interp *interp, int argc, TCL_Char **argv);
+
 int 
 getEleClassTags(ClientData clientData, Tcl_Interp *interp, int argc, TCL_Char **argv);
 